@@ -119,6 +119,8 @@ macx {
 
 linux {
     CONFIG += staticlib
+    # records LIBS for the applications linking the static library
+    CONFIG += create_prl
 
     LIBS += -lfreeimage
     LIBS += -lopencv_core
@@ -135,6 +137,9 @@ linux {
     DESTDIR = ../_bin/$$CONFIGURATION/$$PLATFORM/
 }
 
+# shm_open and sem_* of IPLSharedMemoryRing, part of libc since glibc 2.34
+unix:!macx: LIBS += -lrt
+
 msvc {
     QMAKE_CXXFLAGS += -openmp
     QMAKE_LFLAGS   += -openmp
@@ -0,0 +1,71 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLARITHMETIC_H
+#define IPLARITHMETIC_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+
+/**
+ * @brief The IPLArithmetic class is the elementwise engine of the arithmetic processes
+ *
+ * Every operation has its own row kernel for two rows and for a row and a
+ * scalar. The results are clamped to a maximum of 1.0:
+ *  - ADD, SUB: clamped to 0..1
+ *  - DIV: 0 where the divisor is <= 0
+ *  - AND, OR, XOR, NOT: 1.0 is true, everything else false
+ *  - ATAN2: atan2(a, b) with a polynomial approximation (error < 2e-6 rad)
+ *
+ * The image functions broadcast planes (a gray image is used for every
+ * plane of a color image), treat pixels outside of the smaller image as 0
+ * and run the row kernels in parallel.
+ */
+class IPLSHARED_EXPORT IPLArithmetic
+{
+public:
+    enum Operation
+    {
+        ADD = 0,
+        SUB,
+        MUL,
+        DIV,
+        MIN,
+        MAX,
+        AND,
+        OR,
+        XOR,
+        NOT,
+        ATAN2,
+        NUM_OPERATIONS
+    };
+
+    typedef void        (*RowKernel)        (const float* a, const float* b, float* out, int width);
+    typedef void        (*ScalarKernel)     (const float* a, float b, float* out, int width);
+
+    static RowKernel    rowKernel           (int operation);
+    static ScalarKernel scalarKernel        (int operation);
+
+    static IPLImage*    apply               (int operation, IPLImage* a, IPLImage* b, IPLImage* result);
+    static IPLImage*    apply               (int operation, IPLImage* a, float b, IPLImage* result);
+
+    static float        atan2               (float y, float x);
+};
+
+#endif // IPLARITHMETIC_H
@@ -0,0 +1,73 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLCOLORCONVERSION_H
+#define IPLCOLORCONVERSION_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+
+/**
+ * @brief The IPLColorConversion class is the float color space conversion engine
+ *
+ * RGB planes are sRGB encoded. All other color spaces are scaled to 0..1 so
+ * they can be shown as images:
+ *  - Linear RGB: sRGB transfer function removed
+ *  - HSV, HSL: hue 0..1 (0..360 degrees), same as IPLColor
+ *  - Lab: L/100, (a + 128)/255, (b + 128)/255 (CIE L*a*b*, D65, 8-bit OpenCV / 255)
+ *  - YCbCr: full range BT.601 (JPEG), Cb and Cr centered at 0.5
+ *  - XYZ: CIE XYZ (D65) from linear RGB, unscaled
+ *
+ * The row kernels convert whole rows of separate planes and are written
+ * without branches where possible so the compiler can vectorize them. The
+ * image functions run the row kernels in parallel and may work in place.
+ */
+class IPLSHARED_EXPORT IPLColorConversion
+{
+public:
+    enum ColorSpace
+    {
+        RGB = 0,
+        LINEAR_RGB,
+        HSV,
+        HSL,
+        LAB,
+        YCBCR,
+        XYZ,
+        NUM_COLORSPACES
+    };
+
+    static const char*  name                (int space);
+
+    static void         fromRGB             (int space, const float* r, const float* g, const float* b,
+                                             float* c0, float* c1, float* c2, int width);
+    static void         toRGB               (int space, const float* c0, const float* c1, const float* c2,
+                                             float* r, float* g, float* b, int width);
+
+    static void         convert             (IPLImagePlane* input[3], IPLImagePlane* output[3], int from, int to);
+    static void         convert             (IPLImage* image, IPLImage* result, int from, int to);
+    static void         gray                (IPLImage* image, IPLImage* result, float weightR, float weightG, float weightB);
+
+    static float        srgbToLinear        (float value);
+    static float        linearToSrgb        (float value);
+    static void         srgbToLinear        (const float* input, float* output, int width);
+    static void         linearToSrgb        (const float* input, float* output, int width);
+};
+
+#endif // IPLCOLORCONVERSION_H
@@ -0,0 +1,92 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLCOMPONENTTREE_H
+#define IPLCOMPONENTTREE_H
+
+#include "IPL_global.h"
+#include "IPLData.h"
+#include "IPLImage.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLComponentTree class holds the max-tree or min-tree of a gray image
+ *
+ * Every node is a connected component of a threshold set of the image
+ * quantized to 8 or 16 bits (4-connected). The nodes are sorted by level
+ * so the root is node 0 and every parent comes before its children; every
+ * pixel refers to the node of its level. The min-tree is built as the
+ * max-tree of the inverted image.
+ *
+ * The tree is built with union-find in order of decreasing level. In the
+ * parallel variant horizontal strips are built independently and the trees
+ * of neighbouring strips are merged along their common border in pairs.
+ *
+ * Attribute filters remove all nodes whose attribute is below a threshold
+ * and give their pixels the level of the nearest remaining ancestor.
+ */
+class IPLSHARED_EXPORT IPLComponentTree : public IPLData
+{
+public:
+    enum Attribute
+    {
+        AREA = 0,
+        BOUNDING_BOX,
+        CONTRAST,
+        NUM_ATTRIBUTES
+    };
+
+                    IPLComponentTree    ();
+                    IPLComponentTree    (const IPLComponentTree& other);
+
+    void            build               (IPLImage* image, bool maxTree, int bits, bool parallel);
+
+    int             width               ()                      { return _width; }
+    int             height              ()                      { return _height; }
+    bool            isMaxTree           ()                      { return _maxTree; }
+    int             maxLevel            ()                      { return _maxLevel; }
+    int             nodes               ()                      { return (int) _nodeParent.size(); }
+
+    //! node of every pixel of row y
+    const int*      pixelNodes          (int y)                 { return &_pixelNode[(size_t) y * _width]; }
+    //! parent node, -1 for the root
+    int             parent              (int node)              { return _nodeParent[node]; }
+    int             level               (int node)              { return _nodeLevel[node]; }
+
+    void            attribute           (int attribute, std::vector<double>& values);
+    void            filter              (const std::vector<double>& values, double threshold, IPLImage* result);
+    void            reconstruct         (const std::vector<int>& nodeLevels, IPLImage* result);
+
+protected:
+    void            buildStrip          (int y0, int y1, std::vector<int>& parent, std::vector<int>& zpar);
+    void            mergeStrips         (int y, std::vector<int>& parent);
+    void            canonicalize        (std::vector<int>& parent, std::vector<int>& canonical);
+
+    int                             _width;
+    int                             _height;
+    bool                            _maxTree;
+    int                             _maxLevel;
+    std::vector<unsigned short>     _level;         //!< quantized pixels, only while building
+    std::vector<int>                _pixelNode;
+    std::vector<int>                _nodeParent;
+    std::vector<unsigned short>     _nodeLevel;
+};
+
+#endif // IPLCOMPONENTTREE_H
@@ -29,6 +29,9 @@ class IPLComplexImage;
 class IPLPoint;
 class IPLMatrix;
 class IPLKeyPoints;
+class IPLPyramid;
+class IPLIntegralImage;
+class IPLComponentTree;
 
 class IPLSHARED_EXPORT IPLData
 {
@@ -44,6 +47,9 @@ public:
     IPLPoint*           toPoint();
     IPLMatrix*          toMatrix();
     IPLKeyPoints*       toKeyPoints();
+    IPLPyramid*         toPyramid();
+    IPLIntegralImage*   toIntegralImage();
+    IPLComponentTree*   toComponentTree();
 
 protected:
     IPLDataType         _type;
@@ -40,8 +40,9 @@ public:
     static bool loadMemory(void* hmem, IPLImage*& image);
     static bool saveFile(const std::string path, IPLImage* image, int format, int flags, IPLImage* result = 0, bool preview = false);
 
-    static bool loadRawFile(const std::string filename, IPLImage*& image, int width, int height, IPLRawImageType format, bool interleaved, std::string& information);
+    static bool loadRawFile(const std::string filename, IPLImage*& image, int width, int height, IPLRawImageType format, bool interleaved, std::string& information, int bits = 16);
     static bool readRaw8bit(int stride, IPLImage *&image, std::ifstream &file);
+    static bool readRaw16bit(int stride, int bits, IPLImage *&image, std::ifstream &file);
     static bool readRaw24BitInterleaved(int stride, IPLRawImageType format, IPLImage *&image, std::ifstream &file);
     static bool readRaw32BitInterleaved(int stride, IPLRawImageType format, IPLImage *&image, std::ifstream &file);
     static bool readRaw24BitPlanar(int stride, IPLRawImageType format, IPLImage *&image, std::ifstream &file);
@@ -0,0 +1,105 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLFOLDERWATCHER_H
+#define IPLFOLDERWATCHER_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+
+#include <string>
+#include <deque>
+#include <set>
+#include <stddef.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/**
+ * @brief The IPLFolderWatcher class watches a folder for new files and decodes
+ * them on a background thread.
+ *
+ * Files are reported by inotify once the writer closes them or when they are
+ * renamed into the folder, so partially written files are never read and the
+ * folder is never listed. Decoded images wait in a bounded queue, when it is
+ * full the decoder blocks and further events stay in the kernel queue.
+ * With ACTION_KEEP, the names of the last MAX_SEEN_FILES files are kept to
+ * report every file once; an older file which is written again is reported
+ * again. Only available on Linux.
+ */
+class IPLSHARED_EXPORT IPLFolderWatcher
+{
+public:
+    enum Action
+    {
+        ACTION_KEEP = 0,
+        ACTION_DELETE,
+        ACTION_MOVE
+    };
+
+                            IPLFolderWatcher        ();
+                            ~IPLFolderWatcher       ();
+
+    bool                    start                   (const std::string& folder, int queueSize, Action action,
+                                                     const std::string& moveFolder, std::string& error);
+    void                    stop                    ();
+    bool                    isRunning               ()              { return _thread.joinable(); }
+    bool                    waitForImage            (int timeoutMs);
+    IPLImage*               takeImage               (std::string& fileName, int timeoutMs);
+    int                     queued                  ();
+    int                     received                ()              { return _received; }
+    int                     failed                  ()              { return _failed; }
+    std::string             takeError               ();
+
+    static const size_t     MAX_SEEN_FILES          = 100000;
+
+private:
+    void                    run                     ();
+    void                    handleFile              (const std::string& name);
+    void                    setError                (const std::string& error);
+    void                    setFailed               (const std::string& error);
+    bool                    firstSeen               (const std::string& name);
+
+    struct Entry
+    {
+        IPLImage*           image;
+        std::string         fileName;
+    };
+
+    std::string             _folder;
+    std::string             _moveFolder;
+    Action                  _action;
+    size_t                  _queueSize;
+    int                     _inotify;
+    int                     _wakeup[2];
+    std::thread             _thread;
+    std::atomic<bool>       _stop;
+    std::atomic<int>        _received;
+    std::atomic<int>        _failed;
+    std::mutex              _mutex;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+    std::deque<Entry>       _queue;
+    std::set<std::string>   _seen;
+    std::deque<std::string> _seenOrder;             //!< _seen in insertion order
+    std::string             _lastError;
+};
+
+#endif // IPLFOLDERWATCHER_H
@@ -43,6 +43,7 @@ public:
     IPLImage();
     IPLImage( const IPLImage& image );
     IPLImage( IPLDataType _type, int width, int height );
+    IPLImage( IPLDataType _type, const std::vector<IPLImagePlane*>& planes );
     IPLImage( cv::Mat& cvMat );
     ~IPLImage();
 
@@ -22,14 +22,25 @@
 
 #include "IPL_global.h"
 
+#include <memory>
+
 /**
  * @brief The IPLImagePlane class
+ *
+ * The pixel buffer is reference counted. share() creates a second plane
+ * which references the same pixels without copying them, the buffer is
+ * freed with the last plane. Shared planes are read-only views: processes
+ * must never write to the planes of their inputs, copy them instead.
+ * The copy constructor and assignment always copy the pixels.
+ * A plane can also wrap pixels owned elsewhere, e.g. in shared memory,
+ * the owner is released together with the last plane.
  */
 class IPLSHARED_EXPORT IPLImagePlane
 {
 public:
     IPLImagePlane();
     IPLImagePlane( int width, int height );
+    IPLImagePlane( int width, int height, std::shared_ptr<ipl_basetype> pixels );
     IPLImagePlane( const IPLImagePlane &other );
     IPLImagePlane( IPLImagePlane &&other );
     IPLImagePlane &operator=(const IPLImagePlane &other);
@@ -38,6 +49,9 @@ public:
 
     void swap(IPLImagePlane &other);
 
+    IPLImagePlane* share( void );
+    bool sharesPixelsWith( const IPLImagePlane* other ) const;
+
     //IPLImagePlane& IPLImagePlane::operator=( IPLImagePlane& i );
     //!
     //! \brief pixel access without checks
@@ -104,6 +118,7 @@ private:
     int                     _height;
     int                     _width;
     ipl_basetype*           _plane;
+    std::shared_ptr<ipl_basetype> _buffer;
     static ipl_basetype     _zero;
     static int              _instanceCount;
 };
@@ -0,0 +1,81 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLINTEGRALIMAGE_H
+#define IPLINTEGRALIMAGE_H
+
+#include "IPL_global.h"
+#include "IPLData.h"
+#include "IPLImage.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLIntegralImage class holds the summed-area tables of an image
+ *
+ * Every plane has a table of (width+1) x (height+1) doubles where entry
+ * (x, y) is the sum of all pixels left of x and above y, the first row and
+ * column are 0. Optionally a second table holds the sums of the squared
+ * pixels. The sum over any rectangle is then read from 4 entries,
+ * independent of its size.
+ */
+class IPLSHARED_EXPORT IPLIntegralImage : public IPLData
+{
+public:
+                    IPLIntegralImage    ();
+                    IPLIntegralImage    (const IPLIntegralImage& other);
+
+    void            compute             (IPLImage* image, bool squaredSum);
+
+    int             width               ()                      { return _width; }
+    int             height              ()                      { return _height; }
+    int             planes              ()                      { return (int) _sum.size(); }
+    bool            hasSquaredSum       ()                      { return !_squaredSum.empty(); }
+    IPLDataType     sourceType          ()                      { return _sourceType; }
+
+    //! table row y of plane, width+1 entries
+    const double*   sumRow              (int plane, int y)      { return &_sum[plane][(size_t) y * (_width+1)]; }
+    const double*   squaredSumRow       (int plane, int y)      { return &_squaredSum[plane][(size_t) y * (_width+1)]; }
+
+    //! sum of the pixels in [x0, x1) x [y0, y1), the rectangle must lie inside the image
+    double          sum                 (int plane, int x0, int y0, int x1, int y1)
+    {
+        return rectangle(_sum[plane], x0, y0, x1, y1);
+    }
+    double          squaredSum          (int plane, int x0, int y0, int x1, int y1)
+    {
+        return rectangle(_squaredSum[plane], x0, y0, x1, y1);
+    }
+
+protected:
+    double          rectangle           (const std::vector<double>& table, int x0, int y0, int x1, int y1)
+    {
+        size_t stride = _width + 1;
+        return table[y1*stride + x1] - table[y0*stride + x1] - table[y1*stride + x0] + table[y0*stride + x0];
+    }
+    void            scan                (IPLImagePlane* plane, std::vector<double>& table, bool squared);
+
+    int                                 _width;
+    int                                 _height;
+    IPLDataType                         _sourceType;
+    std::vector<std::vector<double> >   _sum;
+    std::vector<std::vector<double> >   _squaredSum;
+};
+
+#endif // IPLINTEGRALIMAGE_H
@@ -0,0 +1,100 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLOPENCVTUNER_H
+#define IPLOPENCVTUNER_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLImage.h"
+
+#include <string>
+#include <map>
+#include <mutex>
+
+/**
+ * @brief The IPLOpenCVTuner class selects between the native and the OpenCV
+ * implementation of OPENCV_OPTIONAL processes.
+ *
+ * The first runs of a process execute both implementations, time them and
+ * compare the first outputs. Measurements are kept per process, image size
+ * bucket, number of planes and property values. As soon as both paths have
+ * enough samples, the faster one is used. If the outputs differ more than
+ * the tolerance, could not be compared, or the OpenCV implementation fails,
+ * the native implementation is used as reference.
+ * The measurements can be saved and loaded as tab separated text file.
+ */
+class IPLSHARED_EXPORT IPLOpenCVTuner
+{
+public:
+    struct Measurement
+    {
+        double              nativeUs;
+        double              opencvUs;
+        double              meanError;
+        double              maxError;
+        bool                compared;
+    };
+
+    struct Entry
+    {
+        double              nativeUs;               //!< fastest native run
+        double              opencvUs;               //!< fastest OpenCV run
+        int                 nativeSamples;
+        int                 opencvSamples;
+        double              meanError;              //!< largest mean error of all samples
+        double              maxError;               //!< largest pixel error of all samples
+        bool                compared;               //!< the outputs of all samples were compared
+    };
+
+                            IPLOpenCVTuner          ();
+
+    bool                    process                 (IPLProcess* process, IPLData* data, int inputIndex);
+    bool                    useOpenCV               (IPLProcess* process, IPLData* data);
+    bool                    measure                 (IPLProcess* process, IPLData* data, int inputIndex, Measurement& measurement);
+    void                    record                  (const std::string& key, const Measurement& measurement);
+    void                    recordFailure           (const std::string& key);
+    bool                    decided                 (const Entry& entry);
+    bool                    prefersOpenCV           (const Entry& entry);
+    void                    clear                   ();
+
+    bool                    load                    (const std::string& path);
+    bool                    save                    (const std::string& path);
+
+    void                    setSamples              (int samples)               { _samples = samples; }
+    void                    setTolerance            (double tolerance)          { _tolerance = tolerance; }
+    void                    setDefaultUseOpenCV     (bool enabled)              { _defaultUseOpenCV = enabled; }
+    int                     samples                 ()                          { return _samples; }
+    double                  tolerance               ()                          { return _tolerance; }
+    bool                    defaultUseOpenCV        ()                          { return _defaultUseOpenCV; }
+
+    static std::string      key                     (IPLProcess* process, IPLData* data);
+    static bool             compare                 (IPLImage* a, IPLImage* b, double& meanError, double& maxError);
+
+private:
+    bool                    tunable                 (IPLProcess* process);
+
+    std::map<std::string, Entry>    _entries;
+    std::mutex                      _mutex;
+    int                             _samples;           //!< runs per path before deciding
+    double                          _tolerance;         //!< allowed mean absolute error, 0.0-1.0
+    bool                            _defaultUseOpenCV;  //!< used for sources, sequences and unknown sizes
+};
+
+#endif // IPLOPENCVTUNER_H
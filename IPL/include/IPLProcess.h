@@ -135,6 +135,8 @@ public:
     virtual void            destroy                     () = 0;
     virtual void            beforeProcessing            () {}
     virtual bool            processInputData            (IPLData*, int, bool) = 0;
+    virtual bool            processInputDataBatch       (const std::vector<IPLData*>& inputs, int inputIndex, bool useOpenCV,
+                                                         std::vector<IPLData*>& results, int outputIndex = 0);
     virtual void            processPropertyEvents       (IPLEvent*) {}
     virtual IPLData*        getResultData               (int outputIndex ) = 0;
     virtual void            afterProcessing             () {}
@@ -0,0 +1,53 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLPYRAMID_H
+#define IPLPYRAMID_H
+
+#include "IPL_global.h"
+#include "IPLData.h"
+#include "IPLImage.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLPyramid class holds all levels of a Gaussian or Laplacian pyramid
+ * Level 0 has the size of the original image, every further level has half
+ * the width and height (rounded up). The levels of a Laplacian pyramid are
+ * band-pass images with values around 0, except the last level which is the
+ * low-pass residual.
+ */
+class IPLSHARED_EXPORT IPLPyramid : public IPLData
+{
+public:
+                    IPLPyramid          (bool laplacian = false);
+                    IPLPyramid          (const IPLPyramid& other);
+                    ~IPLPyramid         ();
+
+    int             levels              ()                      { return (int) _levels.size(); }
+    IPLImage*       level               (int i)                 { return _levels[i]; }
+    void            addLevel            (IPLImage* image);
+    bool            isLaplacian         ()                      { return _laplacian; }
+
+protected:
+    std::vector<IPLImage*>  _levels;        //!< owned by the pyramid
+    bool                    _laplacian;
+};
+
+#endif // IPLPYRAMID_H
@@ -0,0 +1,60 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLRAWFRAMECODEC_H
+#define IPLRAWFRAMECODEC_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+
+#include <stddef.h>
+
+/**
+ * @brief The IPLRawFrameCodec class converts between uncompressed frame
+ * buffers and IPLImage.
+ *
+ * Formats:
+ * - gray8:       1 byte per pixel
+ * - rgb24:       3 bytes per pixel, interleaved RGB
+ * - gray16:      2 bytes per pixel, native byte order
+ * - gray float:  32 bit float, values 0.0-1.0
+ * - RGB float:   three planes of 32 bit float in R, G, B order, the same
+ *                layout as the planes of an IPLImage
+ */
+class IPLSHARED_EXPORT IPLRawFrameCodec
+{
+public:
+    enum Format
+    {
+        FORMAT_GRAY8 = 0,
+        FORMAT_RGB24,
+        FORMAT_GRAY16,
+        FORMAT_GRAY_FLOAT,
+        FORMAT_RGB_FLOAT,
+        NR_OF_FORMATS
+    };
+
+    static size_t           frameSize               (Format format, int width, int height);
+    static int              channels                (Format format);
+    static bool             isPlanarFloat           (Format format);
+    static IPLImage*        decode                  (Format format, int width, int height, const uchar* data);
+    static void             encode                  (IPLImage* image, Format format, uchar* data);
+};
+
+#endif // IPLRAWFRAMECODEC_H
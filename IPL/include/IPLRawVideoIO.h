@@ -0,0 +1,82 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLRAWVIDEOIO_H
+#define IPLRAWVIDEOIO_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+#include "IPLRawFrameCodec.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdio>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @brief The IPLRawVideoIO class reads and writes headerless raw video on
+ * stdin and stdout, e.g. for ffmpeg -f rawvideo pipelines.
+ *
+ * Frames are read and decoded by a background thread into a bounded queue,
+ * so reading overlaps with processing. The thread is started with the first
+ * configureInput() and runs as long as stdin is open or until shutdown();
+ * stdin and stdout are process-wide, so all processes share this class like
+ * the camera.
+ */
+class IPLSHARED_EXPORT IPLRawVideoIO
+{
+public:
+    static void             configureInput          (int width, int height, IPLRawFrameCodec::Format format, int queueSize);
+    static IPLImage*        readFrame               (int timeoutMs);
+    static bool             endOfInput              ();
+    static int              queued                  ();
+    static uint64_t         framesRead              ()              { return _framesRead.load(); }
+    static void             shutdown                ();
+
+    static bool             writeFrame              (IPLImage* image, IPLRawFrameCodec::Format format, std::string& error);
+    static uint64_t         framesWritten           ()              { return _framesWritten.load(); }
+
+private:
+    static void             readInput               ();
+    static void             prepareStream           (FILE* stream);
+
+    static std::mutex               _mutex;
+    static std::condition_variable  _notEmpty;
+    static std::condition_variable  _notFull;
+    static std::deque<IPLImage*>    _queue;
+    static bool                     _reading;
+    static bool                     _endOfInput;
+    static bool                     _stop;
+    static int                      _width;
+    static int                      _height;
+    static IPLRawFrameCodec::Format _format;
+    static size_t                   _queueSize;
+    static uint64_t                 _generation;
+    static std::atomic<uint64_t>    _framesRead;
+
+    static std::mutex               _writeMutex;
+    static std::vector<uchar>       _writeBuffer;
+    static std::atomic<uint64_t>    _framesWritten;
+};
+
+#endif // IPLRAWVIDEOIO_H
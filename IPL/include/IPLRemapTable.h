@@ -0,0 +1,93 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLREMAPTABLE_H
+#define IPLREMAPTABLE_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+#include "IPLResampler.h"
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief The IPLRemapTable class caches a geometric mapping for fixed parameters
+ *
+ * For every output pixel the table stores the offset of the top left filter
+ * tap in the source plane and the sub-pixel position as 8+8 bit fixed point.
+ * Pixels whose taps leave the source image are kept in a short per-row list
+ * and use the border mode when the table is applied. Building the table is
+ * done once per parameter set and image size (see matches() and setKey()),
+ * applying it is a row parallel gather for all planes.
+ */
+class IPLSHARED_EXPORT IPLRemapTable
+{
+public:
+                    IPLRemapTable       ();
+
+    bool            matches             (const std::vector<double>& key)    { return !_offset.empty() && key == _key; }
+    void            setKey              (const std::vector<double>& key)    { _key = key; }
+    void            clear               ();
+
+    bool            buildPerspective    (const double matrix[9], int srcWidth, int srcHeight,
+                                         int dstWidth, int dstHeight, int interpolation, int border);
+    void            buildUndistort      (double f, double cx, double cy,
+                                         double k1, double k2, double p1, double p2, double k3,
+                                         int width, int height, int interpolation, int border);
+    void            apply               (IPLImage* image, IPLImage* result);
+
+    int             srcWidth            ()  { return _srcWidth; }
+    int             srcHeight           ()  { return _srcHeight; }
+    int             dstWidth            ()  { return _dstWidth; }
+    int             dstHeight           ()  { return _dstHeight; }
+
+    static const int FRACTION_BITS = 8;
+    static const int FRACTION_SIZE = 1 << FRACTION_BITS;
+
+protected:
+    struct BorderPixel
+    {
+        int             x;                  //!< output column
+        int             x0;                 //!< first source tap, may lie outside
+        int             y0;
+        uint16_t        fraction;
+    };
+
+    void            allocate            (int srcWidth, int srcHeight, int dstWidth, int dstHeight,
+                                         int interpolation, int border);
+    void            encodeRow           (int y, const double* X, const double* Y);
+
+    enum { OFFSET_BORDER = -1, OFFSET_OUTSIDE = -2 };
+
+    std::vector<double>                     _key;
+    std::vector<int32_t>                    _offset;        //!< top left tap or OFFSET_*
+    std::vector<uint16_t>                   _fraction;      //!< (fy << 8) | fx
+    std::vector<std::vector<BorderPixel> >  _borderPixels;  //!< per output row
+    std::vector<float>                      _weights;       //!< FRACTION_SIZE x taps
+    int                                     _srcWidth;
+    int                                     _srcHeight;
+    int                                     _dstWidth;
+    int                                     _dstHeight;
+    int                                     _interpolation;
+    int                                     _border;
+    int                                     _taps;
+};
+
+#endif // IPLREMAPTABLE_H
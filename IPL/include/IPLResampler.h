@@ -0,0 +1,89 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLRESAMPLER_H
+#define IPLRESAMPLER_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+#include "IPLPoint.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLResampler class is the native float resampling engine shared by
+ * the geometric processes (IPLResize, IPLRotate, IPLWarpAffine, IPLWarpPerspective).
+ *
+ * All functions work directly on the float planes, so no 8-bit round trip
+ * through cv::Mat is needed. The interpolation and border constants use the
+ * same order as the process properties and OpenCV (INTER_*, BORDER_*).
+ *
+ * Axis aligned resizing is separable: the filter taps are precomputed once per
+ * output column and row, the horizontal pass runs on every source row and the
+ * vertical pass is a weighted sum of contiguous rows. Warps use an inverse
+ * mapping; the weights are computed once per output pixel and applied to all
+ * planes. All passes are parallel over rows.
+ */
+class IPLSHARED_EXPORT IPLResampler
+{
+public:
+    enum Interpolation
+    {
+        INTER_NEAREST   = 0,
+        INTER_LINEAR    = 1,
+        INTER_AREA      = 2,
+        INTER_CUBIC     = 3,
+        INTER_LANCZOS4  = 4
+    };
+
+    enum Border
+    {
+        BORDER_CONSTANT     = 0,    //!< black
+        BORDER_REPLICATE    = 1,    //!< aaa|abc|ccc
+        BORDER_REFLECT      = 2,    //!< cba|abc|cba
+        BORDER_WRAP         = 3     //!< abc|abc|abc
+    };
+
+    static void     resize              (IPLImage* image, IPLImage* result, int interpolation);
+    static bool     warpAffine          (IPLImage* image, IPLImage* result, const double matrix[6],
+                                         int interpolation, int border = BORDER_CONSTANT);
+    static bool     warpPerspective     (IPLImage* image, IPLImage* result, const double matrix[9],
+                                         int interpolation, int border = BORDER_CONSTANT);
+
+    static void     rotationMatrix      (double cx, double cy, double angle, double scale, double matrix[6]);
+    static bool     affineTransform     (const IPLPoint from[3], const IPLPoint to[3], double matrix[6]);
+    static bool     perspectiveTransform(const IPLPoint from[4], const IPLPoint to[4], double matrix[9]);
+    static bool     invertAffine        (const double matrix[6], double inverse[6]);
+    static bool     invertPerspective   (const double matrix[9], double inverse[9]);
+
+    static int      taps                (int interpolation);
+    static void     weights             (int interpolation, float t, float* w);
+    static int      borderIndex         (int i, int size, int border);
+
+    static void     drawPoint           (IPLImage* image, const IPLPoint& point, float r, float g, float b);
+
+protected:
+    static void     warp                (IPLImage* image, IPLImage* result, const double inverse[9],
+                                         bool perspective, int interpolation, int border);
+    static void     resizeTaps          (int srcSize, int dstSize, int interpolation,
+                                         std::vector<int>& index, std::vector<float>& weight, int& n);
+    static bool     solve               (double* a, double* b, int n);
+};
+
+#endif // IPLRESAMPLER_H
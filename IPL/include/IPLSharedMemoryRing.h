@@ -0,0 +1,124 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLSHAREDMEMORYRING_H
+#define IPLSHAREDMEMORYRING_H
+
+#include "IPL_global.h"
+#include "IPLImage.h"
+#include "IPLRawFrameCodec.h"
+
+#include <string>
+#include <memory>
+#include <atomic>
+#include <stdint.h>
+
+#if defined(__linux__)
+    #include <semaphore.h>
+#endif
+
+#define IPL_SHM_RING_MAGIC      0x524c5049  // "IPLR"
+#define IPL_SHM_RING_VERSION    1
+#define IPL_SHM_RING_ALIGNMENT  64
+
+#if defined(__linux__)
+/**
+ * @brief Layout of the start of a shared-memory ring, followed by
+ * slotCount slots of slotSize bytes at dataOffset.
+ *
+ * Every slot starts with an IPLSharedMemorySlot, the frame follows at
+ * IPL_SHM_RING_ALIGNMENT bytes in the IPLRawFrameCodec layout. Frame n
+ * lives in slot n % slotCount. There is one producer and one consumer:
+ * the producer waits on empty, writes the slot, increments writeSequence
+ * and posts filled. The consumer waits on filled, reads the slot,
+ * increments readSequence and posts empty. The creator clears magic
+ * when it closes the ring.
+ */
+struct IPLSharedMemoryRingHeader
+{
+    std::atomic<uint32_t>   magic;
+    uint32_t                version;
+    uint32_t                width;
+    uint32_t                height;
+    uint32_t                format;         //!< IPLRawFrameCodec::Format
+    uint32_t                slotCount;
+    uint64_t                slotSize;
+    uint64_t                dataOffset;
+    uint64_t                frameSize;
+    std::atomic<uint64_t>   writeSequence;  //!< frames published
+    std::atomic<uint64_t>   readSequence;   //!< frames released by the consumer
+    sem_t                   filled;
+    sem_t                   empty;
+};
+
+struct IPLSharedMemorySlot
+{
+    uint64_t                sequence;
+    uint64_t                timestampUs;
+};
+#endif
+
+/**
+ * @brief The IPLSharedMemoryRing class connects to a POSIX shared-memory
+ * ring of frames, see IPLSharedMemoryRingHeader for the layout.
+ *
+ * Frames in planar float format are read without copying: the planes of
+ * the returned image point into the slot, which is released to the
+ * producer when the last plane referencing it is deleted. Like all shared
+ * planes, they must not be written to. Other formats
+ * are converted and the slot is released immediately. Slots are always
+ * released in order. Only available on Linux.
+ */
+class IPLSHARED_EXPORT IPLSharedMemoryRing
+{
+public:
+                            IPLSharedMemoryRing     ();
+                            ~IPLSharedMemoryRing    ();
+
+    bool                    create                  (const std::string& name, int width, int height,
+                                                     IPLRawFrameCodec::Format format, int slotCount, std::string& error);
+    bool                    attach                  (const std::string& name, std::string& error);
+    void                    close                   ();
+    bool                    isOpen                  ();
+    bool                    isValid                 ();
+
+    const std::string&      name                    ()              { return _name; }
+    int                     width                   ();
+    int                     height                  ();
+    IPLRawFrameCodec::Format format                 ();
+    int                     slotCount               ();
+    int                     queued                  ();
+
+    // consumer
+    bool                    waitForFrame            (int timeoutMs);
+    IPLImage*               read                    (int timeoutMs, bool latestOnly, uint64_t& sequence, std::string& error);
+
+    // producer
+    bool                    write                   (IPLImage* image, int timeoutMs, uint64_t& sequence);
+
+private:
+    struct Mapping;
+
+    std::shared_ptr<Mapping> _mapping;
+    std::string             _name;
+    bool                    _owner;
+    uint64_t                _nextRead;
+};
+
+#endif // IPLSHAREDMEMORYRING_H
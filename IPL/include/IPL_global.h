@@ -24,7 +24,7 @@
 // interfaces are made in order to check if plugins
 // are still compatible
 #ifndef IPL_VERSION
-#define IPL_VERSION 2
+#define IPL_VERSION 3
 #endif
 
 #define NOMINMAX
@@ -89,6 +89,9 @@ enum IPLDataType
     IPL_KEYPOINTS,
     IPL_CV_MAT,
     IPL_VECTOR,
+    IPL_PYRAMID,
+    IPL_INTEGRAL_IMAGE,
+    IPL_COMPONENT_TREE,
 
     IPL_NUM_DATATYPES
 };
@@ -159,7 +162,8 @@ enum IPLRawImageType
     IPL_RAW_24BIT_RGB,
     IPL_RAW_24BIT_BGR,
     IPL_RAW_32BIT_RGB,
-    IPL_RAW_32BIT_BGR
+    IPL_RAW_32BIT_BGR,
+    IPL_RAW_16BIT
 };
 
 enum IPLEventType
@@ -42,6 +42,7 @@
 #include "IPLArithmeticOperationsConstant.h"
 #include "IPLConvertToGray.h"
 #include "IPLConvertToColor.h"
+#include "IPLConvertColorSpace.h"
 #include "IPLBlendImages.h"
 #include "IPLFlipImage.h"
 #include "IPLGradientOperator.h"
@@ -49,6 +50,9 @@
 #include "IPLCanvasSize.h"
 #include "IPLResize.h"
 #include "IPLRotate.h"
+#include "IPLGaussianPyramid.h"
+#include "IPLLaplacianPyramid.h"
+#include "IPLCollapsePyramid.h"
 #include "IPLEnhanceMode.h"
 #include "IPLFillConcavities.h"
 #include "IPLGabor.h"
@@ -56,6 +60,7 @@
 #include "IPLMax.h"
 #include "IPLMaxMinMedian.h"
 #include "IPLMedian.h"
+#include "IPLNonLocalMeans.h"
 #include "IPLCanny.h"
 #include "IPLHoughCircles.h"
 #include "IPLHarrisCorner.h"
@@ -94,6 +99,23 @@
 
 #include "IPLFloodFill.h"
 #include "IPLAccumulate.h"
+#include "IPLBackgroundSubtraction.h"
+#include "IPLFrameBuffer.h"
+#include "IPLIntegral.h"
+#include "IPLBoxFilter.h"
+#include "IPLDistanceTransform.h"
+#include "IPLWatershed.h"
+#include "IPLSuperpixels.h"
+#include "IPLMaxTree.h"
+#include "IPLAttributeFilter.h"
+#include "IPLLocalBinaryPattern.h"
+#include "IPLHOG.h"
+#include "IPLDemosaic.h"
+#include "IPLWatchFolder.h"
+#include "IPLSharedMemoryInput.h"
+#include "IPLSharedMemoryOutput.h"
+#include "IPLRawVideoInput.h"
+#include "IPLRawVideoOutput.h"
 #include "IPLHoughLines.h"
 #include "IPLHoughLineSegments.h"
 #include "IPLMatchTemplate.h"
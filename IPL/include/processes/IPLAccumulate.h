@@ -26,14 +26,15 @@
 #include "IPLOrientedImage.h"
 
 #include <string>
-#include <deque>
-
-#include "opencv2/core/core.hpp"
-#include "opencv2/imgproc/imgproc.hpp"
-#include "opencv2/highgui/highgui.hpp"
+#include <vector>
 
 /**
- * @brief The IPLAccumulate class
+ * @brief The IPLAccumulate class keeps a float accumulator of all input frames
+ *
+ * The accumulator is updated in place, the output image is only filled
+ * when it is requested. Mean, variance and standard deviation use Welford's
+ * running update. Changing the method, the image size or pressing reset
+ * starts a new accumulation.
  */
 class IPLSHARED_EXPORT IPLAccumulate : public IPLClonableProcess<IPLAccumulate>
 {
@@ -46,8 +47,34 @@ public:
     bool                    processInputData        (IPLData*, int, bool useOpenCV);
     IPLData*                getResultData           (int);
 
+    enum Method
+    {
+        METHOD_DEFAULT = 0,
+        METHOD_SQUARE,
+        METHOD_PRODUCT,
+        METHOD_WEIGHTED,
+        METHOD_SUM,
+        METHOD_MEAN,
+        METHOD_VARIANCE,
+        METHOD_STDDEV,
+        METHOD_MINIMUM,
+        METHOD_MAXIMUM
+    };
+
 protected:
+    void                    reset                   (IPLImage* image, int method);
+
     IPLImage*               _result;
+    std::vector<float>      _accumulator;           //!< per plane: sum, average, mean, minimum or maximum
+    std::vector<float>      _m2;                    //!< per plane: sum of squared deviations from the mean
+    int                     _count;
+    int                     _method;
+    int                     _resetCounter;
+    int                     _width;
+    int                     _height;
+    int                     _planes;
+    IPLDataType             _type;
+    bool                    _dirty;
 };
 
 #endif // IPLACCUMULATE_H
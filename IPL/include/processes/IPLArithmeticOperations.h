@@ -22,6 +22,7 @@
 
 #include "IPL_global.h"
 #include "IPLProcess.h"
+#include "IPLArithmetic.h"
 
 #include <string>
 
@@ -37,11 +38,13 @@ public:
     void                destroy();
     bool                processInputData            (IPLData* data, int inNr, bool useOpenCV);
     IPLImage*           getResultData               (int outNr);
+    void                beforeProcessing            ();
+    void                afterProcessing             ();
 
 private:
     int                 _operation;
-    IPLImage*           _inputA;
-    IPLImage*           _inputB;
+    IPLImage*           _inputA;                    //!< not owned
+    IPLImage*           _inputB;                    //!< not owned
     IPLImage*           _result;
 };
 
@@ -22,6 +22,7 @@
 
 #include "IPL_global.h"
 #include "IPLProcess.h"
+#include "IPLArithmetic.h"
 
 #include <string>
 
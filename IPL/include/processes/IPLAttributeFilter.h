@@ -0,0 +1,51 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLATTRIBUTEFILTER_H
+#define IPLATTRIBUTEFILTER_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLComponentTree.h"
+
+#include <string>
+
+/**
+ * @brief The IPLAttributeFilter class prunes a component tree by an attribute
+ * Nodes with an area, bounding box size or contrast below the threshold are
+ * removed and the image is reconstructed from the remaining nodes. On a
+ * max-tree the area filter is the area opening, on a min-tree the area
+ * closing. The time is linear in the number of pixels for any threshold.
+ */
+class IPLSHARED_EXPORT IPLAttributeFilter : public IPLClonableProcess<IPLAttributeFilter>
+{
+public:
+                            IPLAttributeFilter() : IPLClonableProcess() { init(); }
+                            ~IPLAttributeFilter()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+protected:
+    IPLImage*               _result;
+};
+
+#endif // IPLATTRIBUTEFILTER_H
@@ -0,0 +1,70 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLBACKGROUNDSUBTRACTION_H
+#define IPLBACKGROUNDSUBTRACTION_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLBackgroundSubtraction class separates moving foreground from a learned background
+ *
+ * Two per-pixel models are available:
+ *  - Running Gaussian: mean and variance per plane
+ *  - Mixture of Gaussians: K weighted components with a mean per plane and
+ *    one variance (Stauffer & Grimson)
+ *
+ * The model buffers are allocated once per image size. Every frame is
+ * classified and learned in one pass over the image, in parallel over rows.
+ * The background output is only filled when it is requested.
+ */
+class IPLSHARED_EXPORT IPLBackgroundSubtraction : public IPLClonableProcess<IPLBackgroundSubtraction>
+{
+public:
+                            IPLBackgroundSubtraction() : IPLClonableProcess() { init(); }
+                            ~IPLBackgroundSubtraction()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+protected:
+    void                    reset                   (IPLImage* image, int model, int components);
+    void                    updateGaussian          (IPLImage* image, float alpha, float threshold);
+    void                    updateMixture           (IPLImage* image, float alpha, float threshold, float backgroundRatio);
+
+    IPLImage*               _foreground;
+    IPLImage*               _background;
+    std::vector<float>      _model;                 //!< Gaussian: mean and variance planes, MoG: per pixel K x (weight, variance, means)
+    int                     _modelType;
+    int                     _components;
+    int                     _resetCounter;
+    int                     _width;
+    int                     _height;
+    int                     _planes;
+    IPLDataType             _type;
+    bool                    _initialized;
+    bool                    _dirty;
+};
+
+#endif // IPLBACKGROUNDSUBTRACTION_H
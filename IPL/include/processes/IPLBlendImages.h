@@ -28,6 +28,10 @@
 
 /**
  * @brief The IPLBlendImages class
+ *
+ * The inputs are not copied: both are only referenced during one processing
+ * run, beforeProcessing and afterProcessing drop them.
+ * Every blend mode has its own row kernel, selected once per run.
  */
 class IPLSHARED_EXPORT IPLBlendImages : public IPLClonableProcess<IPLBlendImages>
 {
@@ -40,11 +44,17 @@ public:
 
     virtual bool            processInputData    (IPLData* data, int inNr, bool useOpenCV);
     virtual IPLImage*       getResultData       (int outNr);
+    virtual void            beforeProcessing    ();
+    virtual void            afterProcessing     ();
+
+    //! blends n pixels of a and b, weighted with factorA and factorB, into out and clamps to 0..1
+    typedef void            (*RowKernel)        (const float* a, const float* b, float* out, int n, float factorA, float factorB);
+    static RowKernel        kernel              (int operation);
 
 protected:
     IPLImage*               _result;
-    IPLImage*               _inputA;
-    IPLImage*               _inputB;
+    IPLImage*               _inputA;            //!< not owned
+    IPLImage*               _inputB;            //!< not owned
     int                     _operation;
     double                  _factorA;
     double                  _factorB;
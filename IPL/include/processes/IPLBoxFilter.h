@@ -0,0 +1,60 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLBOXFILTER_H
+#define IPLBOXFILTER_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLIntegralImage.h"
+
+#include <string>
+
+/**
+ * @brief The IPLBoxFilter class computes local sums, means and variances from an integral image
+ * Every pixel reads 4 entries of the integral image, so the cost does not
+ * depend on the window size. Windows are clipped at the image border and
+ * normalized by the number of pixels inside.
+ */
+class IPLSHARED_EXPORT IPLBoxFilter : public IPLClonableProcess<IPLBoxFilter>
+{
+public:
+                            IPLBoxFilter() : IPLClonableProcess() { init(); }
+                            ~IPLBoxFilter()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    enum Mode
+    {
+        MODE_MEAN = 0,
+        MODE_SUM,
+        MODE_VARIANCE,
+        MODE_DEVIATION
+    };
+
+    static void             filter                  (IPLIntegralImage* integral, IPLImage* result, int mode, int windowX, int windowY);
+
+protected:
+    IPLImage*               _result;
+};
+
+#endif // IPLBOXFILTER_H
@@ -0,0 +1,60 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLCOLLAPSEPYRAMID_H
+#define IPLCOLLAPSEPYRAMID_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLPyramid.h"
+
+#include <string>
+
+/**
+ * @brief The IPLCollapsePyramid class reconstructs an image from a Laplacian pyramid
+ * If a second pyramid and a mask are connected, both pyramids are blended
+ * level by level with a Gaussian pyramid of the mask before collapsing
+ * (multiband blending).
+ * The inputs are only referenced during one processing run, the result is
+ * computed once all connected inputs have arrived.
+ */
+class IPLSHARED_EXPORT IPLCollapsePyramid : public IPLClonableProcess<IPLCollapsePyramid>
+{
+public:
+                            IPLCollapsePyramid() : IPLClonableProcess() { init(); }
+                            ~IPLCollapsePyramid()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+    void                    beforeProcessing        ();
+    void                    afterProcessing         ();
+
+    static IPLImage*        collapse                (IPLPyramid* pyramid);
+    static IPLPyramid*      blend                   (IPLPyramid* a, IPLPyramid* b, IPLImage* mask);
+
+protected:
+    IPLImage*               _result;
+    IPLPyramid*             _inputA;                //!< not owned
+    IPLPyramid*             _inputB;                //!< not owned
+    IPLImage*               _mask;                  //!< not owned
+};
+
+#endif // IPLCOLLAPSEPYRAMID_H
@@ -0,0 +1,44 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLCONVERTCOLORSPACE_H
+#define IPLCONVERTCOLORSPACE_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLColorConversion.h"
+
+/**
+ * \brief The IPLConvertColorSpace class converts the three planes of a color
+ * image between RGB, Linear RGB, HSV, HSL, Lab, YCbCr and XYZ.
+ */
+class IPLSHARED_EXPORT IPLConvertColorSpace : public IPLClonableProcess<IPLConvertColorSpace>
+{
+public:
+    IPLConvertColorSpace() : IPLClonableProcess() { init(); }
+    ~IPLConvertColorSpace()  { destroy(); }
+    void                    init();
+    virtual void            destroy();
+    virtual bool            processInputData        (IPLData* data, int inNr, bool useOpenCV);
+    virtual IPLImage*       getResultData           (int outNr);
+protected:
+    IPLImage*               _result;
+};
+
+#endif // IPLCONVERTCOLORSPACE_H
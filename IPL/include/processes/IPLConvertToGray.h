@@ -22,6 +22,7 @@
 
 #include "IPL_global.h"
 #include "IPLProcess.h"
+#include "IPLColorConversion.h"
 
 /**
  * \brief The IPLConvertToGray class.
@@ -0,0 +1,72 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLDEMOSAIC_H
+#define IPLDEMOSAIC_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLDemosaic class interpolates color images from Bayer mosaics
+ *
+ * The input is the single plane sensor image, e.g. loaded as 8 or 16 bit
+ * RAW file. Missing colors are interpolated bilinearly or with the
+ * gradient-corrected linear filters of Malvar, He and Cutler (2004).
+ *
+ * The image is copied once with a 2 pixel mirrored border which keeps the
+ * Bayer phase, so the row kernels need no border checks. Every row kernel
+ * is instantiated for the two sites of its row, e.g. red and green, and
+ * computes one pair of pixels per iteration without branches so the
+ * compiler can vectorize it. Rows are processed in parallel.
+ */
+class IPLSHARED_EXPORT IPLDemosaic : public IPLClonableProcess<IPLDemosaic>
+{
+public:
+                            IPLDemosaic() : IPLClonableProcess() { init(); }
+                            ~IPLDemosaic()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    enum Pattern
+    {
+        PATTERN_RGGB = 0,
+        PATTERN_BGGR,
+        PATTERN_GRBG,
+        PATTERN_GBRG
+    };
+
+    enum Method
+    {
+        METHOD_BILINEAR = 0,
+        METHOD_MALVAR
+    };
+
+    static void             demosaic                (IPLImage* mosaic, IPLImage* result, int pattern, int method);
+
+protected:
+    IPLImage*               _result;
+};
+
+#endif // IPLDEMOSAIC_H
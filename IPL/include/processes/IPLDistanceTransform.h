@@ -0,0 +1,57 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLDISTANCETRANSFORM_H
+#define IPLDISTANCETRANSFORM_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLDistanceTransform class computes the Euclidean distance transform and watershed seeds
+ *
+ * The exact Euclidean distance of every foreground pixel to the closest
+ * background pixel is computed with the separable algorithm of Felzenszwalb
+ * and Huttenlocher, columns and rows in parallel.
+ * Seeds are the connected regions where the distance is at least a fraction
+ * of the maximum distance of their object. They can be used as markers of
+ * the Watershed process, the inverted distance as its relief.
+ */
+class IPLSHARED_EXPORT IPLDistanceTransform : public IPLClonableProcess<IPLDistanceTransform>
+{
+public:
+                            IPLDistanceTransform() : IPLClonableProcess() { init(); }
+                            ~IPLDistanceTransform()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    static void             distance                (const std::vector<unsigned char>& mask, int width, int height, std::vector<float>& result);
+    static int              labelComponents         (const std::vector<unsigned char>& mask, int width, int height, std::vector<int>& labels);
+
+protected:
+    IPLImage*               _distance;
+    IPLImage*               _seeds;
+};
+
+#endif // IPLDISTANCETRANSFORM_H
@@ -0,0 +1,89 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLFRAMEBUFFER_H
+#define IPLFRAMEBUFFER_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLFrameBuffer class keeps the last N frames and computes temporal statistics
+ *
+ * The frames are copied into a preallocated ring. All statistics are updated
+ * with the frame entering and the frame leaving the window instead of
+ * passing over all N frames:
+ *  - Mean: running sum in double precision
+ *  - Median: sorted window per pixel, one removal and one insertion
+ *  - Minimum/Maximum: only rescanned if the leaving value was the extreme
+ *  - Difference: |newest - previous frame|
+ *
+ * Median, minimum and maximum are only maintained after their output has
+ * been requested once. Output images are filled on request.
+ */
+class IPLSHARED_EXPORT IPLFrameBuffer : public IPLClonableProcess<IPLFrameBuffer>
+{
+public:
+                            IPLFrameBuffer() : IPLClonableProcess() { init(); }
+                            ~IPLFrameBuffer()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    enum Output
+    {
+        OUTPUT_MEAN = 0,
+        OUTPUT_MEDIAN,
+        OUTPUT_MINIMUM,
+        OUTPUT_MAXIMUM,
+        OUTPUT_DIFFERENCE,
+        NUM_OUTPUTS
+    };
+
+protected:
+    void                    reset                   (IPLImage* image, int frames);
+    float*                  slot                    (int index, int plane)  { return &_ring[((size_t) index * _planes + plane) * _pixels]; }
+    void                    activateMedian          ();
+    void                    activateExtrema         ();
+
+    std::vector<float>      _ring;                  //!< frames x planes x pixels
+    std::vector<double>     _sum;                   //!< planes x pixels
+    std::vector<float>      _sorted;                //!< planes x pixels x frames
+    std::vector<float>      _minimum;
+    std::vector<float>      _maximum;
+    IPLImage*               _results[NUM_OUTPUTS];
+    bool                    _dirty[NUM_OUTPUTS];
+    bool                    _medianActive;
+    bool                    _extremaActive;
+    int                     _frames;
+    int                     _head;                  //!< slot of the newest frame
+    int                     _count;
+    int                     _resetCounter;
+    int                     _width;
+    int                     _height;
+    int                     _planes;
+    size_t                  _pixels;
+    IPLDataType             _type;
+};
+
+#endif // IPLFRAMEBUFFER_H
@@ -25,6 +25,7 @@
 #include "IPLMatrix.h"
 
 #include <string>
+#include <vector>
 
 #include "opencv2/core/core.hpp"
 #include "opencv2/imgproc/imgproc.hpp"
@@ -42,8 +43,15 @@ public:
     void                    init                    ();
     void                    destroy                 ();
     bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    bool                    processInputDataBatch   (const std::vector<IPLData*>& inputs, int inputIndex, bool useOpenCV,
+                                                     std::vector<IPLData*>& results, int outputIndex = 0);
     IPLData*                getResultData           (int);
 
+    static void             kernels                 (int window, int wavelength, double direction, double deviation,
+                                                     std::vector<double>& qEven, std::vector<double>& qOdd);
+    static void             gabor                   (IPLImage* image, IPLImage* evenResult, IPLImage* oddResult, IPLImage* powerResult,
+                                                     const double* qEven, const double* qOdd, int w2);
+
 protected:
     IPLImage*               _result0;
     IPLImage*               _result1;
@@ -25,6 +25,7 @@
 #include "IPLMatrix.h"
 
 #include <string>
+#include <vector>
 
 #include "opencv2/core/core.hpp"
 #include "opencv2/imgproc/imgproc.hpp"
@@ -43,8 +44,13 @@ public:
     virtual void            destroy();
 
     bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    bool                    processInputDataBatch   (const std::vector<IPLData*>& inputs, int inputIndex, bool useOpenCV,
+                                                     std::vector<IPLData*>& results, int outputIndex = 0);
     IPLData*                getResultData           (int);
 
+    static void             window                  (double sigma, int& window, int& N);
+    static std::vector<float> kernel                (double sigma, int N);
+    static void             gauss                   (IPLImage* image, IPLImage* result, const float* filter, int N);
     static void             gauss                   (IPLImage* image, IPLImage* result, IPLData* kernel, int height, int window, double sigma, int width, int N);
 protected:
     IPLImage*               _result;
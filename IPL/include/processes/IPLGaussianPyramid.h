@@ -0,0 +1,57 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLGAUSSIANPYRAMID_H
+#define IPLGAUSSIANPYRAMID_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLPyramid.h"
+
+#include <string>
+
+/**
+ * @brief The IPLGaussianPyramid class builds all levels of a Gaussian pyramid
+ * Uses the 5-tap binomial kernel (1 4 6 4 1)/16 in float precision. The
+ * static reduce and expand functions are shared with the Laplacian pyramid
+ * and the collapse process.
+ */
+class IPLSHARED_EXPORT IPLGaussianPyramid : public IPLClonableProcess<IPLGaussianPyramid>
+{
+public:
+                            IPLGaussianPyramid() : IPLClonableProcess() { init(); }
+                            ~IPLGaussianPyramid()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    static void             reduce                  (IPLImage* image, IPLImage* result);
+    static void             expand                  (IPLImage* image, IPLImage* result);
+    static IPLPyramid*      build                   (IPLImage* image, int levels);
+    static IPLImage*        mosaic                  (IPLPyramid* pyramid);
+
+protected:
+    IPLImage*               _mosaic;
+    IPLPyramid*             _pyramid;
+    IPLImage*               _level;
+};
+
+#endif // IPLGAUSSIANPYRAMID_H
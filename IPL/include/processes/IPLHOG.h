@@ -0,0 +1,74 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLHOG_H
+#define IPLHOG_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLMatrix.h"
+#include "IPLIntegralImage.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLHOG class computes dense histograms of oriented gradients
+ *
+ * Magnitude and phase are taken from a connected oriented image (Gradient
+ * Operator), otherwise they are computed with centered differences (the
+ * strongest plane for color images). Every pixel votes into the two
+ * nearest orientation bins and the four nearest cells, weighted linearly.
+ * Cell rows are computed in parallel, each one reads the pixel rows it
+ * overlaps, so no votes are shared between threads.
+ *
+ * Blocks of n x n cells overlap with a stride of one cell. The norm of
+ * every block is read from an integral image of the cell energies in
+ * constant time. The descriptor matrix has one row per block in row-major
+ * block order, the cells of a block are concatenated in row-major order.
+ */
+class IPLSHARED_EXPORT IPLHOG : public IPLClonableProcess<IPLHOG>
+{
+public:
+                            IPLHOG() : IPLClonableProcess() { init(); }
+                            ~IPLHOG()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    enum Normalization
+    {
+        NORM_L2 = 0,
+        NORM_L2_HYS
+    };
+
+protected:
+    void                    gradient                (IPLImage* image, bool oriented);
+    void                    drawCells               (int cellsX, int cellsY, int cellSize, int bins, bool signedOrientation);
+
+    IPLImage*               _result;
+    IPLMatrix*              _descriptors;
+    IPLIntegralImage        _energy;
+    std::vector<float>      _magnitude;             //!< gradient magnitude
+    std::vector<float>      _angle;                 //!< gradient angle, 0..2 PI
+    std::vector<float>      _cells;                 //!< cell histograms
+};
+
+#endif // IPLHOG_H
@@ -0,0 +1,51 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLINTEGRAL_H
+#define IPLINTEGRAL_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLIntegralImage.h"
+
+#include <string>
+
+/**
+ * @brief The IPLIntegral class computes the integral image (summed-area table)
+ * The integral image can be used by following processes like the box
+ * filter to get the sum of any window in constant time. The first output
+ * shows the integral normalized to 0..1.
+ */
+class IPLSHARED_EXPORT IPLIntegral : public IPLClonableProcess<IPLIntegral>
+{
+public:
+                            IPLIntegral() : IPLClonableProcess() { init(); }
+                            ~IPLIntegral()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+protected:
+    IPLIntegralImage*       _integral;
+    IPLImage*               _result;
+};
+
+#endif // IPLINTEGRAL_H
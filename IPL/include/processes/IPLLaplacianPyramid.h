@@ -0,0 +1,54 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLLAPLACIANPYRAMID_H
+#define IPLLAPLACIANPYRAMID_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLPyramid.h"
+
+#include <string>
+
+/**
+ * @brief The IPLLaplacianPyramid class builds all levels of a Laplacian pyramid
+ * Every level is the difference between a Gaussian level and the expanded
+ * next level, the last level is the Gaussian residual. IPLCollapsePyramid
+ * reconstructs the image.
+ */
+class IPLSHARED_EXPORT IPLLaplacianPyramid : public IPLClonableProcess<IPLLaplacianPyramid>
+{
+public:
+                            IPLLaplacianPyramid() : IPLClonableProcess() { init(); }
+                            ~IPLLaplacianPyramid()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    static IPLPyramid*      build                   (IPLImage* image, int levels);
+
+protected:
+    IPLImage*               _mosaic;
+    IPLPyramid*             _pyramid;
+    IPLImage*               _level;
+};
+
+#endif // IPLLAPLACIANPYRAMID_H
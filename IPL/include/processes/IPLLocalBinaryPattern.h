@@ -0,0 +1,75 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLLOCALBINARYPATTERN_H
+#define IPLLOCALBINARYPATTERN_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLMatrix.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLLocalBinaryPattern class computes local binary pattern (LBP) textures
+ *
+ * P = 8 or 16 neighbours are sampled on a circle of the given radius,
+ * bilinearly interpolated or from the nearest pixel (radius 1, 8
+ * neighbours and no interpolation is the basic 3x3 LBP). Every neighbour
+ * is compared with a whole row of centers at once: the sample offset and
+ * interpolation weights are the same for all pixels, so the row loops are
+ * branch-free and vectorized by the compiler.
+ *
+ * The codes are mapped to labels:
+ *  - Basic: the code itself, 2^P labels
+ *  - Uniform: codes with at most 2 transitions get their own label, P(P-1)+3 labels
+ *  - Rotation Invariant: the minimum over all rotations
+ *  - Uniform Rotation Invariant: the number of ones of uniform codes, P+2 labels
+ *
+ * Optionally the normalized label histogram of every cell is accumulated
+ * while the labels are computed, one matrix row per cell in row-major
+ * cell order.
+ */
+class IPLSHARED_EXPORT IPLLocalBinaryPattern : public IPLClonableProcess<IPLLocalBinaryPattern>
+{
+public:
+                            IPLLocalBinaryPattern() : IPLClonableProcess() { init(); }
+                            ~IPLLocalBinaryPattern()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    enum Mode
+    {
+        MODE_BASIC = 0,
+        MODE_UNIFORM,
+        MODE_ROTATION_INVARIANT,
+        MODE_UNIFORM_ROTATION_INVARIANT
+    };
+
+    static int              mapping                 (int mode, int neighbours, std::vector<int>& table);
+
+protected:
+    IPLImage*               _result;
+    IPLMatrix*              _histograms;
+};
+
+#endif // IPLLOCALBINARYPATTERN_H
@@ -22,9 +22,11 @@
 
 #include "IPL_global.h"
 #include "IPLProcess.h"
+#include "IPLIntegralImage.h"
 
 /**
  * @brief The IPLLocalThreshold class
+ * Local mean and standard deviation are read from an integral image.
  */
 class IPLSHARED_EXPORT IPLLocalThreshold : public IPLClonableProcess<IPLLocalThreshold>
 {
@@ -39,6 +41,7 @@ public:
 
 protected:
     IPLImage*               _result;
+    IPLIntegralImage        _integral;
 };
 
 #endif // IPLLocalThreshold_H
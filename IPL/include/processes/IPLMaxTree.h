@@ -0,0 +1,50 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLMAXTREE_H
+#define IPLMAXTREE_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLComponentTree.h"
+
+#include <string>
+
+/**
+ * @brief The IPLMaxTree class builds the max-tree or min-tree of a gray image
+ * The component tree is used by the Attribute Filter, the first output
+ * shows the quantized image the tree represents.
+ */
+class IPLSHARED_EXPORT IPLMaxTree : public IPLClonableProcess<IPLMaxTree>
+{
+public:
+                            IPLMaxTree() : IPLClonableProcess() { init(); }
+                            ~IPLMaxTree()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+protected:
+    IPLComponentTree*       _tree;
+    IPLImage*               _result;
+};
+
+#endif // IPLMAXTREE_H
@@ -0,0 +1,61 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLNONLOCALMEANS_H
+#define IPLNONLOCALMEANS_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+#include "opencv2/photo.hpp"
+
+/**
+ * @brief The IPLNonLocalMeans class implements non-local means denoising
+ *
+ * The patch distances are computed per search offset with an integral image
+ * of the squared differences, so every pixel costs O(search²) independent
+ * of the patch size. The image is processed in parallel row strips.
+ * Color images can use the joint distance of all planes or denoise every
+ * plane separately.
+ */
+class IPLSHARED_EXPORT IPLNonLocalMeans : public IPLClonableProcess<IPLNonLocalMeans>
+{
+public:
+                            IPLNonLocalMeans() : IPLClonableProcess() { init(); }
+                            ~IPLNonLocalMeans()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    void                    denoise                 (IPLImage* image, IPLImage* result, const std::vector<int>& planes,
+                                                     float h, int patchRadius, int searchRadius);
+
+protected:
+    IPLImage*               _result;
+    int                     _progress;
+    int                     _maxProgress;
+};
+
+#endif // IPLNONLOCALMEANS_H
@@ -0,0 +1,45 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLRAWVIDEOINPUT_H
+#define IPLRAWVIDEOINPUT_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLRawVideoIO.h"
+
+/**
+ * @brief The IPLRawVideoInput class reads headerless raw frames from stdin.
+ */
+class IPLSHARED_EXPORT IPLRawVideoInput : public IPLClonableProcess<IPLRawVideoInput>
+{
+public:
+    IPLRawVideoInput() : IPLClonableProcess() { init(); }
+    ~IPLRawVideoInput()  { destroy(); }
+
+    void init();
+    void destroy();
+    virtual bool        processInputData            (IPLData* data, int inNr, bool useOpenCV);
+    virtual IPLImage*   getResultData               (int outNr);
+    void                afterProcessing             ();
+protected:
+    IPLImage*           _result;
+};
+
+#endif // IPLRAWVIDEOINPUT_H
@@ -0,0 +1,46 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLRAWVIDEOOUTPUT_H
+#define IPLRAWVIDEOOUTPUT_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLRawVideoIO.h"
+
+/**
+ * @brief The IPLRawVideoOutput class writes its input as headerless raw frames to stdout.
+ */
+class IPLSHARED_EXPORT IPLRawVideoOutput : public IPLClonableProcess<IPLRawVideoOutput>
+{
+public:
+    IPLRawVideoOutput() : IPLClonableProcess() { init(); }
+    ~IPLRawVideoOutput()  { destroy(); }
+
+    void init();
+    void destroy();
+    virtual bool        processInputData            (IPLData* data, int inNr, bool useOpenCV);
+    virtual IPLImage*   getResultData               (int outNr);
+protected:
+    IPLImage*           _result;
+    int                 _width;
+    int                 _height;
+};
+
+#endif // IPLRAWVIDEOOUTPUT_H
@@ -0,0 +1,56 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLSHAREDMEMORYINPUT_H
+#define IPLSHAREDMEMORYINPUT_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLSharedMemoryRing.h"
+
+#include <string>
+
+/**
+ * @brief The IPLSharedMemoryInput class reads frames from a shared-memory ring
+ * created by another process.
+ *
+ * Planar float frames are used without copying. While no frame arrives only
+ * this process is re-executed, the following steps run for each new frame.
+ */
+class IPLSHARED_EXPORT IPLSharedMemoryInput : public IPLClonableProcess<IPLSharedMemoryInput>
+{
+public:
+    IPLSharedMemoryInput() : IPLClonableProcess() { init(); }
+    ~IPLSharedMemoryInput()  { destroy(); }
+
+    void init();
+    void destroy();
+    virtual bool        processInputData            (IPLData* data, int inNr, bool useOpenCV);
+    virtual IPLImage*   getResultData               (int outNr);
+    void                afterProcessing             ();
+protected:
+    IPLImage*           _result;
+    IPLSharedMemoryRing* _ring;
+    std::string         _name;
+    uint64_t            _sequence;
+    uint64_t            _skipped;
+    bool                _deliver;
+};
+
+#endif // IPLSHAREDMEMORYINPUT_H
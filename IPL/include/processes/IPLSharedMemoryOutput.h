@@ -0,0 +1,53 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLSHAREDMEMORYOUTPUT_H
+#define IPLSHAREDMEMORYOUTPUT_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLSharedMemoryRing.h"
+
+#include <string>
+
+/**
+ * @brief The IPLSharedMemoryOutput class publishes its input to a shared-memory
+ * ring which is read by another process.
+ *
+ * The ring is created with the size of the first image and created again
+ * when the size or the settings change.
+ */
+class IPLSHARED_EXPORT IPLSharedMemoryOutput : public IPLClonableProcess<IPLSharedMemoryOutput>
+{
+public:
+    IPLSharedMemoryOutput() : IPLClonableProcess() { init(); }
+    ~IPLSharedMemoryOutput()  { destroy(); }
+
+    void init();
+    void destroy();
+    virtual bool        processInputData            (IPLData* data, int inNr, bool useOpenCV);
+    virtual IPLImage*   getResultData               (int outNr);
+protected:
+    IPLImage*           _result;
+    IPLSharedMemoryRing* _ring;
+    int                 _slots;
+    uint64_t            _dropped;
+};
+
+#endif // IPLSHAREDMEMORYOUTPUT_H
@@ -0,0 +1,64 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLSUPERPIXELS_H
+#define IPLSUPERPIXELS_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLSuperpixels class implements SLIC superpixels in Lab space
+ *
+ * The cluster centers start on a regular grid with step S and are moved to
+ * the lowest gradient of their 3x3 neighbourhood. Every iteration assigns
+ * each pixel to the closest center of the 3x3 neighbouring grid cells whose
+ * 2S x 2S window contains the pixel, and moves the centers to the mean of
+ * their pixels. Both steps run in parallel over the rows, so the runtime
+ * is linear in the number of pixels and does not depend on the number of
+ * superpixels. Afterwards a linear pass makes every superpixel connected
+ * and merges fragments smaller than S*S/4 into an adjacent superpixel.
+ */
+class IPLSHARED_EXPORT IPLSuperpixels : public IPLClonableProcess<IPLSuperpixels>
+{
+public:
+                            IPLSuperpixels() : IPLClonableProcess() { init(); }
+                            ~IPLSuperpixels()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+
+    //! superpixel of every pixel after processing: 0..n-1
+    const std::vector<int>& labels                  ()                      { return _labels; }
+    int                     numberOfLabels          ()                      { return _numberOfLabels; }
+
+    static int              enforceConnectivity     (std::vector<int>& labels, int width, int height, int minimumSize);
+
+protected:
+    IPLImage*               _result;
+    IPLImage*               _meanColor;
+    std::vector<int>        _labels;
+    int                     _numberOfLabels;
+};
+
+#endif // IPLSUPERPIXELS_H
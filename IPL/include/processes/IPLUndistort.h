@@ -23,6 +23,7 @@
 #include "IPL_global.h"
 #include "IPLProcess.h"
 #include "IPLMatrix.h"
+#include "IPLRemapTable.h"
 
 #include <string>
 
@@ -47,6 +48,7 @@ public:
 
 protected:
     IPLImage*               _result;
+    IPLRemapTable           _map;
 };
 
 #endif // IPLUndistort_H
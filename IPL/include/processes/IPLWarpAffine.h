@@ -23,6 +23,7 @@
 #include "IPL_global.h"
 #include "IPLProcess.h"
 #include "IPLMatrix.h"
+#include "IPLResampler.h"
 
 #include <string>
 
@@ -23,6 +23,8 @@
 #include "IPL_global.h"
 #include "IPLProcess.h"
 #include "IPLMatrix.h"
+#include "IPLResampler.h"
+#include "IPLRemapTable.h"
 
 #include <string>
 
@@ -50,6 +52,7 @@ protected:
     IPLImage*               _inputB;
     IPLImage*               _previewA;
     IPLImage*               _previewB;
+    IPLRemapTable           _map;
 };
 
 #endif // IPLWarpPerspective_H
@@ -0,0 +1,58 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLWATCHFOLDER_H
+#define IPLWATCHFOLDER_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+#include "IPLFolderWatcher.h"
+
+#include <string>
+
+/**
+ * @brief The IPLWatchFolder class emits every new file written to a folder once.
+ *
+ * Decoding runs on the IPLFolderWatcher thread. While no file arrives only
+ * this process is re-executed, the following steps run when a new image is
+ * available.
+ */
+class IPLSHARED_EXPORT IPLWatchFolder : public IPLClonableProcess<IPLWatchFolder>
+{
+public:
+    IPLWatchFolder() : IPLClonableProcess() { init(); }
+    ~IPLWatchFolder()  { destroy(); }
+
+    void init();
+    void destroy();
+    virtual bool        processInputData            (IPLData* data, int inNr, bool useOpenCV);
+    virtual IPLImage*   getResultData               (int outNr);
+    void                afterProcessing             ();
+protected:
+    IPLImage*           _result;
+    IPLFolderWatcher*   _watcher;
+    std::string         _folder;
+    std::string         _moveFolder;
+    int                 _action;
+    int                 _queueSize;
+    std::string         _fileName;
+    bool                _deliver;
+};
+
+#endif // IPLWATCHFOLDER_H
@@ -0,0 +1,80 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#ifndef IPLWATERSHED_H
+#define IPLWATERSHED_H
+
+#include "IPL_global.h"
+#include "IPLProcess.h"
+
+#include <vector>
+
+/**
+ * @brief The IPLWatershed class implements the marker-controlled watershed
+ *
+ * The relief is quantized to a number of levels and flooded from the
+ * markers with a hierarchical queue (one FIFO per level), every pixel is
+ * pushed and popped once. Pixels where two basins meet become one pixel
+ * wide watershed lines.
+ *
+ * Markers are a gray image where every distinct value > 0 is one basin,
+ * e.g. the output of Label Blobs or the seeds of the Distance Transform.
+ * If the maximum is excluded, pixels with the maximum relief (e.g. the
+ * background of the inverted distance transform) are not flooded and the
+ * separated regions are flooded in parallel.
+ *
+ * The inputs are only referenced until the processing run ends.
+ */
+class IPLSHARED_EXPORT IPLWatershed : public IPLClonableProcess<IPLWatershed>
+{
+public:
+                            IPLWatershed() : IPLClonableProcess() { init(); }
+                            ~IPLWatershed()  { destroy(); }
+
+    void                    init                    ();
+    void                    destroy                 ();
+    bool                    processInputData        (IPLData*, int, bool useOpenCV);
+    IPLData*                getResultData           (int);
+    void                    beforeProcessing        ();
+    void                    afterProcessing         ();
+
+    //! label of every pixel after processing: 1..n basins, LINE or 0 if not flooded
+    const std::vector<int>& labels                  ()                      { return _labels; }
+    int                     numberOfLabels          ()                      { return _numberOfLabels; }
+
+    enum Label
+    {
+        BACKGROUND  = -3,
+        IN_QUEUE    = -2,
+        LINE        = -1
+    };
+
+    static void             flood                   (const std::vector<unsigned short>& level, std::vector<int>& labels,
+                                                     int width, int height, int levels, const int* pixels, int count);
+
+protected:
+    IPLImage*               _relief;                //!< not owned
+    IPLImage*               _markers;               //!< not owned
+    IPLImage*               _result;
+    IPLImage*               _lines;
+    std::vector<int>        _labels;
+    int                     _numberOfLabels;
+};
+
+#endif // IPLWATERSHED_H
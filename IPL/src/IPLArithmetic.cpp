@@ -0,0 +1,248 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLArithmetic.h"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace
+{
+inline float clampTop(float value)
+{
+    return value > 1.0f ? 1.0f : value;
+}
+
+inline float isTrue(float value)
+{
+    return value == 1.0f ? 1.0f : 0.0f;
+}
+
+// one functor per operation, written without branches so the row loops can be vectorized
+struct OpAdd    { static inline float apply(float a, float b) { return std::min(1.0f, a + b); } };
+struct OpSub    { static inline float apply(float a, float b) { return std::max(0.0f, a - b); } };
+struct OpMul    { static inline float apply(float a, float b) { return a * b; } };
+struct OpDiv    { static inline float apply(float a, float b) { return b > 0.0f ? a / b : 0.0f; } };
+struct OpMin    { static inline float apply(float a, float b) { return std::min(a, b); } };
+struct OpMax    { static inline float apply(float a, float b) { return std::max(a, b); } };
+struct OpAnd    { static inline float apply(float a, float b) { return isTrue(a) * isTrue(b); } };
+struct OpOr     { static inline float apply(float a, float b) { return std::max(isTrue(a), isTrue(b)); } };
+struct OpXor    { static inline float apply(float a, float b) { return std::fabs(isTrue(a) - isTrue(b)); } };
+struct OpNot    { static inline float apply(float a, float)   { return 1.0f - isTrue(a); } };
+struct OpAtan2  { static inline float apply(float a, float b) { return IPLArithmetic::atan2(a, b); } };
+
+template<class Op>
+void binaryRow(const float* a, const float* b, float* out, int width)
+{
+    for(int x = 0; x < width; x++)
+        out[x] = clampTop(Op::apply(a[x], b[x]));
+}
+
+template<class Op>
+void scalarRow(const float* a, float b, float* out, int width)
+{
+    for(int x = 0; x < width; x++)
+        out[x] = clampTop(Op::apply(a[x], b));
+}
+
+// division by a constant is a multiplication with its reciprocal
+void scalarDivRow(const float* a, float b, float* out, int width)
+{
+    if(b <= 0.0f)
+    {
+        std::fill(out, out + width, 0.0f);
+        return;
+    }
+
+    float inverse = 1.0f / b;
+    for(int x = 0; x < width; x++)
+        out[x] = clampTop(a[x] * inverse);
+}
+
+/*!
+ * \brief resultImage reuses result if type and size fit, otherwise replaces it
+ */
+IPLImage* resultImage(IPLImage* result, IPLDataType type, int width, int height)
+{
+    if(result && result->type() == type && result->width() == width && result->height() == height)
+        return result;
+
+    delete result;
+    return new IPLImage(type, width, height);
+}
+}
+
+/*!
+ * \brief IPLArithmetic::rowKernel returns the kernel for two rows
+ */
+IPLArithmetic::RowKernel IPLArithmetic::rowKernel(int operation)
+{
+    switch(operation)
+    {
+    case ADD:   return &binaryRow<OpAdd>;
+    case SUB:   return &binaryRow<OpSub>;
+    case MUL:   return &binaryRow<OpMul>;
+    case DIV:   return &binaryRow<OpDiv>;
+    case MIN:   return &binaryRow<OpMin>;
+    case MAX:   return &binaryRow<OpMax>;
+    case AND:   return &binaryRow<OpAnd>;
+    case OR:    return &binaryRow<OpOr>;
+    case XOR:   return &binaryRow<OpXor>;
+    case NOT:   return &binaryRow<OpNot>;
+    case ATAN2: return &binaryRow<OpAtan2>;
+    default:    return NULL;
+    }
+}
+
+/*!
+ * \brief IPLArithmetic::scalarKernel returns the kernel for a row and a scalar
+ */
+IPLArithmetic::ScalarKernel IPLArithmetic::scalarKernel(int operation)
+{
+    switch(operation)
+    {
+    case ADD:   return &scalarRow<OpAdd>;
+    case SUB:   return &scalarRow<OpSub>;
+    case MUL:   return &scalarRow<OpMul>;
+    case DIV:   return &scalarDivRow;
+    case MIN:   return &scalarRow<OpMin>;
+    case MAX:   return &scalarRow<OpMax>;
+    case AND:   return &scalarRow<OpAnd>;
+    case OR:    return &scalarRow<OpOr>;
+    case XOR:   return &scalarRow<OpXor>;
+    case NOT:   return &scalarRow<OpNot>;
+    case ATAN2: return &scalarRow<OpAtan2>;
+    default:    return NULL;
+    }
+}
+
+/*!
+ * \brief IPLArithmetic::apply combines two images
+ * The result has the size of the larger image and is color if one of the
+ * inputs is. result is reused if possible, otherwise it is deleted.
+ * \return the result image or NULL for an unknown operation
+ */
+IPLImage* IPLArithmetic::apply(int operation, IPLImage* a, IPLImage* b, IPLImage* result)
+{
+    RowKernel kernel = rowKernel(operation);
+    if(!kernel)
+        return result;
+
+    int widthA  = a->width();
+    int heightA = a->height();
+    int widthB  = b->width();
+    int heightB = b->height();
+    int width   = std::max(widthA, widthB);
+    int height  = std::max(heightA, heightB);
+    int planesA = a->getNumberOfPlanes();
+    int planesB = b->getNumberOfPlanes();
+    int planes  = std::max(planesA, planesB);
+
+    result = resultImage(result, planes > 1 ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE, width, height);
+    planes = std::min(planes, result->getNumberOfPlanes());
+
+    // pixels outside of an image are 0
+    std::vector<float> zeros(width, 0.0f);
+    const float* zero = &zeros[0];
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        // overlap of both images and the part covered by only one in this row
+        int validA  = (y < heightA) ? widthA : 0;
+        int validB  = (y < heightB) ? widthB : 0;
+        int overlap = std::min(validA, validB);
+        int covered = std::max(validA, validB);
+
+        for(int p = 0; p < planes; p++)
+        {
+            // a single plane is broadcast to all planes
+            const float* rowA = validA ? &a->plane(std::min(p, planesA-1))->p(0, y) : zero;
+            const float* rowB = validB ? &b->plane(std::min(p, planesB-1))->p(0, y) : zero;
+            float* out = &result->plane(p)->p(0, y);
+
+            kernel(rowA, rowB, out, overlap);
+
+            if(covered > overlap)
+            {
+                if(validA > validB)
+                    kernel(rowA + overlap, zero, out + overlap, covered - overlap);
+                else
+                    kernel(zero, rowB + overlap, out + overlap, covered - overlap);
+            }
+
+            if(width > covered)
+                kernel(zero, zero, out + covered, width - covered);
+        }
+    }
+
+    return result;
+}
+
+/*!
+ * \brief IPLArithmetic::apply combines an image with a scalar
+ * The result has the type and size of a. result is reused if possible,
+ * otherwise it is deleted.
+ * \return the result image
+ */
+IPLImage* IPLArithmetic::apply(int operation, IPLImage* a, float b, IPLImage* result)
+{
+    ScalarKernel kernel = scalarKernel(operation);
+    if(!kernel)
+        return result;
+
+    int width  = a->width();
+    int height = a->height();
+
+    result = resultImage(result, a->type(), width, height);
+    int planes = std::min(a->getNumberOfPlanes(), result->getNumberOfPlanes());
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int p = 0; p < planes; p++)
+            kernel(&a->plane(p)->p(0, y), b, &result->plane(p)->p(0, y), width);
+    }
+
+    return result;
+}
+
+/*!
+ * \brief IPLArithmetic::atan2 approximates std::atan2 without branches
+ * atan on 0..1 is a polynomial in t = min(|x|,|y|) / max(|x|,|y|),
+ * the octant is restored with selects.
+ */
+float IPLArithmetic::atan2(float y, float x)
+{
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    float mx = std::max(ax, ay);
+    float mn = std::min(ax, ay);
+    float t  = mn / (mx > 0.0f ? mx : 1.0f);
+    float s  = t * t;
+
+    float r = t * (0.99997726f + s * (-0.33262347f + s * (0.19354346f
+            + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+
+    r = (ay > ax) ? 1.57079637f - r : r;
+    r = (x < 0.0f) ? 3.14159274f - r : r;
+    r = (y < 0.0f) ? -r : r;
+    return r;
+}
@@ -0,0 +1,435 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLColorConversion.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // sRGB <-> XYZ (D65)
+    const float RGB2XYZ[9] = { 0.412453f, 0.357580f, 0.180423f,
+                               0.212671f, 0.715160f, 0.072169f,
+                               0.019334f, 0.119193f, 0.950227f };
+    const float XYZ2RGB[9] = { 3.240479f, -1.537150f, -0.498535f,
+                              -0.969256f,  1.875991f,  0.041556f,
+                               0.055648f, -0.204043f,  1.057311f };
+    const float WHITE_X = 0.950456f;
+    const float WHITE_Z = 1.088754f;
+
+    // Lab companding
+    const float LAB_DELTA = 6.0f / 29.0f;
+    const float LAB_T0 = LAB_DELTA * LAB_DELTA * LAB_DELTA;
+    const float LAB_SLOPE = 1.0f / (3.0f * LAB_DELTA * LAB_DELTA);
+
+    /*!
+     * \brief The TransferTable struct tabulates the sRGB transfer function on [0, 1]
+     * Values are interpolated linearly, the error is below 2e-5.
+     */
+    struct TransferTable
+    {
+        enum { SIZE = 4096 };
+        float toLinear[SIZE + 2];
+        float toSrgb[SIZE + 2];
+
+        static float exactToLinear(float v)
+        {
+            return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+        }
+
+        static float exactToSrgb(float v)
+        {
+            return v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+        }
+
+        TransferTable()
+        {
+            for(int i = 0; i <= SIZE + 1; i++)
+            {
+                float v = std::min((float) i / SIZE, 1.0f);
+                toLinear[i] = exactToLinear(v);
+                toSrgb[i] = exactToSrgb(v);
+            }
+        }
+
+        static const TransferTable& instance()
+        {
+            static TransferTable table;
+            return table;
+        }
+
+        static inline float lookup(const float* table, float v)
+        {
+            float t = v * SIZE;
+            int i = (int) t;
+            float f = t - i;
+            return table[i] + (table[i + 1] - table[i]) * f;
+        }
+    };
+
+    inline float labF(float t)
+    {
+        return t > LAB_T0 ? std::cbrt(t) : t * LAB_SLOPE + 4.0f / 29.0f;
+    }
+
+    inline float labFInv(float t)
+    {
+        return t > LAB_DELTA ? t * t * t : (t - 4.0f / 29.0f) / LAB_SLOPE;
+    }
+
+    inline float clamp01(float v)
+    {
+        return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    }
+}
+
+/*!
+ * \brief IPLColorConversion::name returns the display name of a color space
+ */
+const char* IPLColorConversion::name(int space)
+{
+    static const char* names[NUM_COLORSPACES] = { "RGB", "Linear RGB", "HSV", "HSL", "Lab", "YCbCr", "XYZ" };
+    return (space >= 0 && space < NUM_COLORSPACES) ? names[space] : "";
+}
+
+float IPLColorConversion::srgbToLinear(float value)
+{
+    if(value >= 0.0f && value <= 1.0f)
+        return TransferTable::lookup(TransferTable::instance().toLinear, value);
+    return TransferTable::exactToLinear(value);
+}
+
+float IPLColorConversion::linearToSrgb(float value)
+{
+    if(value >= 0.0f && value <= 1.0f)
+        return TransferTable::lookup(TransferTable::instance().toSrgb, value);
+    return TransferTable::exactToSrgb(value);
+}
+
+void IPLColorConversion::srgbToLinear(const float* input, float* output, int width)
+{
+    const float* table = TransferTable::instance().toLinear;
+    for(int x = 0; x < width; x++)
+    {
+        float v = input[x];
+        output[x] = (v >= 0.0f && v <= 1.0f) ? TransferTable::lookup(table, v) : TransferTable::exactToLinear(v);
+    }
+}
+
+void IPLColorConversion::linearToSrgb(const float* input, float* output, int width)
+{
+    const float* table = TransferTable::instance().toSrgb;
+    for(int x = 0; x < width; x++)
+    {
+        float v = input[x];
+        output[x] = (v >= 0.0f && v <= 1.0f) ? TransferTable::lookup(table, v) : TransferTable::exactToSrgb(v);
+    }
+}
+
+/*!
+ * \brief IPLColorConversion::fromRGB converts one row from sRGB to space
+ * The output rows may be the same as the input rows.
+ */
+void IPLColorConversion::fromRGB(int space, const float* r, const float* g, const float* b,
+                                 float* c0, float* c1, float* c2, int width)
+{
+    switch(space)
+    {
+    case LINEAR_RGB:
+        srgbToLinear(r, c0, width);
+        srgbToLinear(g, c1, width);
+        srgbToLinear(b, c2, width);
+        break;
+
+    case HSV:
+        for(int x = 0; x < width; x++)
+        {
+            float R = r[x], G = g[x], B = b[x];
+            float max = std::max(R, std::max(G, B));
+            float min = std::min(R, std::min(G, B));
+            float d = max - min;
+            float inv = d > 0.0f ? 1.0f / d : 0.0f;
+            float h = (max == R) ? (G - B) * inv : ((max == G) ? (B - R) * inv + 2.0f : (R - G) * inv + 4.0f);
+            h = h < 0.0f ? h + 6.0f : h;
+            c0[x] = h * (1.0f / 6.0f);
+            c1[x] = max > 0.0f ? d / max : 0.0f;
+            c2[x] = max;
+        }
+        break;
+
+    case HSL:
+        for(int x = 0; x < width; x++)
+        {
+            float R = r[x], G = g[x], B = b[x];
+            float max = std::max(R, std::max(G, B));
+            float min = std::min(R, std::min(G, B));
+            float d = max - min;
+            float l = (max + min) * 0.5f;
+            float inv = d > 0.0f ? 1.0f / d : 0.0f;
+            float h = (max == R) ? (G - B) * inv : ((max == G) ? (B - R) * inv + 2.0f : (R - G) * inv + 4.0f);
+            h = h < 0.0f ? h + 6.0f : h;
+            float denominator = l > 0.5f ? 2.0f - max - min : max + min;
+            c0[x] = h * (1.0f / 6.0f);
+            c1[x] = d > 0.0f ? d / denominator : 0.0f;
+            c2[x] = l;
+        }
+        break;
+
+    case LAB:
+    {
+        const float* table = TransferTable::instance().toLinear;
+        for(int x = 0; x < width; x++)
+        {
+            float R = TransferTable::lookup(table, clamp01(r[x]));
+            float G = TransferTable::lookup(table, clamp01(g[x]));
+            float B = TransferTable::lookup(table, clamp01(b[x]));
+            float X = (RGB2XYZ[0]*R + RGB2XYZ[1]*G + RGB2XYZ[2]*B) * (1.0f / WHITE_X);
+            float Y = (RGB2XYZ[3]*R + RGB2XYZ[4]*G + RGB2XYZ[5]*B);
+            float Z = (RGB2XYZ[6]*R + RGB2XYZ[7]*G + RGB2XYZ[8]*B) * (1.0f / WHITE_Z);
+            float fx = labF(X);
+            float fy = labF(Y);
+            float fz = labF(Z);
+            c0[x] = (116.0f * fy - 16.0f) * 0.01f;
+            c1[x] = 500.0f * (fx - fy) * (1.0f / 255.0f) + 128.0f / 255.0f;
+            c2[x] = 200.0f * (fy - fz) * (1.0f / 255.0f) + 128.0f / 255.0f;
+        }
+        break;
+    }
+
+    case YCBCR:
+        for(int x = 0; x < width; x++)
+        {
+            float R = r[x], G = g[x], B = b[x];
+            float Y = 0.299f*R + 0.587f*G + 0.114f*B;
+            c0[x] = Y;
+            c1[x] = (B - Y) * (1.0f / 1.772f) + 0.5f;
+            c2[x] = (R - Y) * (1.0f / 1.402f) + 0.5f;
+        }
+        break;
+
+    case XYZ:
+    {
+        const float* table = TransferTable::instance().toLinear;
+        for(int x = 0; x < width; x++)
+        {
+            float R = TransferTable::lookup(table, clamp01(r[x]));
+            float G = TransferTable::lookup(table, clamp01(g[x]));
+            float B = TransferTable::lookup(table, clamp01(b[x]));
+            c0[x] = RGB2XYZ[0]*R + RGB2XYZ[1]*G + RGB2XYZ[2]*B;
+            c1[x] = RGB2XYZ[3]*R + RGB2XYZ[4]*G + RGB2XYZ[5]*B;
+            c2[x] = RGB2XYZ[6]*R + RGB2XYZ[7]*G + RGB2XYZ[8]*B;
+        }
+        break;
+    }
+
+    default:
+        for(int x = 0; x < width; x++)
+        {
+            float R = r[x], G = g[x], B = b[x];
+            c0[x] = R;
+            c1[x] = G;
+            c2[x] = B;
+        }
+        break;
+    }
+}
+
+/*!
+ * \brief IPLColorConversion::toRGB converts one row from space to sRGB
+ * The output rows may be the same as the input rows.
+ */
+void IPLColorConversion::toRGB(int space, const float* c0, const float* c1, const float* c2,
+                               float* r, float* g, float* b, int width)
+{
+    switch(space)
+    {
+    case LINEAR_RGB:
+        linearToSrgb(c0, r, width);
+        linearToSrgb(c1, g, width);
+        linearToSrgb(c2, b, width);
+        break;
+
+    case HSV:
+        for(int x = 0; x < width; x++)
+        {
+            float h6 = (c0[x] - std::floor(c0[x])) * 6.0f;
+            float s = c1[x], v = c2[x];
+            float kr = std::fmod(5.0f + h6, 6.0f);
+            float kg = std::fmod(3.0f + h6, 6.0f);
+            float kb = std::fmod(1.0f + h6, 6.0f);
+            r[x] = v - v * s * std::max(0.0f, std::min(std::min(kr, 4.0f - kr), 1.0f));
+            g[x] = v - v * s * std::max(0.0f, std::min(std::min(kg, 4.0f - kg), 1.0f));
+            b[x] = v - v * s * std::max(0.0f, std::min(std::min(kb, 4.0f - kb), 1.0f));
+        }
+        break;
+
+    case HSL:
+        for(int x = 0; x < width; x++)
+        {
+            float h12 = (c0[x] - std::floor(c0[x])) * 12.0f;
+            float s = c1[x], l = c2[x];
+            float a = s * std::min(l, 1.0f - l);
+            float kr = std::fmod(h12, 12.0f);
+            float kg = std::fmod(8.0f + h12, 12.0f);
+            float kb = std::fmod(4.0f + h12, 12.0f);
+            r[x] = l - a * std::max(-1.0f, std::min(std::min(kr - 3.0f, 9.0f - kr), 1.0f));
+            g[x] = l - a * std::max(-1.0f, std::min(std::min(kg - 3.0f, 9.0f - kg), 1.0f));
+            b[x] = l - a * std::max(-1.0f, std::min(std::min(kb - 3.0f, 9.0f - kb), 1.0f));
+        }
+        break;
+
+    case LAB:
+        for(int x = 0; x < width; x++)
+        {
+            float L = c0[x] * 100.0f;
+            float A = (c1[x] - 128.0f / 255.0f) * 255.0f;
+            float B = (c2[x] - 128.0f / 255.0f) * 255.0f;
+            float fy = (L + 16.0f) * (1.0f / 116.0f);
+            float fx = fy + A * (1.0f / 500.0f);
+            float fz = fy - B * (1.0f / 200.0f);
+            float X = labFInv(fx) * WHITE_X;
+            float Y = labFInv(fy);
+            float Z = labFInv(fz) * WHITE_Z;
+            r[x] = linearToSrgb(XYZ2RGB[0]*X + XYZ2RGB[1]*Y + XYZ2RGB[2]*Z);
+            g[x] = linearToSrgb(XYZ2RGB[3]*X + XYZ2RGB[4]*Y + XYZ2RGB[5]*Z);
+            b[x] = linearToSrgb(XYZ2RGB[6]*X + XYZ2RGB[7]*Y + XYZ2RGB[8]*Z);
+        }
+        break;
+
+    case YCBCR:
+        for(int x = 0; x < width; x++)
+        {
+            float Y = c0[x];
+            float Cb = c1[x] - 0.5f;
+            float Cr = c2[x] - 0.5f;
+            r[x] = Y + 1.402f*Cr;
+            g[x] = Y - 0.714136f*Cr - 0.344136f*Cb;
+            b[x] = Y + 1.772f*Cb;
+        }
+        break;
+
+    case XYZ:
+        for(int x = 0; x < width; x++)
+        {
+            float X = c0[x], Y = c1[x], Z = c2[x];
+            r[x] = linearToSrgb(XYZ2RGB[0]*X + XYZ2RGB[1]*Y + XYZ2RGB[2]*Z);
+            g[x] = linearToSrgb(XYZ2RGB[3]*X + XYZ2RGB[4]*Y + XYZ2RGB[5]*Z);
+            b[x] = linearToSrgb(XYZ2RGB[6]*X + XYZ2RGB[7]*Y + XYZ2RGB[8]*Z);
+        }
+        break;
+
+    default:
+        for(int x = 0; x < width; x++)
+        {
+            float C0 = c0[x], C1 = c1[x], C2 = c2[x];
+            r[x] = C0;
+            g[x] = C1;
+            b[x] = C2;
+        }
+        break;
+    }
+}
+
+/*!
+ * \brief IPLColorConversion::convert converts three planes from one color space to another
+ * Conversions between two non RGB spaces go through sRGB. The same plane
+ * may be used as input and output.
+ */
+void IPLColorConversion::convert(IPLImagePlane* input[3], IPLImagePlane* output[3], int from, int to)
+{
+    int width = input[0]->width();
+    int height = input[0]->height();
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* in0 = &input[0]->p(0, y);
+        const float* in1 = &input[1]->p(0, y);
+        const float* in2 = &input[2]->p(0, y);
+        float* out0 = &output[0]->p(0, y);
+        float* out1 = &output[1]->p(0, y);
+        float* out2 = &output[2]->p(0, y);
+
+        if(from == to)
+        {
+            fromRGB(RGB, in0, in1, in2, out0, out1, out2, width);
+        }
+        else if(from == RGB)
+        {
+            fromRGB(to, in0, in1, in2, out0, out1, out2, width);
+        }
+        else if(to == RGB)
+        {
+            toRGB(from, in0, in1, in2, out0, out1, out2, width);
+        }
+        else
+        {
+            toRGB(from, in0, in1, in2, out0, out1, out2, width);
+            fromRGB(to, out0, out1, out2, out0, out1, out2, width);
+        }
+    }
+}
+
+/*!
+ * \brief IPLColorConversion::convert converts image into result (3 planes, may be the same image)
+ * Images with less than 3 planes are treated as gray, i.e. R = G = B.
+ */
+void IPLColorConversion::convert(IPLImage* image, IPLImage* result, int from, int to)
+{
+    IPLImagePlane* input[3];
+    IPLImagePlane* output[3];
+    for(int i = 0; i < 3; i++)
+    {
+        input[i] = image->plane(image->getNumberOfPlanes() >= 3 ? i : 0);
+        output[i] = result->plane(i);
+    }
+    convert(input, output, from, to);
+}
+
+/*!
+ * \brief IPLColorConversion::gray computes a weighted sum of the color planes, clamped to 0..1
+ * Images with less than 3 planes are copied.
+ */
+void IPLColorConversion::gray(IPLImage* image, IPLImage* result, float weightR, float weightG, float weightB)
+{
+    int width = image->width();
+    int height = image->height();
+    bool color = image->getNumberOfPlanes() >= 3;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        float* out = &result->plane(0)->p(0, y);
+
+        if(!color)
+        {
+            const float* in = &image->plane(0)->p(0, y);
+            for(int x = 0; x < width; x++)
+                out[x] = in[x];
+            continue;
+        }
+
+        const float* r = &image->plane(0)->p(0, y);
+        const float* g = &image->plane(1)->p(0, y);
+        const float* b = &image->plane(2)->p(0, y);
+        for(int x = 0; x < width; x++)
+            out[x] = clamp01(weightR*r[x] + weightG*g[x] + weightB*b[x]);
+    }
+}
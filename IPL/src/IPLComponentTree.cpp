@@ -0,0 +1,395 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLComponentTree.h"
+
+#include <algorithm>
+
+namespace
+{
+//! root of the union-find set of p, with path halving
+inline int findRoot(int* zpar, int p)
+{
+    while(zpar[p] != p)
+    {
+        zpar[p] = zpar[zpar[p]];
+        p = zpar[p];
+    }
+    return p;
+}
+
+//! canonical pixel of the node of p, the path is compressed
+inline int levelRoot(int* parent, const unsigned short* level, int p)
+{
+    int root = p;
+    while(parent[root] >= 0 && level[parent[root]] == level[root])
+        root = parent[root];
+
+    while(p != root)
+    {
+        int next = parent[p];
+        parent[p] = root;
+        p = next;
+    }
+    return root;
+}
+}
+
+IPLComponentTree::IPLComponentTree() : IPLData(IPL_COMPONENT_TREE)
+{
+    _width = 0;
+    _height = 0;
+    _maxTree = true;
+    _maxLevel = 255;
+}
+
+IPLComponentTree::IPLComponentTree(const IPLComponentTree &other) : IPLData(IPL_COMPONENT_TREE)
+{
+    _width = other._width;
+    _height = other._height;
+    _maxTree = other._maxTree;
+    _maxLevel = other._maxLevel;
+    _pixelNode = other._pixelNode;
+    _nodeParent = other._nodeParent;
+    _nodeLevel = other._nodeLevel;
+}
+
+/*!
+ * \brief IPLComponentTree::build builds the tree of the first plane of image
+ * bits is 8 or 16. If parallel is set, strips of the image are built in
+ * parallel and merged, the result is the same tree.
+ */
+void IPLComponentTree::build(IPLImage* image, bool maxTree, int bits, bool parallel)
+{
+    _width = image->width();
+    _height = image->height();
+    _maxTree = maxTree;
+    _maxLevel = bits > 8 ? 65535 : 255;
+
+    int width = _width;
+    int height = _height;
+    size_t pixels = (size_t) width * height;
+
+    // quantized pixels, inverted for the min-tree
+    _level.resize(pixels);
+    float scale = (float) _maxLevel;
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* in = &image->plane(0)->p(0, y);
+        unsigned short* out = &_level[(size_t) y * width];
+        for(int x = 0; x < width; x++)
+        {
+            float v = std::min(1.0f, std::max(0.0f, in[x]));
+            if(!maxTree)
+                v = 1.0f - v;
+            out[x] = (unsigned short) (v * scale + 0.5f);
+        }
+    }
+
+    std::vector<int> parent(pixels);
+    std::vector<int> zpar(pixels);
+
+    // independent strips, merged in pairs along their borders
+    int strips = parallel ? std::min(64, std::max(1, height / 64)) : 1;
+    std::vector<int> start(strips + 1);
+    for(int s = 0; s <= strips; s++)
+        start[s] = (int) ((long long) height * s / strips);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int s = 0; s < strips; s++)
+        buildStrip(start[s], start[s+1], parent, zpar);
+
+    for(int step = 1; step < strips; step *= 2)
+    {
+        #pragma omp parallel for schedule(dynamic)
+        for(int s = 0; s < strips - step; s += 2*step)
+            mergeStrips(start[s + step], parent);
+    }
+
+    canonicalize(parent, zpar);
+
+    std::vector<unsigned short>().swap(_level);
+}
+
+/*!
+ * \brief IPLComponentTree::buildStrip builds the tree of rows y0..y1-1
+ * Pixels are visited in order of decreasing level, every pixel becomes the
+ * parent of the roots of its already visited neighbours. The root of the
+ * strip gets parent -1.
+ */
+void IPLComponentTree::buildStrip(int y0, int y1, std::vector<int>& parent, std::vector<int>& zpar)
+{
+    int width = _width;
+    int offset = y0 * width;
+    int count = (y1 - y0) * width;
+    const unsigned short* level = &_level[0];
+    int* par = &parent[0];
+    int* z = &zpar[0];
+
+    // counting sort by level
+    std::vector<int> histogram(_maxLevel + 2, 0);
+    for(int i = offset; i < offset + count; i++)
+        histogram[level[i] + 1]++;
+    for(int l = 0; l <= _maxLevel; l++)
+        histogram[l + 1] += histogram[l];
+
+    std::vector<int> sorted(count);
+    for(int i = offset; i < offset + count; i++)
+        sorted[histogram[level[i]]++] = i;
+
+    for(int i = offset; i < offset + count; i++)
+        z[i] = -1;
+
+    for(int k = count - 1; k >= 0; k--)
+    {
+        int p = sorted[k];
+        par[p] = -1;
+        z[p] = p;
+
+        int x = p % width;
+        int y = p / width;
+        int neighbours[4];
+        int n = 0;
+        if(x > 0)           neighbours[n++] = p - 1;
+        if(x < width-1)     neighbours[n++] = p + 1;
+        if(y > y0)          neighbours[n++] = p - width;
+        if(y < y1-1)        neighbours[n++] = p + width;
+
+        for(int j = 0; j < n; j++)
+        {
+            if(z[neighbours[j]] < 0)
+                continue;
+
+            int r = findRoot(z, neighbours[j]);
+            if(r != p)
+            {
+                par[r] = p;
+                z[r] = p;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLComponentTree::mergeStrips merges the trees above and below row y
+ * Every vertical pair of border pixels connects the two branches from the
+ * pixels down to the root, keeping the levels sorted along the branch.
+ */
+void IPLComponentTree::mergeStrips(int y, std::vector<int>& parent)
+{
+    int width = _width;
+    const unsigned short* level = &_level[0];
+    int* par = &parent[0];
+
+    for(int i = 0; i < width; i++)
+    {
+        int a = levelRoot(par, level, (y-1)*width + i);
+        int b = levelRoot(par, level, y*width + i);
+        if(level[b] > level[a])
+            std::swap(a, b);
+
+        // a is always at least as high as b
+        while(a != b && b >= 0)
+        {
+            int c = par[a] < 0 ? -1 : levelRoot(par, level, par[a]);
+            if(c >= 0 && level[c] >= level[b])
+            {
+                a = c;
+            }
+            else
+            {
+                par[a] = b;
+                a = b;
+                b = c;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLComponentTree::canonicalize converts the pixel tree to the sorted node tree
+ * Pixels of the same level and component are one node, represented by
+ * its canonical pixel. The nodes are sorted by level so parents come first.
+ */
+void IPLComponentTree::canonicalize(std::vector<int>& parent, std::vector<int>& canonical)
+{
+    int width = _width;
+    int height = _height;
+    size_t pixels = (size_t) width * height;
+    const unsigned short* level = &_level[0];
+    int* par = &parent[0];
+
+    // after compression every pixel points to its canonical pixel or a lower level
+    for(size_t p = 0; p < pixels; p++)
+        levelRoot(par, level, (int) p);
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int p = y*width; p < (y+1)*width; p++)
+        {
+            int q = par[p];
+            canonical[p] = (q >= 0 && level[q] == level[p]) ? q : p;
+        }
+    }
+
+    // nodes sorted by level
+    std::vector<int> histogram(_maxLevel + 2, 0);
+    for(size_t p = 0; p < pixels; p++)
+        if(canonical[p] == (int) p)
+            histogram[level[p] + 1]++;
+    for(int l = 0; l <= _maxLevel; l++)
+        histogram[l + 1] += histogram[l];
+
+    int nodes = histogram[_maxLevel + 1];
+    std::vector<int> nodePixel(nodes);
+    _pixelNode.resize(pixels);
+    _nodeParent.resize(nodes);
+    _nodeLevel.resize(nodes);
+    for(size_t p = 0; p < pixels; p++)
+    {
+        if(canonical[p] == (int) p)
+        {
+            int node = histogram[level[p]]++;
+            nodePixel[node] = (int) p;
+            _nodeLevel[node] = level[p];
+            _pixelNode[p] = node;
+        }
+    }
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int p = y*width; p < (y+1)*width; p++)
+            if(canonical[p] != p)
+                _pixelNode[p] = _pixelNode[canonical[p]];
+    }
+
+    #pragma omp parallel for
+    for(int node = 0; node < nodes; node++)
+    {
+        int q = par[nodePixel[node]];
+        _nodeParent[node] = q < 0 ? -1 : _pixelNode[canonical[q]];
+    }
+}
+
+/*!
+ * \brief IPLComponentTree::attribute computes an attribute of every node
+ * Area and bounding box size are in pixels, the bounding box size is the
+ * larger side. Contrast is the difference between the highest level in
+ * the subtree and the level of the node, 0..1.
+ */
+void IPLComponentTree::attribute(int attribute, std::vector<double>& values)
+{
+    int width = _width;
+    int height = _height;
+    int nodes = this->nodes();
+    const int* parent = &_nodeParent[0];
+
+    values.assign(nodes, 0.0);
+
+    if(attribute == AREA)
+    {
+        for(size_t p = 0; p < _pixelNode.size(); p++)
+            values[_pixelNode[p]] += 1.0;
+        for(int node = nodes-1; node > 0; node--)
+            if(parent[node] >= 0)
+                values[parent[node]] += values[node];
+    }
+    else if(attribute == BOUNDING_BOX)
+    {
+        std::vector<int> minX(nodes, width), maxX(nodes, -1);
+        std::vector<int> minY(nodes, height), maxY(nodes, -1);
+        for(int y = 0; y < height; y++)
+        {
+            const int* node = pixelNodes(y);
+            for(int x = 0; x < width; x++)
+            {
+                int n = node[x];
+                minX[n] = std::min(minX[n], x);
+                maxX[n] = std::max(maxX[n], x);
+                minY[n] = std::min(minY[n], y);
+                maxY[n] = std::max(maxY[n], y);
+            }
+        }
+        for(int node = nodes-1; node > 0; node--)
+        {
+            int p = parent[node];
+            if(p < 0)
+                continue;
+            minX[p] = std::min(minX[p], minX[node]);
+            maxX[p] = std::max(maxX[p], maxX[node]);
+            minY[p] = std::min(minY[p], minY[node]);
+            maxY[p] = std::max(maxY[p], maxY[node]);
+        }
+        for(int node = 0; node < nodes; node++)
+            values[node] = std::max(maxX[node] - minX[node], maxY[node] - minY[node]) + 1;
+    }
+    else if(attribute == CONTRAST)
+    {
+        for(int node = 0; node < nodes; node++)
+            values[node] = _nodeLevel[node];
+        for(int node = nodes-1; node > 0; node--)
+            if(parent[node] >= 0)
+                values[parent[node]] = std::max(values[parent[node]], values[node]);
+        for(int node = 0; node < nodes; node++)
+            values[node] = (values[node] - _nodeLevel[node]) / _maxLevel;
+    }
+}
+
+/*!
+ * \brief IPLComponentTree::filter removes the nodes with values below threshold
+ * Removed nodes get the level of their nearest remaining ancestor, the
+ * root is always kept.
+ */
+void IPLComponentTree::filter(const std::vector<double>& values, double threshold, IPLImage* result)
+{
+    int nodes = this->nodes();
+    std::vector<int> levels(nodes);
+    for(int node = 0; node < nodes; node++)
+    {
+        int p = _nodeParent[node];
+        levels[node] = (p < 0 || values[node] >= threshold) ? _nodeLevel[node] : levels[p];
+    }
+    reconstruct(levels, result);
+}
+
+/*!
+ * \brief IPLComponentTree::reconstruct writes the given level of every node to its pixels
+ */
+void IPLComponentTree::reconstruct(const std::vector<int>& nodeLevels, IPLImage* result)
+{
+    int width = _width;
+    int height = _height;
+    bool maxTree = _maxTree;
+    float scale = 1.0f / _maxLevel;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const int* node = pixelNodes(y);
+        float* out = &result->plane(0)->p(0, y);
+        for(int x = 0; x < width; x++)
+        {
+            float v = nodeLevels[node[x]] * scale;
+            out[x] = maxTree ? v : 1.0f - v;
+        }
+    }
+}
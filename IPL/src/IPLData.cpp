@@ -24,6 +24,9 @@
 #include "IPLPoint.h"
 #include "IPLMatrix.h"
 #include "IPLKeyPoints.h"
+#include "IPLPyramid.h"
+#include "IPLIntegralImage.h"
+#include "IPLComponentTree.h"
 
 
 bool IPLData::isConvertibleTo(IPLDataType dataType)
@@ -40,6 +43,12 @@ bool IPLData::isConvertibleTo(IPLDataType dataType)
         return toPoint() != NULL;
     case IPL_MATRIX:
         return toMatrix() != NULL;
+    case IPL_PYRAMID:
+        return toPyramid() != NULL;
+    case IPL_INTEGRAL_IMAGE:
+        return toIntegralImage() != NULL;
+    case IPL_COMPONENT_TREE:
+        return toComponentTree() != NULL;
     case IPL_IMAGE_ORIENTED:
     case IPL_SHAPES:
     case IPL_UNDEFINED:
@@ -74,3 +83,18 @@ IPLKeyPoints* IPLData::toKeyPoints()
 {
     return dynamic_cast<IPLKeyPoints*>(this);
 }
+
+IPLPyramid* IPLData::toPyramid()
+{
+    return dynamic_cast<IPLPyramid*>(this);
+}
+
+IPLIntegralImage* IPLData::toIntegralImage()
+{
+    return dynamic_cast<IPLIntegralImage*>(this);
+}
+
+IPLComponentTree* IPLData::toComponentTree()
+{
+    return dynamic_cast<IPLComponentTree*>(this);
+}
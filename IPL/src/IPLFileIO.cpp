@@ -21,6 +21,8 @@
 
 #include "FreeImage.h"
 
+#include <algorithm>
+
 std::string IPLFileIO::_baseDir = "";
 
 /*!
@@ -326,6 +328,27 @@ bool IPLFileIO::readRaw8bit(int stride, IPLImage *&image, std::ifstream &file)
     return true;
 }
 
+/*!
+ * \brief IPLFileIO::readRaw16bit reads little endian 16 bit pixels, e.g. sensor dumps
+ * bits is the number of used bits, the values are scaled to 0..1 by 2^bits-1.
+ * Whole rows are read at once.
+ */
+bool IPLFileIO::readRaw16bit(int stride, int bits, IPLImage *&image, std::ifstream &file)
+{
+    float scale = 1.0f / ((1 << std::min(16, std::max(1, bits))) - 1);
+    std::vector<unsigned char> buffer(2 * stride);
+    for(int y = 0; y < image->height() && file.good(); y++)
+    {
+        file.read((char*) &buffer[0], buffer.size());
+        int count = (int) file.gcount() / 2;
+
+        float* row = &image->plane(0)->p(0, y);
+        for(int x = 0; x < count; x++)
+            row[x] = std::min(1.0f, (buffer[2*x] | (buffer[2*x + 1] << 8)) * scale);
+    }
+    return true;
+}
+
 bool IPLFileIO::readRaw24BitInterleaved(int stride, IPLRawImageType format, IPLImage *&image, std::ifstream &file)
 {
     char buffer[3];
@@ -511,7 +534,7 @@ bool IPLFileIO::readRaw32BitPlanar(int stride, IPLRawImageType format, IPLImage
  * \param information
  * \return
  */
-bool IPLFileIO::loadRawFile(std::string filename, IPLImage *&image, int width, int height, IPLRawImageType format, bool interleaved, std::string &information)
+bool IPLFileIO::loadRawFile(std::string filename, IPLImage *&image, int width, int height, IPLRawImageType format, bool interleaved, std::string &information, int bits)
 {
     std::string filePath;
 
@@ -537,7 +560,7 @@ bool IPLFileIO::loadRawFile(std::string filename, IPLImage *&image, int width, i
     // clear old image
     delete image;
     // create IPLImage
-    if(format == IPL_RAW_8BIT)
+    if(format == IPL_RAW_8BIT || format == IPL_RAW_16BIT)
         image = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
     else
         image = new IPLImage(IPL_IMAGE_COLOR, width, height);
@@ -567,6 +590,11 @@ bool IPLFileIO::loadRawFile(std::string filename, IPLImage *&image, int width, i
             return readRaw32BitPlanar(width, format, image, file);
         break;
     }
+    case IPL_RAW_16BIT: // 16 bit (Grayscale)
+    {
+        return readRaw16bit(width, bits, image, file);
+        break;
+    }
     default:
         break;
     }
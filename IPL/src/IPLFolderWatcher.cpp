@@ -0,0 +1,332 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLFolderWatcher.h"
+#include "IPLFileIO.h"
+
+#include <cstdio>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#if defined(__linux__)
+    #include <sys/inotify.h>
+    #include <sys/stat.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <errno.h>
+#endif
+
+IPLFolderWatcher::IPLFolderWatcher()
+{
+    _action     = ACTION_KEEP;
+    _queueSize  = 1;
+    _inotify    = -1;
+    _wakeup[0]  = -1;
+    _wakeup[1]  = -1;
+    _stop       = false;
+    _received   = 0;
+    _failed     = 0;
+}
+
+IPLFolderWatcher::~IPLFolderWatcher()
+{
+    stop();
+}
+
+/*!
+ * \brief IPLFolderWatcher::start starts watching, files already in the folder are ignored
+ * \param folder
+ * \param queueSize maximum number of decoded images waiting to be taken
+ * \param action what happens to a file after it was decoded
+ * \param moveFolder target of ACTION_MOVE, defaults to folder/processed
+ * \param error
+ * \return
+ */
+bool IPLFolderWatcher::start(const std::string& folder, int queueSize, Action action,
+                             const std::string& moveFolder, std::string& error)
+{
+    stop();
+
+    _folder     = folder;
+    _moveFolder = moveFolder.empty() ? folder + "/processed" : moveFolder;
+    _action     = action;
+    _queueSize  = std::max(1, queueSize);
+    _stop       = false;
+    _received   = 0;
+    _failed     = 0;
+    _seen.clear();
+    _seenOrder.clear();
+    _lastError.clear();
+
+#if defined(__linux__)
+    if(_action == ACTION_MOVE)
+        mkdir(_moveFolder.c_str(), 0777);
+
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(_inotify < 0)
+    {
+        error = "inotify is not available.";
+        return false;
+    }
+
+    // a file is complete when its writer closes it, or when it is renamed into the folder
+    if(inotify_add_watch(_inotify, _folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR) < 0)
+    {
+        error = "Folder can not be watched: " + _folder;
+        close(_inotify);
+        _inotify = -1;
+        return false;
+    }
+
+    // the pipe wakes the thread up for stop()
+    if(pipe(_wakeup) < 0)
+    {
+        error = "Pipe can not be created.";
+        close(_inotify);
+        _inotify = -1;
+        return false;
+    }
+
+    _thread = std::thread(&IPLFolderWatcher::run, this);
+    return true;
+#else
+    error = "Watching folders is only supported on Linux.";
+    return false;
+#endif
+}
+
+void IPLFolderWatcher::stop()
+{
+    if(!_thread.joinable())
+        return;
+
+    _stop = true;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _notFull.notify_all();
+        _notEmpty.notify_all();
+    }
+
+#if defined(__linux__)
+    char wake = 0;
+    ssize_t written = write(_wakeup[1], &wake, 1);
+    (void) written;
+#endif
+
+    _thread.join();
+
+#if defined(__linux__)
+    close(_inotify);
+    close(_wakeup[0]);
+    close(_wakeup[1]);
+#endif
+    _inotify = -1;
+    _wakeup[0] = -1;
+    _wakeup[1] = -1;
+
+    for(size_t i = 0; i < _queue.size(); i++)
+        delete _queue[i].image;
+    _queue.clear();
+}
+
+/*!
+ * \brief IPLFolderWatcher::waitForImage blocks until an image is queued
+ * \param timeoutMs
+ * \return true if an image can be taken
+ */
+bool IPLFolderWatcher::waitForImage(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _notEmpty.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return _stop || !_queue.empty(); });
+    return !_queue.empty();
+}
+
+/*!
+ * \brief IPLFolderWatcher::takeImage removes the oldest image from the queue
+ * \param fileName name of the file the image was decoded from
+ * \param timeoutMs how long to wait if the queue is empty
+ * \return the image, owned by the caller, or NULL
+ */
+IPLImage* IPLFolderWatcher::takeImage(std::string& fileName, int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _notEmpty.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return _stop || !_queue.empty(); });
+    if(_queue.empty())
+        return NULL;
+
+    Entry entry = _queue.front();
+    _queue.pop_front();
+    _notFull.notify_one();
+
+    fileName = entry.fileName;
+    return entry.image;
+}
+
+int IPLFolderWatcher::queued()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int) _queue.size();
+}
+
+/*!
+ * \brief IPLFolderWatcher::takeError returns the last error once
+ * \return error message or an empty string if nothing failed since the last call
+ */
+std::string IPLFolderWatcher::takeError()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string error;
+    error.swap(_lastError);
+    return error;
+}
+
+void IPLFolderWatcher::setError(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lastError = error;
+}
+
+/*!
+ * \brief IPLFolderWatcher::setFailed reports a file which could not be handled
+ */
+void IPLFolderWatcher::setFailed(const std::string& error)
+{
+    setError(error);
+    _failed++;
+}
+
+/*!
+ * \brief IPLFolderWatcher::firstSeen remembers the name, the oldest one is forgotten beyond MAX_SEEN_FILES
+ * \return false if the name was already reported
+ */
+bool IPLFolderWatcher::firstSeen(const std::string& name)
+{
+    if(!_seen.insert(name).second)
+        return false;
+
+    _seenOrder.push_back(name);
+    if(_seenOrder.size() > MAX_SEEN_FILES)
+    {
+        _seen.erase(_seenOrder.front());
+        _seenOrder.pop_front();
+    }
+    return true;
+}
+
+void IPLFolderWatcher::run()
+{
+#if defined(__linux__)
+    // inotify_event needs aligned storage
+    std::vector<long> storage(64 * 1024 / sizeof(long));
+    char* buffer = (char*) &storage[0];
+    size_t bufferSize = storage.size() * sizeof(long);
+
+    while(!_stop)
+    {
+        pollfd fds[2];
+        fds[0].fd = _inotify;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = _wakeup[0];
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+
+        if(poll(fds, 2, -1) < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            setError("Waiting for inotify events failed.");
+            return;
+        }
+
+        if(fds[1].revents)
+            return;
+
+        ssize_t length = read(_inotify, buffer, bufferSize);
+        if(length <= 0)
+            continue;
+
+        for(char* p = buffer; p < buffer + length && !_stop; )
+        {
+            const inotify_event* event = (const inotify_event*) p;
+            p += sizeof(inotify_event) + event->len;
+
+            if(event->mask & IN_Q_OVERFLOW)
+                setError("Too many new files, some of them were skipped.");
+
+            if((event->mask & IN_ISDIR) || event->len == 0)
+                continue;
+
+            // hidden files are temporaries of tools like rsync
+            std::string name(event->name);
+            if(name.empty() || name[0] == '.')
+                continue;
+
+            // a kept file may be closed several times, report it once
+            if(_action == ACTION_KEEP && !firstSeen(name))
+                continue;
+
+            handleFile(name);
+        }
+    }
+#endif
+}
+
+void IPLFolderWatcher::handleFile(const std::string& name)
+{
+    std::string path = _folder + "/" + name;
+
+    IPLImage* image = NULL;
+    std::string information;
+    if(!IPLFileIO::loadFile(path, image, information) || !image)
+    {
+        delete image;
+        setFailed("File could not be loaded: " + name);
+        return;
+    }
+
+    if(_action == ACTION_DELETE)
+    {
+        if(std::remove(path.c_str()) != 0)
+            setFailed("File could not be deleted: " + name);
+    }
+    else if(_action == ACTION_MOVE)
+    {
+        std::string target = _moveFolder + "/" + name;
+        if(std::rename(path.c_str(), target.c_str()) != 0)
+            setFailed("File could not be moved: " + name);
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _notFull.wait(lock, [this] { return _stop || _queue.size() < _queueSize; });
+    if(_stop)
+    {
+        delete image;
+        return;
+    }
+
+    Entry entry;
+    entry.image = image;
+    entry.fileName = name;
+    _queue.push_back(entry);
+    _received++;
+    _notEmpty.notify_one();
+}
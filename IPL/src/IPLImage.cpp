@@ -19,6 +19,8 @@
 
 #include "IPLImage.h"
 
+#include <algorithm>
+
 int IPLImage::_instanceCount = 0;
 
 IPLImage::IPLImage() : IPLData(IPL_UNDEFINED)
@@ -37,7 +39,8 @@ IPLImage::IPLImage(const IPLImage& other):
     _width = other._width;
     _height = other._height;
 
-    if( _type == IPL_IMAGE_COLOR ) _nrOfPlanes = 3; else _nrOfPlanes = 1;
+    // oriented images have 2 planes
+    _nrOfPlanes = other._nrOfPlanes;
     for( int i=0; i<_nrOfPlanes; i++ )
         _planes.push_back(new IPLImagePlane( *(other._planes[i]) ));
 
@@ -53,7 +56,44 @@ IPLImage::IPLImage( IPLDataType t, int width, int height )
     if( _type == IPL_IMAGE_COLOR ) _nrOfPlanes = 3; else _nrOfPlanes = 1;
     for( int i=0; i<_nrOfPlanes; i++ )
         _planes.push_back(new IPLImagePlane( width, height ));
-    fillColor( 0 );
+
+    // new planes are already initialized to 0
+
+    _instanceCount++;
+}
+
+/*!
+ * \brief IPLImage::IPLImage creates an image which shares the pixels of planes
+ * If there are less planes than the type needs, the last plane is used for
+ * the missing ones. A plane whose pixels are already used by an earlier plane
+ * of this image is copied, so planes of one image never share their pixels.
+ * All planes must have the same size.
+ */
+IPLImage::IPLImage( IPLDataType t, const std::vector<IPLImagePlane*>& planes )
+{
+    _type = t;
+    _width = planes.empty() ? 0 : planes[0]->width();
+    _height = planes.empty() ? 0 : planes[0]->height();
+
+    if( _type == IPL_IMAGE_COLOR ) _nrOfPlanes = 3; else _nrOfPlanes = 1;
+    for( int i=0; i<_nrOfPlanes; i++ )
+    {
+        if( planes.empty() )
+        {
+            _planes.push_back(new IPLImagePlane());
+            continue;
+        }
+
+        IPLImagePlane* plane = planes[std::min(i, (int) planes.size()-1)];
+        bool used = false;
+        for( int j=0; j<i; j++ )
+            used = used || plane->sharesPixelsWith(_planes[j]);
+
+        if( used )
+            _planes.push_back(new IPLImagePlane(*plane));
+        else
+            _planes.push_back(plane->share());
+    }
 
     _instanceCount++;
 }
@@ -162,8 +202,8 @@ void IPLImage::fillColor(ipl_basetype value)
     for( int planeNr = 0; planeNr < _nrOfPlanes; planeNr++ )
     {
         IPLImagePlane* plane = _planes[planeNr];
-        for( int x=0; x<_width; x++ )
-            for( int y=0; y<_height; y++ )
+        for( int y=0; y<_height; y++ )
+            for( int x=0; x<_width; x++ )
                 plane->p(x,y) = value;
     }
 }
@@ -41,6 +41,22 @@ IPLImagePlane::IPLImagePlane( int w, int h )
     _instanceCount++;
 }
 
+/*!
+ * \brief IPLImagePlane::IPLImagePlane wraps existing pixels without copying them
+ * \param w
+ * \param h
+ * \param pixels w*h values, the deleter of the shared pointer releases them
+ */
+IPLImagePlane::IPLImagePlane( int w, int h, std::shared_ptr<ipl_basetype> pixels )
+{
+    _height = h;
+    _width = w;
+    _buffer = pixels;
+    _plane = _buffer.get();
+
+    _instanceCount++;
+}
+
 IPLImagePlane::IPLImagePlane( const IPLImagePlane& other )
 {
     if( this != &other )
@@ -59,7 +75,8 @@ IPLImagePlane::IPLImagePlane( const IPLImagePlane& other )
 IPLImagePlane::IPLImagePlane(IPLImagePlane &&other):
     _height(other._height),
     _width(other._width),
-    _plane(other._plane)
+    _plane(other._plane),
+    _buffer(std::move(other._buffer))
 {
     other._height = 0;
     other._width = 0;
@@ -76,6 +93,9 @@ IPLImagePlane::~IPLImagePlane( void )
 
 IPLImagePlane &IPLImagePlane::operator=(const IPLImagePlane &other)
 {
+    if( this == &other )
+        return *this;
+
     _height = other._height;
     _width = other._width;
     newPlane();
@@ -91,6 +111,7 @@ IPLImagePlane &IPLImagePlane::operator=(IPLImagePlane &&other)
     _height = other._height;
     _width = other._width;
     _plane = other._plane;
+    _buffer = std::move(other._buffer);
 
     other._height = 0;
     other._width = 0;
@@ -108,13 +129,38 @@ void IPLImagePlane::swap(IPLImagePlane &other)
     (*this) = std::move(tmp);
 }
 
+/*!
+ * \brief IPLImagePlane::share creates a plane which references the same pixels
+ * \return new plane, owned by the caller
+ */
+IPLImagePlane* IPLImagePlane::share( void )
+{
+    IPLImagePlane* plane = new IPLImagePlane();
+    plane->_height = _height;
+    plane->_width = _width;
+    plane->_plane = _plane;
+    plane->_buffer = _buffer;
+    return plane;
+}
+
+/*!
+ * \brief IPLImagePlane::sharesPixelsWith
+ * \return true if both planes reference the same pixels
+ */
+bool IPLImagePlane::sharesPixelsWith( const IPLImagePlane* other ) const
+{
+    return _plane != NULL && _plane == other->_plane;
+}
+
 void IPLImagePlane::newPlane( void )
 {
     // automatically init to 0
-    _plane = new ipl_basetype[_height * _width]();
+    _buffer.reset(new ipl_basetype[_height * _width](), std::default_delete<ipl_basetype[]>());
+    _plane = _buffer.get();
 }
 
 void IPLImagePlane::deletePlane( void )
 {
-    delete [] _plane;
+    _buffer.reset();
+    _plane = NULL;
 }
@@ -0,0 +1,129 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLIntegralImage.h"
+
+#include <algorithm>
+
+IPLIntegralImage::IPLIntegralImage() : IPLData(IPL_INTEGRAL_IMAGE)
+{
+    _width = 0;
+    _height = 0;
+    _sourceType = IPL_IMAGE_GRAYSCALE;
+}
+
+IPLIntegralImage::IPLIntegralImage(const IPLIntegralImage &other) : IPLData(IPL_INTEGRAL_IMAGE)
+{
+    _width = other._width;
+    _height = other._height;
+    _sourceType = other._sourceType;
+    _sum = other._sum;
+    _squaredSum = other._squaredSum;
+}
+
+/*!
+ * \brief IPLIntegralImage::compute builds the tables of all planes of image
+ * The existing tables are reused if the size does not change.
+ */
+void IPLIntegralImage::compute(IPLImage* image, bool squaredSum)
+{
+    _width = image->width();
+    _height = image->height();
+    _sourceType = image->type();
+
+    int planes = image->getNumberOfPlanes();
+    size_t size = (size_t) (_width+1) * (_height+1);
+
+    _sum.resize(planes);
+    _squaredSum.resize(squaredSum ? planes : 0);
+
+    for(int p = 0; p < planes; p++)
+    {
+        _sum[p].resize(size);
+        scan(image->plane(p), _sum[p], false);
+
+        if(squaredSum)
+        {
+            _squaredSum[p].resize(size);
+            scan(image->plane(p), _squaredSum[p], true);
+        }
+    }
+}
+
+/*!
+ * \brief IPLIntegralImage::scan computes one table with a two-pass prefix scan
+ * The first pass computes the prefix sum of every row, the rows are
+ * independent and run in parallel. The second pass adds every row to the
+ * next one; it runs in parallel over strips of columns so every thread
+ * works on contiguous memory.
+ */
+void IPLIntegralImage::scan(IPLImagePlane* plane, std::vector<double>& table, bool squared)
+{
+    int width = _width;
+    int height = _height;
+    size_t stride = width + 1;
+    double* data = &table[0];
+
+    // first row and column are 0
+    std::fill(data, data + stride, 0.0);
+
+    // horizontal prefix sums
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* in = &plane->p(0, y);
+        double* row = data + (y+1) * stride;
+        double sum = 0.0;
+        row[0] = 0.0;
+        if(squared)
+        {
+            for(int x = 0; x < width; x++)
+            {
+                sum += (double) in[x] * in[x];
+                row[x+1] = sum;
+            }
+        }
+        else
+        {
+            for(int x = 0; x < width; x++)
+            {
+                sum += in[x];
+                row[x+1] = sum;
+            }
+        }
+    }
+
+    // vertical prefix sums
+    const int strip = 256;
+    int strips = ((int) stride + strip - 1) / strip;
+
+    #pragma omp parallel for
+    for(int s = 0; s < strips; s++)
+    {
+        int x0 = s * strip;
+        int x1 = std::min(x0 + strip, (int) stride);
+        for(int y = 2; y <= height; y++)
+        {
+            const double* above = data + (y-1) * stride;
+            double* row = data + y * stride;
+            for(int x = x0; x < x1; x++)
+                row[x] += above[x];
+        }
+    }
+}
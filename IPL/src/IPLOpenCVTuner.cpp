@@ -0,0 +1,401 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLOpenCVTuner.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+IPLOpenCVTuner::IPLOpenCVTuner()
+{
+    _samples            = 3;
+    _tolerance          = 0.02;
+    _defaultUseOpenCV   = true;
+}
+
+/*!
+ * \brief IPLOpenCVTuner::process executes the process with the best known implementation
+ * While a process, size and parameter set is still being measured, both
+ * implementations are executed. The result of the preferred implementation
+ * is left in the process.
+ * \return result of IPLProcess::processInputData
+ */
+bool IPLOpenCVTuner::process(IPLProcess* process, IPLData* data, int inputIndex)
+{
+    if(!tunable(process) || !data)
+        return process->processInputData(data, inputIndex, useOpenCV(process, data));
+
+    std::string entryKey = key(process, data);
+
+    Entry entry;
+    bool known = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(entryKey);
+        if(it != _entries.end())
+        {
+            entry = it->second;
+            known = true;
+        }
+    }
+
+    if(known && decided(entry))
+        return process->processInputData(data, inputIndex, prefersOpenCV(entry));
+
+    Measurement measurement;
+    if(!measure(process, data, inputIndex, measurement))
+    {
+        // one of the implementations failed, don't measure again and stay native
+        recordFailure(entryKey);
+        process->resetMessages();
+        return process->processInputData(data, inputIndex, false);
+    }
+
+    record(entryKey, measurement);
+
+    bool preferOpenCV = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entry = _entries[entryKey];
+        preferOpenCV = decided(entry) && prefersOpenCV(entry);
+    }
+
+    // measure() finishes with the native implementation
+    if(preferOpenCV)
+    {
+        process->resetMessages();
+        return process->processInputData(data, inputIndex, true);
+    }
+    return true;
+}
+
+/*!
+ * \brief IPLOpenCVTuner::useOpenCV returns the decision without measuring
+ * Falls back to defaultUseOpenCV() as long as there are not enough samples.
+ */
+bool IPLOpenCVTuner::useOpenCV(IPLProcess* process, IPLData* data)
+{
+    if(process->openCVSupport() == IPLProcess::OPENCV_ONLY)
+        return true;
+    if(process->openCVSupport() == IPLProcess::OPENCV_NONE)
+        return false;
+    if(!tunable(process) || !data)
+        return _defaultUseOpenCV;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(key(process, data));
+    if(it == _entries.end() || !decided(it->second))
+        return _defaultUseOpenCV;
+
+    return prefersOpenCV(it->second);
+}
+
+/*!
+ * \brief IPLOpenCVTuner::measure executes both implementations once
+ * The OpenCV implementation runs first, the native result is left in the process.
+ * The first output is compared if both implementations produce an image.
+ * \return false if one of the implementations failed
+ */
+bool IPLOpenCVTuner::measure(IPLProcess* process, IPLData* data, int inputIndex, Measurement& measurement)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    measurement.nativeUs    = 0;
+    measurement.opencvUs    = 0;
+    measurement.meanError   = 0;
+    measurement.maxError    = 0;
+    measurement.compared    = false;
+
+    process->resetMessages();
+    Clock::time_point start = Clock::now();
+    if(!process->processInputData(data, inputIndex, true))
+        return false;
+    measurement.opencvUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    IPLImage* reference = NULL;
+    IPLData* result = process->getResultData(0);
+    if(result && result->toImage())
+        reference = new IPLImage(*result->toImage());
+
+    process->resetMessages();
+    start = Clock::now();
+    bool success = process->processInputData(data, inputIndex, false);
+    measurement.nativeUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    result = process->getResultData(0);
+    if(success && reference && result && result->toImage())
+        measurement.compared = compare(reference, result->toImage(), measurement.meanError, measurement.maxError);
+
+    delete reference;
+    return success;
+}
+
+/*!
+ * \brief IPLOpenCVTuner::record adds a measurement, e.g. from a benchmark run
+ */
+void IPLOpenCVTuner::record(const std::string& key, const Measurement& measurement)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(key);
+    if(it == _entries.end())
+    {
+        Entry entry;
+        entry.nativeUs      = measurement.nativeUs;
+        entry.opencvUs      = measurement.opencvUs;
+        entry.nativeSamples = 1;
+        entry.opencvSamples = 1;
+        entry.meanError     = measurement.meanError;
+        entry.maxError      = measurement.maxError;
+        entry.compared      = measurement.compared;
+        _entries[key] = entry;
+        return;
+    }
+
+    // the fastest run is the least disturbed one
+    Entry& entry = it->second;
+    entry.nativeUs      = std::min(entry.nativeUs, measurement.nativeUs);
+    entry.opencvUs      = std::min(entry.opencvUs, measurement.opencvUs);
+    entry.nativeSamples++;
+    entry.opencvSamples++;
+    entry.meanError     = std::max(entry.meanError, measurement.meanError);
+    entry.maxError      = std::max(entry.maxError, measurement.maxError);
+    entry.compared      = entry.compared && measurement.compared;
+}
+
+/*!
+ * \brief IPLOpenCVTuner::recordFailure decides for the native implementation
+ * Used if one implementation failed, the outputs can not be compared then.
+ */
+void IPLOpenCVTuner::recordFailure(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Entry entry;
+    entry.nativeUs      = 0;
+    entry.opencvUs      = 0;
+    entry.nativeSamples = _samples;
+    entry.opencvSamples = _samples;
+    entry.meanError     = 0;
+    entry.maxError      = 0;
+    entry.compared      = false;
+    _entries[key] = entry;
+}
+
+bool IPLOpenCVTuner::decided(const Entry& entry)
+{
+    return entry.nativeSamples >= _samples && entry.opencvSamples >= _samples;
+}
+
+bool IPLOpenCVTuner::prefersOpenCV(const Entry& entry)
+{
+    // diverging or unverified outputs: stay with the native reference implementation
+    if(!entry.compared || entry.meanError > _tolerance)
+        return false;
+
+    return entry.opencvUs < entry.nativeUs;
+}
+
+void IPLOpenCVTuner::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
+
+/*!
+ * \brief IPLOpenCVTuner::load reads measurements written by save()
+ * Existing measurements with the same key are replaced.
+ */
+bool IPLOpenCVTuner::load(const std::string& path)
+{
+    std::ifstream file(path.c_str());
+    if(!file.is_open())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+
+        // className, bucket, planes, parameters, values
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while(std::getline(stream, field, '\t'))
+            fields.push_back(field);
+
+        // files without the compared column were written by older versions
+        if(fields.size() != 10 && fields.size() != 11)
+            continue;
+
+        std::string entryKey = fields[0] + "\t" + fields[1] + "\t" + fields[2] + "\t" + fields[3];
+
+        Entry entry;
+        try
+        {
+            entry.nativeUs      = std::stod(fields[4]);
+            entry.opencvUs      = std::stod(fields[5]);
+            entry.nativeSamples = std::stoi(fields[6]);
+            entry.opencvSamples = std::stoi(fields[7]);
+            entry.meanError     = std::stod(fields[8]);
+            entry.maxError      = std::stod(fields[9]);
+            entry.compared      = fields.size() < 11 || std::stoi(fields[10]) != 0;
+        }
+        catch(std::exception&)
+        {
+            continue;
+        }
+        _entries[entryKey] = entry;
+    }
+    return true;
+}
+
+bool IPLOpenCVTuner::save(const std::string& path)
+{
+    std::ofstream file(path.c_str());
+    if(!file.is_open())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    file << "# class\tbucket\tplanes\tparameters\tnativeUs\topencvUs\tnativeSamples\topencvSamples\tmeanError\tmaxError\tcompared\n";
+    for(auto it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        const Entry& entry = it->second;
+        file << it->first << "\t"
+             << entry.nativeUs << "\t" << entry.opencvUs << "\t"
+             << entry.nativeSamples << "\t" << entry.opencvSamples << "\t"
+             << entry.meanError << "\t" << entry.maxError << "\t" << (entry.compared ? 1 : 0) << "\n";
+    }
+    return file.good();
+}
+
+/*!
+ * \brief IPLOpenCVTuner::key identifies process, size bucket and parameters
+ * The size bucket grows with factor 4 in pixels, i.e. doubles the side length.
+ */
+std::string IPLOpenCVTuner::key(IPLProcess* process, IPLData* data)
+{
+    IPLImage* image = data->toImage();
+
+    int bucket = 0;
+    int planes = 0;
+    if(image)
+    {
+        long pixels = (long) image->width() * image->height();
+        while(pixels >= 4)
+        {
+            pixels /= 4;
+            bucket++;
+        }
+        planes = image->getNumberOfPlanes();
+    }
+
+    std::stringstream parameters;
+    IPLProcessPropertyMap* properties = process->properties();
+    for(auto it = properties->begin(); it != properties->end(); ++it)
+    {
+        IPLProcessWidgetType widget = it->second->widget();
+        if(widget == IPL_WIDGET_FILE_OPEN || widget == IPL_WIDGET_FILE_SAVE || widget == IPL_WIDGET_FOLDER
+                || widget == IPL_WIDGET_LABEL || widget == IPL_WIDGET_TITLE
+                || widget == IPL_WIDGET_BUTTON || widget == IPL_WIDGET_GROUP)
+            continue;
+
+        std::string value = it->second->serialize().value;
+        for(char& c : value)
+        {
+            if(c == '\t' || c == '\n' || c == '\r')
+                c = ' ';
+        }
+        parameters << it->first << "=" << value << ";";
+    }
+
+    std::stringstream entryKey;
+    entryKey << process->className() << "\t" << bucket << "\t" << planes << "\t" << parameters.str();
+    return entryKey.str();
+}
+
+/*!
+ * \brief IPLOpenCVTuner::compare computes the mean and max absolute difference of two images
+ * \return false if the images have a different size or number of planes
+ */
+bool IPLOpenCVTuner::compare(IPLImage* a, IPLImage* b, double& meanError, double& maxError)
+{
+    meanError = 0;
+    maxError  = 0;
+
+    if(a->width() != b->width() || a->height() != b->height()
+            || a->getNumberOfPlanes() != b->getNumberOfPlanes())
+        return false;
+
+    int width  = a->width();
+    int height = a->height();
+    double sum = 0;
+    double max = 0;
+
+    for(int planeNr = 0; planeNr < a->getNumberOfPlanes(); planeNr++)
+    {
+        IPLImagePlane* planeA = a->plane(planeNr);
+        IPLImagePlane* planeB = b->plane(planeNr);
+
+        // max reductions need OpenMP 3.1, MSVC only has 2.0
+        #pragma omp parallel
+        {
+            double threadSum = 0;
+            double threadMax = 0;
+
+            #pragma omp for
+            for(int y = 0; y < height; y++)
+            {
+                for(int x = 0; x < width; x++)
+                {
+                    double error = std::fabs((double) planeA->p(x, y) - (double) planeB->p(x, y));
+                    threadSum += error;
+                    threadMax = (error > threadMax) ? error : threadMax;
+                }
+            }
+
+            #pragma omp critical
+            {
+                sum += threadSum;
+                max = (threadMax > max) ? threadMax : max;
+            }
+        }
+    }
+
+    long count = (long) width * height * a->getNumberOfPlanes();
+    meanError = count > 0 ? sum / count : 0;
+    maxError  = max;
+    return true;
+}
+
+bool IPLOpenCVTuner::tunable(IPLProcess* process)
+{
+    // sources and sequences can not be executed twice without side effects
+    return process->openCVSupport() == IPLProcess::OPENCV_OPTIONAL
+            && !process->isSource()
+            && !process->isSequence();
+}
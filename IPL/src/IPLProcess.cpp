@@ -81,6 +81,44 @@ IPLProcess::~IPLProcess( void )
 
 }
 
+/*!
+ * \brief IPLProcess::processInputDataBatch processes several frames with the same properties
+ * The default implementation calls processInputData once per frame and copies
+ * the result. Processes with an expensive setup (kernels, lookup tables) can
+ * override it to do the setup only once and to work on the frames in parallel.
+ * After the call, getResultData returns the result of the last frame.
+ * \param inputs frames for input inputIndex
+ * \param inputIndex
+ * \param useOpenCV
+ * \param results one result per frame of output outputIndex, owned by the caller
+ * \param outputIndex
+ * \return true if all frames were processed successfully
+ */
+bool IPLProcess::processInputDataBatch(const std::vector<IPLData*>& inputs, int inputIndex, bool useOpenCV,
+                                       std::vector<IPLData*>& results, int outputIndex)
+{
+    results.clear();
+    results.reserve(inputs.size());
+
+    for(IPLData* data : inputs)
+    {
+        if(!processInputData(data, inputIndex, useOpenCV))
+            return false;
+
+        IPLData* result = getResultData(outputIndex);
+        IPLImage* image = result ? result->toImage() : NULL;
+        if(!image)
+        {
+            addError("Batch processing needs an image result.");
+            return false;
+        }
+
+        // the process owns its result and replaces it with the next frame
+        results.push_back(new IPLImage(*image));
+    }
+    return true;
+}
+
 int IPLProcess::availableInputs()
 {
     int count = 0;
@@ -0,0 +1,46 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLPyramid.h"
+
+IPLPyramid::IPLPyramid(bool laplacian) : IPLData(IPL_PYRAMID)
+{
+    _laplacian = laplacian;
+}
+
+IPLPyramid::IPLPyramid(const IPLPyramid &other) : IPLData(IPL_PYRAMID)
+{
+    _laplacian = other._laplacian;
+    for(IPLImage* image : other._levels)
+        _levels.push_back(new IPLImage(*image));
+}
+
+IPLPyramid::~IPLPyramid()
+{
+    for(IPLImage* image : _levels)
+        delete image;
+}
+
+/*!
+ * \brief IPLPyramid::addLevel appends a level, the pyramid takes ownership
+ */
+void IPLPyramid::addLevel(IPLImage* image)
+{
+    _levels.push_back(image);
+}
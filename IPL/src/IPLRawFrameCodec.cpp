@@ -0,0 +1,191 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLRawFrameCodec.h"
+
+#include <cstring>
+#include <stdint.h>
+
+static inline uchar toUchar(ipl_basetype value)
+{
+    int v = (int)(value * FACTOR_TO_UCHAR + 0.5f);
+    return (uchar) (v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static inline uint16_t toUshort(ipl_basetype value)
+{
+    int v = (int)(value * 65535.0f + 0.5f);
+    return (uint16_t) (v < 0 ? 0 : (v > 65535 ? 65535 : v));
+}
+
+size_t IPLRawFrameCodec::frameSize(Format format, int width, int height)
+{
+    size_t pixels = (size_t) width * height;
+
+    switch(format)
+    {
+    case FORMAT_GRAY8:      return pixels;
+    case FORMAT_RGB24:      return pixels * 3;
+    case FORMAT_GRAY16:     return pixels * 2;
+    case FORMAT_GRAY_FLOAT: return pixels * sizeof(float);
+    case FORMAT_RGB_FLOAT:  return pixels * 3 * sizeof(float);
+    default:                return 0;
+    }
+}
+
+int IPLRawFrameCodec::channels(Format format)
+{
+    return (format == FORMAT_RGB24 || format == FORMAT_RGB_FLOAT) ? 3 : 1;
+}
+
+/*!
+ * \brief IPLRawFrameCodec::isPlanarFloat
+ * \return true if the buffer has the plane layout of IPLImage and can be used without conversion
+ */
+bool IPLRawFrameCodec::isPlanarFloat(Format format)
+{
+    return format == FORMAT_GRAY_FLOAT || format == FORMAT_RGB_FLOAT;
+}
+
+/*!
+ * \brief IPLRawFrameCodec::decode
+ * \param format
+ * \param width
+ * \param height
+ * \param data frameSize(format, width, height) bytes
+ * \return new image, owned by the caller
+ */
+IPLImage* IPLRawFrameCodec::decode(Format format, int width, int height, const uchar* data)
+{
+    IPLImage* image = new IPLImage(channels(format) == 3 ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE, width, height);
+
+    if(format == FORMAT_GRAY8)
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            const uchar* src = data + (size_t) y * width;
+            ipl_basetype* dst = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = src[x] * FACTOR_TO_FLOAT;
+        }
+    }
+    else if(format == FORMAT_RGB24)
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            const uchar* src = data + (size_t) y * width * 3;
+            ipl_basetype* r = &image->plane(0)->p(0, y);
+            ipl_basetype* g = &image->plane(1)->p(0, y);
+            ipl_basetype* b = &image->plane(2)->p(0, y);
+            for(int x=0; x < width; x++)
+            {
+                r[x] = src[3*x+0] * FACTOR_TO_FLOAT;
+                g[x] = src[3*x+1] * FACTOR_TO_FLOAT;
+                b[x] = src[3*x+2] * FACTOR_TO_FLOAT;
+            }
+        }
+    }
+    else if(format == FORMAT_GRAY16)
+    {
+        const uint16_t* src16 = reinterpret_cast<const uint16_t*>(data);
+
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            const uint16_t* src = src16 + (size_t) y * width;
+            ipl_basetype* dst = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = src[x] * (1.0f / 65535.0f);
+        }
+    }
+    else if(isPlanarFloat(format))
+    {
+        size_t planeSize = (size_t) width * height * sizeof(float);
+        for(int planeNr=0; planeNr < image->getNumberOfPlanes(); planeNr++)
+            memcpy(&image->plane(planeNr)->p(0, 0), data + planeNr * planeSize, planeSize);
+    }
+
+    return image;
+}
+
+/*!
+ * \brief IPLRawFrameCodec::encode, grayscale images are replicated to all color channels
+ * and color images are written as their first plane to gray formats
+ * \param image
+ * \param format
+ * \param data frameSize(format, image->width(), image->height()) bytes
+ */
+void IPLRawFrameCodec::encode(IPLImage* image, Format format, uchar* data)
+{
+    int width   = image->width();
+    int height  = image->height();
+    int g       = image->getNumberOfPlanes() >= 3 ? 1 : 0;
+    int b       = image->getNumberOfPlanes() >= 3 ? 2 : 0;
+
+    if(format == FORMAT_GRAY8)
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            uchar* dst = data + (size_t) y * width;
+            ipl_basetype* src = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = toUchar(src[x]);
+        }
+    }
+    else if(format == FORMAT_RGB24)
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            uchar* dst = data + (size_t) y * width * 3;
+            ipl_basetype* srcR = &image->plane(0)->p(0, y);
+            ipl_basetype* srcG = &image->plane(g)->p(0, y);
+            ipl_basetype* srcB = &image->plane(b)->p(0, y);
+            for(int x=0; x < width; x++)
+            {
+                dst[3*x+0] = toUchar(srcR[x]);
+                dst[3*x+1] = toUchar(srcG[x]);
+                dst[3*x+2] = toUchar(srcB[x]);
+            }
+        }
+    }
+    else if(format == FORMAT_GRAY16)
+    {
+        uint16_t* dst16 = reinterpret_cast<uint16_t*>(data);
+
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            uint16_t* dst = dst16 + (size_t) y * width;
+            ipl_basetype* src = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = toUshort(src[x]);
+        }
+    }
+    else if(isPlanarFloat(format))
+    {
+        int planes[3] = {0, g, b};
+        size_t planeSize = (size_t) width * height * sizeof(float);
+        for(int i=0; i < channels(format); i++)
+            memcpy(data + i * planeSize, &image->plane(planes[i])->p(0, 0), planeSize);
+    }
+}
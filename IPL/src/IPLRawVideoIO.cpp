@@ -0,0 +1,246 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLRawVideoIO.h"
+
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <io.h>
+    #include <fcntl.h>
+#elif defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+std::mutex                  IPLRawVideoIO::_mutex;
+std::condition_variable     IPLRawVideoIO::_notEmpty;
+std::condition_variable     IPLRawVideoIO::_notFull;
+std::deque<IPLImage*>       IPLRawVideoIO::_queue;
+bool                        IPLRawVideoIO::_reading         = false;
+bool                        IPLRawVideoIO::_endOfInput      = false;
+bool                        IPLRawVideoIO::_stop            = false;
+int                         IPLRawVideoIO::_width           = 0;
+int                         IPLRawVideoIO::_height          = 0;
+IPLRawFrameCodec::Format    IPLRawVideoIO::_format          = IPLRawFrameCodec::FORMAT_GRAY8;
+size_t                      IPLRawVideoIO::_queueSize       = 1;
+uint64_t                    IPLRawVideoIO::_generation      = 0;
+std::atomic<uint64_t>       IPLRawVideoIO::_framesRead(0);
+
+std::mutex                  IPLRawVideoIO::_writeMutex;
+std::vector<uchar>          IPLRawVideoIO::_writeBuffer;
+std::atomic<uint64_t>       IPLRawVideoIO::_framesWritten(0);
+
+//! size of the stdin buffer
+static const size_t STREAM_BUFFER_SIZE = 4 * 1024 * 1024;
+
+//! default limit of /proc/sys/fs/pipe-max-size for unprivileged processes
+static const int PIPE_SIZE = 1024 * 1024;
+
+/*!
+ * \brief IPLRawVideoIO::configureInput sets the frame geometry of stdin and starts the reader thread
+ * A changed geometry applies from the next frame on, queued frames are dropped.
+ * \param width
+ * \param height
+ * \param format
+ * \param queueSize number of decoded frames which are read ahead
+ */
+void IPLRawVideoIO::configureInput(int width, int height, IPLRawFrameCodec::Format format, int queueSize)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _queueSize = std::max(1, queueSize);
+    if(width != _width || height != _height || format != _format)
+    {
+        _width  = width;
+        _height = height;
+        _format = format;
+        _generation++;
+
+        for(size_t i=0; i < _queue.size(); i++)
+            delete _queue[i];
+        _queue.clear();
+        _notFull.notify_all();
+    }
+
+    // stdin can not be interrupted, the thread runs until the input ends or shutdown()
+    if(!_reading && !_stop)
+    {
+        _reading = true;
+        std::thread(&IPLRawVideoIO::readInput).detach();
+    }
+}
+
+/*!
+ * \brief IPLRawVideoIO::readFrame takes the next frame
+ * \param timeoutMs maximum time to wait, 0 waits until a frame arrives or the input ends
+ * \return new image, owned by the caller, or NULL
+ */
+IPLImage* IPLRawVideoIO::readFrame(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto ready = [] { return !_queue.empty() || _endOfInput; };
+    if(timeoutMs > 0)
+        _notEmpty.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+    else
+        _notEmpty.wait(lock, ready);
+
+    if(_queue.empty())
+        return NULL;
+
+    IPLImage* image = _queue.front();
+    _queue.pop_front();
+    _notFull.notify_one();
+    return image;
+}
+
+/*!
+ * \brief IPLRawVideoIO::shutdown stops the reader thread and drops the queued frames
+ * Must be called before the application exits. A thread blocked on stdin
+ * stays blocked, but no longer waits for the queue.
+ */
+void IPLRawVideoIO::shutdown()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _stop = true;
+    _endOfInput = true;
+    for(size_t i=0; i < _queue.size(); i++)
+        delete _queue[i];
+    _queue.clear();
+
+    _notFull.notify_all();
+    _notEmpty.notify_all();
+}
+
+/*!
+ * \brief IPLRawVideoIO::endOfInput
+ * \return true if stdin was closed and all frames were taken
+ */
+bool IPLRawVideoIO::endOfInput()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _endOfInput && _queue.empty();
+}
+
+int IPLRawVideoIO::queued()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int) _queue.size();
+}
+
+void IPLRawVideoIO::readInput()
+{
+    prepareStream(stdin);
+    setvbuf(stdin, NULL, _IOFBF, STREAM_BUFFER_SIZE);
+
+    std::vector<uchar> buffer;
+    for(;;)
+    {
+        int width, height;
+        IPLRawFrameCodec::Format format;
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_stop)
+                break;
+            width       = _width;
+            height      = _height;
+            format      = _format;
+            generation  = _generation;
+        }
+
+        buffer.resize(IPLRawFrameCodec::frameSize(format, width, height));
+        if(buffer.empty() || fread(&buffer[0], 1, buffer.size(), stdin) != buffer.size())
+            break;
+
+        // decoding here overlaps with the processing of the previous frame
+        IPLImage* image = IPLRawFrameCodec::decode(format, width, height, &buffer[0]);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notFull.wait(lock, [generation] { return _queue.size() < _queueSize || _generation != generation || _stop; });
+        if(_stop)
+        {
+            delete image;
+            break;
+        }
+        if(_generation != generation)
+        {
+            delete image;
+            continue;
+        }
+
+        _queue.push_back(image);
+        _framesRead++;
+        _notEmpty.notify_one();
+    }
+
+    // an incomplete last frame is dropped
+    std::lock_guard<std::mutex> lock(_mutex);
+    _endOfInput = true;
+    _notEmpty.notify_all();
+}
+
+/*!
+ * \brief IPLRawVideoIO::writeFrame writes one frame to stdout
+ * \param image
+ * \param format
+ * \param error
+ * \return false if stdout is closed
+ */
+bool IPLRawVideoIO::writeFrame(IPLImage* image, IPLRawFrameCodec::Format format, std::string& error)
+{
+    std::lock_guard<std::mutex> lock(_writeMutex);
+
+    if(_writeBuffer.empty())
+        prepareStream(stdout);
+
+    _writeBuffer.resize(IPLRawFrameCodec::frameSize(format, image->width(), image->height()));
+    IPLRawFrameCodec::encode(image, format, &_writeBuffer[0]);
+
+    // one large write per frame, flushed so the consumer never waits for a partial frame
+    if(fwrite(&_writeBuffer[0], 1, _writeBuffer.size(), stdout) != _writeBuffer.size() || fflush(stdout) != 0)
+    {
+        error = "Writing to stdout failed.";
+        return false;
+    }
+
+    _framesWritten++;
+    return true;
+}
+
+/*!
+ * \brief IPLRawVideoIO::prepareStream switches to binary mode and enlarges the pipe
+ * \param stream stdin or stdout
+ */
+void IPLRawVideoIO::prepareStream(FILE* stream)
+{
+#if defined(_WIN32)
+    _setmode(_fileno(stream), _O_BINARY);
+#elif defined(__linux__) && defined(F_SETPIPE_SZ)
+    // larger pipes let the other side run ahead, fails harmlessly for files and terminals
+    fcntl(fileno(stream), F_SETPIPE_SZ, PIPE_SIZE);
+#else
+    (void) stream;
+#endif
+}
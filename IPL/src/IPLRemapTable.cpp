@@ -0,0 +1,315 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLRemapTable.h"
+
+#include <cmath>
+
+IPLRemapTable::IPLRemapTable()
+{
+    _srcWidth       = 0;
+    _srcHeight      = 0;
+    _dstWidth       = 0;
+    _dstHeight      = 0;
+    _interpolation  = IPLResampler::INTER_LINEAR;
+    _border         = IPLResampler::BORDER_CONSTANT;
+    _taps           = 2;
+}
+
+void IPLRemapTable::clear()
+{
+    _key.clear();
+    _offset.clear();
+    _fraction.clear();
+    _borderPixels.clear();
+}
+
+void IPLRemapTable::allocate(int srcWidth, int srcHeight, int dstWidth, int dstHeight,
+                             int interpolation, int border)
+{
+    // area interpolation is only meaningful for resizing
+    if(interpolation == IPLResampler::INTER_AREA)
+        interpolation = IPLResampler::INTER_LINEAR;
+
+    _srcWidth       = srcWidth;
+    _srcHeight      = srcHeight;
+    _dstWidth       = dstWidth;
+    _dstHeight      = dstHeight;
+    _interpolation  = interpolation;
+    _border         = border;
+    _taps           = IPLResampler::taps(interpolation);
+
+    _key.clear();
+    _offset.assign((size_t) dstWidth * dstHeight, OFFSET_OUTSIDE);
+    _fraction.assign((size_t) dstWidth * dstHeight, 0);
+    _borderPixels.assign(dstHeight, std::vector<BorderPixel>());
+
+    _weights.resize(FRACTION_SIZE * _taps);
+    for(int i = 0; i < FRACTION_SIZE; i++)
+        IPLResampler::weights(interpolation, (float) i / FRACTION_SIZE, &_weights[i*_taps]);
+}
+
+/*!
+ * \brief IPLRemapTable::encodeRow converts the source coordinates of one output row to fixed point
+ */
+void IPLRemapTable::encodeRow(int y, const double* X, const double* Y)
+{
+    const double LIMIT = 1e6;
+    int n = _taps;
+    int offset = (n > 1) ? n/2 - 1 : 0;
+    int32_t* rowOffset = &_offset[(size_t) y * _dstWidth];
+    uint16_t* rowFraction = &_fraction[(size_t) y * _dstWidth];
+    std::vector<BorderPixel>& borderPixels = _borderPixels[y];
+
+    for(int x = 0; x < _dstWidth; x++)
+    {
+        double sx = std::max(-LIMIT, std::min(LIMIT, X[x]));
+        double sy = std::max(-LIMIT, std::min(LIMIT, Y[x]));
+
+        int x0, y0, fx = 0, fy = 0;
+        if(n == 1)
+        {
+            x0 = (int) std::floor(sx + 0.5);
+            y0 = (int) std::floor(sy + 0.5);
+        }
+        else
+        {
+            int ix = (int) std::floor(sx * FRACTION_SIZE + 0.5);
+            int iy = (int) std::floor(sy * FRACTION_SIZE + 0.5);
+            fx = ix & (FRACTION_SIZE - 1);
+            fy = iy & (FRACTION_SIZE - 1);
+            x0 = (ix - fx) / FRACTION_SIZE - offset;
+            y0 = (iy - fy) / FRACTION_SIZE - offset;
+        }
+        uint16_t fraction = (uint16_t) ((fy << FRACTION_BITS) | fx);
+
+        if(x0 >= 0 && x0 + n <= _srcWidth && y0 >= 0 && y0 + n <= _srcHeight)
+        {
+            rowOffset[x] = y0 * _srcWidth + x0;
+            rowFraction[x] = fraction;
+        }
+        else if(_border == IPLResampler::BORDER_CONSTANT
+                && (x0 + n <= 0 || x0 >= _srcWidth || y0 + n <= 0 || y0 >= _srcHeight))
+        {
+            rowOffset[x] = OFFSET_OUTSIDE;
+        }
+        else
+        {
+            BorderPixel pixel = {x, x0, y0, fraction};
+            borderPixels.push_back(pixel);
+            rowOffset[x] = OFFSET_BORDER;
+        }
+    }
+}
+
+/*!
+ * \brief IPLRemapTable::buildPerspective builds the table for a forward homography (3x3, row major)
+ * \return false if the matrix is not invertible
+ */
+bool IPLRemapTable::buildPerspective(const double matrix[9], int srcWidth, int srcHeight,
+                                     int dstWidth, int dstHeight, int interpolation, int border)
+{
+    double m[9];
+    if(!IPLResampler::invertPerspective(matrix, m))
+    {
+        clear();
+        return false;
+    }
+
+    allocate(srcWidth, srcHeight, dstWidth, dstHeight, interpolation, border);
+
+    #pragma omp parallel for
+    for(int y = 0; y < dstHeight; y++)
+    {
+        std::vector<double> X(dstWidth), Y(dstWidth);
+        for(int x = 0; x < dstWidth; x++)
+        {
+            double W = m[6]*x + m[7]*y + m[8];
+            X[x] = m[0]*x + m[1]*y + m[2];
+            Y[x] = m[3]*x + m[4]*y + m[5];
+            if(W != 0.0)
+            {
+                X[x] /= W;
+                Y[x] /= W;
+            }
+            else
+            {
+                // point at infinity: outside the source, encodeRow clamps and the border mode decides
+                X[x] = (X[x] > 0.0) ? HUGE_VAL : -HUGE_VAL;
+                Y[x] = (Y[x] > 0.0) ? HUGE_VAL : -HUGE_VAL;
+            }
+        }
+        encodeRow(y, &X[0], &Y[0]);
+    }
+    return true;
+}
+
+/*!
+ * \brief IPLRemapTable::buildUndistort builds the table for the radial and tangential lens model
+ * Same model as cv::undistort with the camera matrix also used as new camera matrix.
+ */
+void IPLRemapTable::buildUndistort(double f, double cx, double cy,
+                                   double k1, double k2, double p1, double p2, double k3,
+                                   int width, int height, int interpolation, int border)
+{
+    allocate(width, height, width, height, interpolation, border);
+
+    double invF = (f != 0.0) ? 1.0 / f : 0.0;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        std::vector<double> X(width), Y(width);
+        double yn = (y - cy) * invF;
+        for(int x = 0; x < width; x++)
+        {
+            double xn = (x - cx) * invF;
+            double r2 = xn*xn + yn*yn;
+            double radial = 1 + ((k3*r2 + k2)*r2 + k1)*r2;
+            double xd = xn*radial + 2*p1*xn*yn + p2*(r2 + 2*xn*xn);
+            double yd = yn*radial + p1*(r2 + 2*yn*yn) + 2*p2*xn*yn;
+            X[x] = f*xd + cx;
+            Y[x] = f*yd + cy;
+        }
+        encodeRow(y, &X[0], &Y[0]);
+    }
+}
+
+/*!
+ * \brief IPLRemapTable::apply resamples image into result with the cached mapping
+ * image must have the source size and result the output size of the table.
+ */
+void IPLRemapTable::apply(IPLImage* image, IPLImage* result)
+{
+    if(_offset.empty()
+            || image->width() != _srcWidth || image->height() != _srcHeight
+            || result->width() != _dstWidth || result->height() != _dstHeight)
+        return;
+
+    int planes = std::min(std::min(image->getNumberOfPlanes(), result->getNumberOfPlanes()), 4);
+    int n = _taps;
+    int srcWidth = _srcWidth;
+    const float* weights = &_weights[0];
+
+    const ipl_basetype* src[4];
+    for(int p = 0; p < planes; p++)
+        src[p] = &image->plane(p)->p(0, 0);
+
+    #pragma omp parallel for
+    for(int y = 0; y < _dstHeight; y++)
+    {
+        ipl_basetype* dst[4];
+        for(int p = 0; p < planes; p++)
+            dst[p] = &result->plane(p)->p(0, y);
+
+        const int32_t* rowOffset = &_offset[(size_t) y * _dstWidth];
+        const uint16_t* rowFraction = &_fraction[(size_t) y * _dstWidth];
+
+        if(n == 1)
+        {
+            for(int x = 0; x < _dstWidth; x++)
+            {
+                int o = rowOffset[x];
+                for(int p = 0; p < planes; p++)
+                    dst[p][x] = (o >= 0) ? src[p][o] : 0.0f;
+            }
+        }
+        else if(n == 2)
+        {
+            for(int x = 0; x < _dstWidth; x++)
+            {
+                int o = rowOffset[x];
+                if(o < 0)
+                {
+                    for(int p = 0; p < planes; p++)
+                        dst[p][x] = 0.0f;
+                    continue;
+                }
+                const float* wx = weights + (rowFraction[x] & (FRACTION_SIZE - 1)) * 2;
+                const float* wy = weights + (rowFraction[x] >> FRACTION_BITS) * 2;
+                for(int p = 0; p < planes; p++)
+                {
+                    const ipl_basetype* s = src[p] + o;
+                    dst[p][x] = (s[0]*wx[0] + s[1]*wx[1]) * wy[0]
+                              + (s[srcWidth]*wx[0] + s[srcWidth + 1]*wx[1]) * wy[1];
+                }
+            }
+        }
+        else
+        {
+            for(int x = 0; x < _dstWidth; x++)
+            {
+                int o = rowOffset[x];
+                if(o < 0)
+                {
+                    for(int p = 0; p < planes; p++)
+                        dst[p][x] = 0.0f;
+                    continue;
+                }
+                const float* wx = weights + (rowFraction[x] & (FRACTION_SIZE - 1)) * n;
+                const float* wy = weights + (rowFraction[x] >> FRACTION_BITS) * n;
+                for(int p = 0; p < planes; p++)
+                {
+                    const ipl_basetype* row = src[p] + o;
+                    float sum = 0.0f;
+                    for(int ky = 0; ky < n; ky++, row += srcWidth)
+                    {
+                        float s = 0.0f;
+                        for(int kx = 0; kx < n; kx++)
+                            s += row[kx] * wx[kx];
+                        sum += s * wy[ky];
+                    }
+                    dst[p][x] = sum;
+                }
+            }
+        }
+
+        // pixels with taps outside of the source image
+        const std::vector<BorderPixel>& borderPixels = _borderPixels[y];
+        for(size_t i = 0; i < borderPixels.size(); i++)
+        {
+            const BorderPixel& pixel = borderPixels[i];
+            int ix[8], iy[8];
+            for(int k = 0; k < n; k++)
+            {
+                ix[k] = IPLResampler::borderIndex(pixel.x0 + k, _srcWidth, _border);
+                iy[k] = IPLResampler::borderIndex(pixel.y0 + k, _srcHeight, _border);
+            }
+
+            const float* wx = (n > 1) ? weights + (pixel.fraction & (FRACTION_SIZE - 1)) * n : weights;
+            const float* wy = (n > 1) ? weights + (pixel.fraction >> FRACTION_BITS) * n : weights;
+            for(int p = 0; p < planes; p++)
+            {
+                float sum = 0.0f;
+                for(int ky = 0; ky < n; ky++)
+                {
+                    if(iy[ky] < 0)
+                        continue;
+                    const ipl_basetype* row = src[p] + iy[ky]*srcWidth;
+                    float s = 0.0f;
+                    for(int kx = 0; kx < n; kx++)
+                        if(ix[kx] >= 0)
+                            s += row[ix[kx]] * wx[kx];
+                    sum += s * wy[ky];
+                }
+                dst[p][pixel.x] = sum;
+            }
+        }
+    }
+}
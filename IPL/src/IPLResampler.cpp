@@ -0,0 +1,626 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLResampler.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+/*!
+ * \brief IPLResampler::taps returns the filter size of an interpolation method
+ */
+int IPLResampler::taps(int interpolation)
+{
+    switch(interpolation)
+    {
+    case INTER_NEAREST:     return 1;
+    case INTER_CUBIC:       return 4;
+    case INTER_LANCZOS4:    return 8;
+    default:                return 2;
+    }
+}
+
+/*!
+ * \brief IPLResampler::weights computes the filter weights for the fractional position t
+ * Tap k lies at floor(x) + k - (taps/2 - 1). The cubic kernel uses a = -0.75
+ * and the Lanczos kernel a window of 4 like OpenCV.
+ */
+void IPLResampler::weights(int interpolation, float t, float* w)
+{
+    switch(interpolation)
+    {
+    case INTER_NEAREST:
+        w[0] = 1.0f;
+        break;
+    case INTER_CUBIC:
+    {
+        const float A = -0.75f;
+        w[0] = ((A*(t + 1) - 5*A)*(t + 1) + 8*A)*(t + 1) - 4*A;
+        w[1] = ((A + 2)*t - (A + 3))*t*t + 1;
+        w[2] = ((A + 2)*(1 - t) - (A + 3))*(1 - t)*(1 - t) + 1;
+        w[3] = 1.0f - w[0] - w[1] - w[2];
+        break;
+    }
+    case INTER_LANCZOS4:
+    {
+        double sum = 0;
+        double v[8];
+        for(int k = 0; k < 8; k++)
+        {
+            double d = t - (k - 3);
+            if(std::fabs(d) < 1e-6)
+                v[k] = 1.0;
+            else
+                v[k] = 4.0 * std::sin(PI*d) * std::sin(PI*d/4.0) / (PI*PI*d*d);
+            sum += v[k];
+        }
+        for(int k = 0; k < 8; k++)
+            w[k] = (float) (v[k] / sum);
+        break;
+    }
+    default:
+        w[0] = 1.0f - t;
+        w[1] = t;
+        break;
+    }
+}
+
+/*!
+ * \brief IPLResampler::borderIndex maps an index outside of [0, size) according to the border mode
+ * \return the index or -1 for a constant (black) border
+ */
+int IPLResampler::borderIndex(int i, int size, int border)
+{
+    if(i >= 0 && i < size)
+        return i;
+
+    switch(border)
+    {
+    case BORDER_REPLICATE:
+        return i < 0 ? 0 : size - 1;
+    case BORDER_REFLECT:
+    {
+        int period = 2*size;
+        i = ((i % period) + period) % period;
+        return i < size ? i : period - 1 - i;
+    }
+    case BORDER_WRAP:
+        return ((i % size) + size) % size;
+    default:
+        return -1;
+    }
+}
+
+/*!
+ * \brief IPLResampler::resizeTaps precomputes source indices and weights for one axis
+ * Every output position gets exactly n taps, unused taps have weight 0.
+ * Area interpolation integrates the source pixels covered by the output pixel
+ * when shrinking and falls back to linear interpolation when enlarging.
+ */
+void IPLResampler::resizeTaps(int srcSize, int dstSize, int interpolation,
+                              std::vector<int>& index, std::vector<float>& weight, int& n)
+{
+    double scale = (double) srcSize / dstSize;
+
+    if(interpolation == INTER_AREA && scale > 1.0)
+    {
+        n = (int) std::ceil(scale) + 1;
+        index.assign(dstSize*n, 0);
+        weight.assign(dstSize*n, 0.0f);
+
+        for(int x = 0; x < dstSize; x++)
+        {
+            double start = x * scale;
+            double end = std::min(start + scale, (double) srcSize);
+            int k = 0;
+            for(int i = (int) std::floor(start); i < end && k < n; i++, k++)
+            {
+                double overlap = std::min(end, i + 1.0) - std::max(start, (double) i);
+                index[x*n + k] = std::min(i, srcSize - 1);
+                weight[x*n + k] = (float) (overlap / scale);
+            }
+            for(; k < n; k++)
+                index[x*n + k] = index[x*n + k - 1];
+        }
+        return;
+    }
+
+    if(interpolation == INTER_AREA)
+        interpolation = INTER_LINEAR;
+
+    n = taps(interpolation);
+    index.resize(dstSize*n);
+    weight.resize(dstSize*n);
+
+    for(int x = 0; x < dstSize; x++)
+    {
+        int i0;
+        float t;
+        if(interpolation == INTER_NEAREST)
+        {
+            i0 = std::min((int) std::floor(x * scale), srcSize - 1);
+            t = 0.0f;
+        }
+        else
+        {
+            double center = (x + 0.5) * scale - 0.5;
+            i0 = (int) std::floor(center);
+            t = (float) (center - i0);
+            i0 -= n/2 - 1;
+        }
+
+        weights(interpolation, t, &weight[x*n]);
+        for(int k = 0; k < n; k++)
+            index[x*n + k] = borderIndex(i0 + k, srcSize, BORDER_REPLICATE);
+    }
+}
+
+/*!
+ * \brief IPLResampler::resize scales image to the size of result
+ * Separable implementation: horizontal pass into a float buffer of
+ * srcHeight x dstWidth per plane, then a vertical pass over contiguous rows.
+ */
+void IPLResampler::resize(IPLImage* image, IPLImage* result, int interpolation)
+{
+    int srcWidth = image->width();
+    int srcHeight = image->height();
+    int dstWidth = result->width();
+    int dstHeight = result->height();
+    int planes = std::min(image->getNumberOfPlanes(), result->getNumberOfPlanes());
+
+    if(srcWidth < 1 || srcHeight < 1 || dstWidth < 1 || dstHeight < 1)
+        return;
+
+    std::vector<int> indexX, indexY;
+    std::vector<float> weightX, weightY;
+    int nx, ny;
+    resizeTaps(srcWidth, dstWidth, interpolation, indexX, weightX, nx);
+    resizeTaps(srcHeight, dstHeight, interpolation, indexY, weightY, ny);
+
+    // horizontal pass, identity if the width does not change
+    bool sameWidth = (srcWidth == dstWidth);
+    std::vector<ipl_basetype> buffer(sameWidth ? 0 : (size_t) planes * srcHeight * dstWidth);
+
+    if(!sameWidth)
+    {
+        #pragma omp parallel for
+        for(int row = 0; row < planes*srcHeight; row++)
+        {
+            int p = row / srcHeight;
+            int y = row % srcHeight;
+            const ipl_basetype* src = &image->plane(p)->p(0, y);
+            ipl_basetype* dst = &buffer[(size_t) row * dstWidth];
+            const int* idx = &indexX[0];
+            const float* w = &weightX[0];
+
+            if(nx == 1)
+            {
+                for(int x = 0; x < dstWidth; x++)
+                    dst[x] = src[idx[x]];
+            }
+            else if(nx == 2)
+            {
+                for(int x = 0; x < dstWidth; x++)
+                    dst[x] = src[idx[2*x]]*w[2*x] + src[idx[2*x+1]]*w[2*x+1];
+            }
+            else
+            {
+                for(int x = 0; x < dstWidth; x++)
+                {
+                    float sum = 0.0f;
+                    for(int k = 0; k < nx; k++)
+                        sum += src[idx[x*nx + k]] * w[x*nx + k];
+                    dst[x] = sum;
+                }
+            }
+        }
+    }
+
+    // vertical pass, weighted sum of whole rows
+    #pragma omp parallel for
+    for(int y = 0; y < dstHeight; y++)
+    {
+        const int* idx = &indexY[y*ny];
+        const float* w = &weightY[y*ny];
+
+        for(int p = 0; p < planes; p++)
+        {
+            ipl_basetype* dst = &result->plane(p)->p(0, y);
+
+            for(int k = 0; k < ny; k++)
+            {
+                const ipl_basetype* r;
+                if(sameWidth)
+                    r = &image->plane(p)->p(0, idx[k]);
+                else
+                    r = &buffer[((size_t) p*srcHeight + idx[k]) * dstWidth];
+
+                float wk = w[k];
+                if(k == 0)
+                {
+                    for(int x = 0; x < dstWidth; x++)
+                        dst[x] = r[x] * wk;
+                    continue;
+                }
+                if(wk == 0.0f)
+                    continue;
+                for(int x = 0; x < dstWidth; x++)
+                    dst[x] += r[x] * wk;
+            }
+        }
+    }
+}
+
+
+/*!
+ * \brief IPLResampler::warpAffine applies the forward transformation matrix (2x3, row major)
+ * \return false if the matrix is not invertible
+ */
+bool IPLResampler::warpAffine(IPLImage* image, IPLImage* result, const double matrix[6],
+                              int interpolation, int border)
+{
+    double inverse[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    if(!invertAffine(matrix, inverse))
+        return false;
+
+    warp(image, result, inverse, false, interpolation, border);
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::warpPerspective applies the forward homography (3x3, row major)
+ * \return false if the matrix is not invertible
+ */
+bool IPLResampler::warpPerspective(IPLImage* image, IPLImage* result, const double matrix[9],
+                                   int interpolation, int border)
+{
+    double inverse[9];
+    if(!invertPerspective(matrix, inverse))
+        return false;
+
+    warp(image, result, inverse, true, interpolation, border);
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::warp maps every output pixel back into the source image
+ * The filter weights are looked up in a table with 1/256 pixel resolution,
+ * computed once per pixel and applied to all planes. Pixels whose taps lie
+ * completely inside the source image skip the border handling.
+ */
+void IPLResampler::warp(IPLImage* image, IPLImage* result, const double m[9],
+                        bool perspective, int interpolation, int border)
+{
+    int srcWidth = image->width();
+    int srcHeight = image->height();
+    int dstWidth = result->width();
+    int dstHeight = result->height();
+    int planes = std::min(std::min(image->getNumberOfPlanes(), result->getNumberOfPlanes()), 4);
+
+    if(srcWidth < 1 || srcHeight < 1)
+        return;
+
+    // area interpolation is only meaningful for resizing
+    if(interpolation == INTER_AREA)
+        interpolation = INTER_LINEAR;
+
+    const int TABLE_SIZE = 256;
+    int n = taps(interpolation);
+    int offset = (n > 1) ? n/2 - 1 : 0;
+    std::vector<float> table((TABLE_SIZE + 1) * n);
+    for(int i = 0; i <= TABLE_SIZE; i++)
+        weights(interpolation, (float) i / TABLE_SIZE, &table[i*n]);
+
+    const ipl_basetype* src[4];
+    for(int p = 0; p < planes; p++)
+        src[p] = &image->plane(p)->p(0, 0);
+
+    // keeps far away coordinates of perspective warps in integer range
+    const double LIMIT = 1e8;
+
+    #pragma omp parallel for
+    for(int y = 0; y < dstHeight; y++)
+    {
+        ipl_basetype* dst[4];
+        for(int p = 0; p < planes; p++)
+            dst[p] = &result->plane(p)->p(0, y);
+
+        int ix[8], iy[8];
+
+        for(int x = 0; x < dstWidth; x++)
+        {
+            double X = m[0]*x + m[1]*y + m[2];
+            double Y = m[3]*x + m[4]*y + m[5];
+            if(perspective)
+            {
+                double W = m[6]*x + m[7]*y + m[8];
+                if(W != 0.0)
+                {
+                    X /= W;
+                    Y /= W;
+                }
+                else
+                {
+                    // point at infinity: outside the source, the border mode decides
+                    X = (X > 0.0) ? LIMIT : -LIMIT;
+                    Y = (Y > 0.0) ? LIMIT : -LIMIT;
+                }
+            }
+            X = std::max(-LIMIT, std::min(LIMIT, X));
+            Y = std::max(-LIMIT, std::min(LIMIT, Y));
+
+            if(n == 1)
+            {
+                int sx = borderIndex((int) std::floor(X + 0.5), srcWidth, border);
+                int sy = borderIndex((int) std::floor(Y + 0.5), srcHeight, border);
+                for(int p = 0; p < planes; p++)
+                    dst[p][x] = (sx < 0 || sy < 0) ? 0.0f : src[p][sy*srcWidth + sx];
+                continue;
+            }
+
+            double fx = std::floor(X);
+            double fy = std::floor(Y);
+            int x0 = (int) fx - offset;
+            int y0 = (int) fy - offset;
+            const float* wx = &table[(int) ((X - fx) * TABLE_SIZE + 0.5) * n];
+            const float* wy = &table[(int) ((Y - fy) * TABLE_SIZE + 0.5) * n];
+
+            if(x0 >= 0 && x0 + n <= srcWidth && y0 >= 0 && y0 + n <= srcHeight)
+            {
+                for(int p = 0; p < planes; p++)
+                {
+                    const ipl_basetype* row = src[p] + y0*srcWidth + x0;
+                    float sum = 0.0f;
+                    for(int ky = 0; ky < n; ky++, row += srcWidth)
+                    {
+                        float s = 0.0f;
+                        for(int kx = 0; kx < n; kx++)
+                            s += row[kx] * wx[kx];
+                        sum += s * wy[ky];
+                    }
+                    dst[p][x] = sum;
+                }
+                continue;
+            }
+
+            for(int k = 0; k < n; k++)
+            {
+                ix[k] = borderIndex(x0 + k, srcWidth, border);
+                iy[k] = borderIndex(y0 + k, srcHeight, border);
+            }
+            for(int p = 0; p < planes; p++)
+            {
+                float sum = 0.0f;
+                for(int ky = 0; ky < n; ky++)
+                {
+                    if(iy[ky] < 0)
+                        continue;
+                    const ipl_basetype* row = src[p] + iy[ky]*srcWidth;
+                    float s = 0.0f;
+                    for(int kx = 0; kx < n; kx++)
+                        if(ix[kx] >= 0)
+                            s += row[ix[kx]] * wx[kx];
+                    sum += s * wy[ky];
+                }
+                dst[p][x] = sum;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLResampler::rotationMatrix rotates by angle (degrees, counter clockwise) around (cx, cy)
+ * Same convention as cv::getRotationMatrix2D.
+ */
+void IPLResampler::rotationMatrix(double cx, double cy, double angle, double scale, double matrix[6])
+{
+    double alpha = scale * std::cos(angle * PI / 180.0);
+    double beta = scale * std::sin(angle * PI / 180.0);
+
+    matrix[0] = alpha;
+    matrix[1] = beta;
+    matrix[2] = (1 - alpha)*cx - beta*cy;
+    matrix[3] = -beta;
+    matrix[4] = alpha;
+    matrix[5] = beta*cx + (1 - alpha)*cy;
+}
+
+/*!
+ * \brief IPLResampler::solve solves a*x = b by Gaussian elimination with partial pivoting
+ * a is n x n row major and destroyed, b is replaced by the solution.
+ * \return false if the system is singular
+ */
+bool IPLResampler::solve(double* a, double* b, int n)
+{
+    for(int col = 0; col < n; col++)
+    {
+        int pivot = col;
+        for(int row = col + 1; row < n; row++)
+            if(std::fabs(a[row*n + col]) > std::fabs(a[pivot*n + col]))
+                pivot = row;
+
+        if(std::fabs(a[pivot*n + col]) < 1e-12)
+            return false;
+
+        if(pivot != col)
+        {
+            for(int k = 0; k < n; k++)
+                std::swap(a[col*n + k], a[pivot*n + k]);
+            std::swap(b[col], b[pivot]);
+        }
+
+        for(int row = col + 1; row < n; row++)
+        {
+            double f = a[row*n + col] / a[col*n + col];
+            for(int k = col; k < n; k++)
+                a[row*n + k] -= f * a[col*n + k];
+            b[row] -= f * b[col];
+        }
+    }
+
+    for(int row = n - 1; row >= 0; row--)
+    {
+        double sum = b[row];
+        for(int k = row + 1; k < n; k++)
+            sum -= a[row*n + k] * b[k];
+        b[row] = sum / a[row*n + row];
+    }
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::affineTransform computes the matrix mapping the 3 points from to the 3 points to
+ * Same as cv::getAffineTransform.
+ */
+bool IPLResampler::affineTransform(const IPLPoint from[3], const IPLPoint to[3], double matrix[6])
+{
+    double a[36] = {0};
+    for(int i = 0; i < 3; i++)
+    {
+        double* r0 = &a[(2*i)*6];
+        double* r1 = &a[(2*i + 1)*6];
+        r0[0] = r1[3] = from[i].x();
+        r0[1] = r1[4] = from[i].y();
+        r0[2] = r1[5] = 1.0;
+        matrix[2*i] = to[i].x();
+        matrix[2*i + 1] = to[i].y();
+    }
+
+    // unknowns are ordered m0 m1 m2 m3 m4 m5
+    double b[6];
+    std::memcpy(b, matrix, sizeof(b));
+    if(!solve(a, b, 6))
+        return false;
+
+    std::memcpy(matrix, b, sizeof(b));
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::perspectiveTransform computes the homography mapping the 4 points from to the 4 points to
+ * Same as cv::getPerspectiveTransform, m8 is fixed to 1.
+ */
+bool IPLResampler::perspectiveTransform(const IPLPoint from[4], const IPLPoint to[4], double matrix[9])
+{
+    double a[64] = {0};
+    double b[8];
+    for(int i = 0; i < 4; i++)
+    {
+        double x = from[i].x();
+        double y = from[i].y();
+        double u = to[i].x();
+        double v = to[i].y();
+        double* r0 = &a[i*8];
+        double* r1 = &a[(i + 4)*8];
+
+        r0[0] = x;  r0[1] = y;  r0[2] = 1.0;
+        r0[6] = -x*u;  r0[7] = -y*u;
+        r1[3] = x;  r1[4] = y;  r1[5] = 1.0;
+        r1[6] = -x*v;  r1[7] = -y*v;
+        b[i] = u;
+        b[i + 4] = v;
+    }
+
+    if(!solve(a, b, 8))
+        return false;
+
+    for(int i = 0; i < 8; i++)
+        matrix[i] = b[i];
+    matrix[8] = 1.0;
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::invertAffine inverts a 2x3 matrix, the result is written to the first 6 entries
+ */
+bool IPLResampler::invertAffine(const double m[6], double inverse[6])
+{
+    double det = m[0]*m[4] - m[1]*m[3];
+    if(std::fabs(det) < 1e-12)
+        return false;
+
+    det = 1.0 / det;
+    double a = m[4]*det;
+    double b = -m[1]*det;
+    double d = -m[3]*det;
+    double e = m[0]*det;
+
+    inverse[0] = a;
+    inverse[1] = b;
+    inverse[2] = -a*m[2] - b*m[5];
+    inverse[3] = d;
+    inverse[4] = e;
+    inverse[5] = -d*m[2] - e*m[5];
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::invertPerspective inverts a 3x3 matrix
+ */
+bool IPLResampler::invertPerspective(const double m[9], double inverse[9])
+{
+    double c0 = m[4]*m[8] - m[5]*m[7];
+    double c1 = m[5]*m[6] - m[3]*m[8];
+    double c2 = m[3]*m[7] - m[4]*m[6];
+    double det = m[0]*c0 + m[1]*c1 + m[2]*c2;
+    if(std::fabs(det) < 1e-12)
+        return false;
+
+    det = 1.0 / det;
+    inverse[0] = c0*det;
+    inverse[1] = (m[2]*m[7] - m[1]*m[8])*det;
+    inverse[2] = (m[1]*m[5] - m[2]*m[4])*det;
+    inverse[3] = c1*det;
+    inverse[4] = (m[0]*m[8] - m[2]*m[6])*det;
+    inverse[5] = (m[2]*m[3] - m[0]*m[5])*det;
+    inverse[6] = c2*det;
+    inverse[7] = (m[1]*m[6] - m[0]*m[7])*det;
+    inverse[8] = (m[0]*m[4] - m[1]*m[3])*det;
+    return true;
+}
+
+/*!
+ * \brief IPLResampler::drawPoint draws a filled marker with radius 3, used for the preview outputs
+ * Images with less than 3 planes get the brightest of the color components.
+ */
+void IPLResampler::drawPoint(IPLImage* image, const IPLPoint& point, float r, float g, float b)
+{
+    int cx = (int) std::floor(point.x() + 0.5);
+    int cy = (int) std::floor(point.y() + 0.5);
+    float color[3] = {r, g, b};
+    float gray = std::max(r, std::max(g, b));
+
+    for(int dy = -3; dy <= 3; dy++)
+    {
+        for(int dx = -3; dx <= 3; dx++)
+        {
+            int x = cx + dx;
+            int y = cy + dy;
+            if(dx*dx + dy*dy > 9 || x < 0 || y < 0 || x >= image->width() || y >= image->height())
+                continue;
+
+            if(image->getNumberOfPlanes() >= 3)
+                for(int p = 0; p < 3; p++)
+                    image->plane(p)->p(x, y) = color[p];
+            else
+                image->plane(0)->p(x, y) = gray;
+        }
+    }
+}
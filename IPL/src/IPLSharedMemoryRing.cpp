@@ -0,0 +1,505 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLSharedMemoryRing.h"
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+//! mapped ring, kept alive by all images which still reference one of its slots
+struct IPLSharedMemoryRing::Mapping
+{
+    Mapping(void* address, size_t size) : address((uchar*) address), size(size) {}
+    ~Mapping();
+
+#if defined(__linux__)
+    IPLSharedMemoryRingHeader* header() { return (IPLSharedMemoryRingHeader*) address; }
+
+    uchar* slot(uint64_t sequence)
+    {
+        return address + header()->dataOffset + (sequence % header()->slotCount) * header()->slotSize;
+    }
+#endif
+
+    void release(uint64_t sequence);
+
+    uchar*                  address;
+    size_t                  size;
+    std::mutex              mutex;
+    std::set<uint64_t>      released;
+};
+
+IPLSharedMemoryRing::Mapping::~Mapping()
+{
+#if defined(__linux__)
+    munmap(address, size);
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::Mapping::release hands a slot back to the producer,
+ * slots released out of order are held back until all earlier ones are released
+ * \param sequence
+ */
+void IPLSharedMemoryRing::Mapping::release(uint64_t sequence)
+{
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(mutex);
+    released.insert(sequence);
+
+    IPLSharedMemoryRingHeader* h = header();
+    uint64_t next = h->readSequence.load();
+    while(released.erase(next))
+    {
+        next++;
+        h->readSequence.store(next);
+        sem_post(&h->empty);
+    }
+#else
+    (void) sequence;
+#endif
+}
+
+#if defined(__linux__)
+static size_t alignUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+static bool waitSemaphore(sem_t* semaphore, int timeoutMs)
+{
+    int result;
+    if(timeoutMs <= 0)
+    {
+        while((result = sem_trywait(semaphore)) != 0 && errno == EINTR) {}
+        return result == 0;
+    }
+
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec  += timeoutMs / 1000;
+    deadline.tv_nsec += (timeoutMs % 1000) * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while((result = sem_timedwait(semaphore, &deadline)) != 0 && errno == EINTR) {}
+    return result == 0;
+}
+#endif
+
+IPLSharedMemoryRing::IPLSharedMemoryRing()
+{
+    _owner      = false;
+    _nextRead   = 0;
+}
+
+IPLSharedMemoryRing::~IPLSharedMemoryRing()
+{
+    close();
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::create creates a new ring, an existing ring with the same name is replaced
+ * \param name POSIX shared memory name, e.g. "/imageplay"
+ * \param width
+ * \param height
+ * \param format
+ * \param slotCount at least 2
+ * \param error
+ * \return
+ */
+bool IPLSharedMemoryRing::create(const std::string& name, int width, int height,
+                                 IPLRawFrameCodec::Format format, int slotCount, std::string& error)
+{
+    close();
+
+#if defined(__linux__)
+    if(width < 1 || height < 1 || slotCount < 2 || format < 0 || format >= IPLRawFrameCodec::NR_OF_FORMATS)
+    {
+        error = "Invalid ring buffer parameters.";
+        return false;
+    }
+
+    size_t frameSize    = IPLRawFrameCodec::frameSize(format, width, height);
+    size_t slotSize     = alignUp(IPL_SHM_RING_ALIGNMENT + frameSize, IPL_SHM_RING_ALIGNMENT);
+    size_t dataOffset   = alignUp(sizeof(IPLSharedMemoryRingHeader), 4096);
+    size_t size         = dataOffset + slotSize * slotCount;
+
+    // a ring left over by a crashed process is replaced
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if(fd < 0)
+    {
+        error = "Could not create shared memory: " + name;
+        return false;
+    }
+
+    if(ftruncate(fd, (off_t) size) != 0)
+    {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        error = "Could not resize shared memory: " + name;
+        return false;
+    }
+
+    void* address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(address == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        error = "Could not map shared memory: " + name;
+        return false;
+    }
+
+    _mapping = std::make_shared<Mapping>(address, size);
+    _name = name;
+    _owner = true;
+    _nextRead = 0;
+
+    IPLSharedMemoryRingHeader* h = _mapping->header();
+    h->version          = IPL_SHM_RING_VERSION;
+    h->width            = (uint32_t) width;
+    h->height           = (uint32_t) height;
+    h->format           = (uint32_t) format;
+    h->slotCount        = (uint32_t) slotCount;
+    h->slotSize         = slotSize;
+    h->dataOffset       = dataOffset;
+    h->frameSize        = frameSize;
+    h->writeSequence    = 0;
+    h->readSequence     = 0;
+    if(sem_init(&h->filled, 1, 0) != 0)
+    {
+        close();
+        error = "Could not create the ring semaphores: " + name;
+        return false;
+    }
+    if(sem_init(&h->empty, 1, (unsigned int) slotCount) != 0)
+    {
+        sem_destroy(&h->filled);
+        close();
+        error = "Could not create the ring semaphores: " + name;
+        return false;
+    }
+
+    // peers only use the ring once it is complete
+    h->magic.store(IPL_SHM_RING_MAGIC);
+    return true;
+#else
+    (void) name; (void) width; (void) height; (void) format; (void) slotCount;
+    error = "Shared memory rings are only supported on Linux.";
+    return false;
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::attach opens a ring created by another process
+ * \param name
+ * \param error
+ * \return
+ */
+bool IPLSharedMemoryRing::attach(const std::string& name, std::string& error)
+{
+    close();
+
+#if defined(__linux__)
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+    {
+        error = "Could not open shared memory: " + name;
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(IPLSharedMemoryRingHeader))
+    {
+        ::close(fd);
+        error = "Shared memory is too small for a ring: " + name;
+        return false;
+    }
+
+    size_t size = (size_t) info.st_size;
+    void* address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(address == MAP_FAILED)
+    {
+        error = "Could not map shared memory: " + name;
+        return false;
+    }
+
+    std::shared_ptr<Mapping> mapping = std::make_shared<Mapping>(address, size);
+    IPLSharedMemoryRingHeader* h = mapping->header();
+    if(h->magic.load() != IPL_SHM_RING_MAGIC || h->version != IPL_SHM_RING_VERSION)
+    {
+        error = "Shared memory is not an ImagePlay ring: " + name;
+        return false;
+    }
+    if(h->format >= IPLRawFrameCodec::NR_OF_FORMATS || h->slotCount < 2
+            || h->slotSize < IPL_SHM_RING_ALIGNMENT + h->frameSize
+            || h->frameSize < IPLRawFrameCodec::frameSize((IPLRawFrameCodec::Format) h->format, h->width, h->height)
+            || h->dataOffset + h->slotSize * h->slotCount > size)
+    {
+        error = "Invalid ring header: " + name;
+        return false;
+    }
+
+    _mapping = mapping;
+    _name = name;
+    _owner = false;
+    _nextRead = h->readSequence.load();
+    return true;
+#else
+    (void) name;
+    error = "Shared memory rings are only supported on Linux.";
+    return false;
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::close detaches, the memory stays mapped while images reference it
+ */
+void IPLSharedMemoryRing::close()
+{
+#if defined(__linux__)
+    if(_mapping && _owner)
+    {
+        _mapping->header()->magic.store(0);
+        shm_unlink(_name.c_str());
+    }
+#endif
+    _mapping.reset();
+    _name.clear();
+    _owner = false;
+    _nextRead = 0;
+}
+
+bool IPLSharedMemoryRing::isOpen()
+{
+    return _mapping != NULL;
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::isValid
+ * \return false if not open or if the creator has closed the ring
+ */
+bool IPLSharedMemoryRing::isValid()
+{
+#if defined(__linux__)
+    return _mapping && _mapping->header()->magic.load() == IPL_SHM_RING_MAGIC;
+#else
+    return false;
+#endif
+}
+
+int IPLSharedMemoryRing::width()
+{
+#if defined(__linux__)
+    return _mapping ? (int) _mapping->header()->width : 0;
+#else
+    return 0;
+#endif
+}
+
+int IPLSharedMemoryRing::height()
+{
+#if defined(__linux__)
+    return _mapping ? (int) _mapping->header()->height : 0;
+#else
+    return 0;
+#endif
+}
+
+IPLRawFrameCodec::Format IPLSharedMemoryRing::format()
+{
+#if defined(__linux__)
+    return _mapping ? (IPLRawFrameCodec::Format) _mapping->header()->format : IPLRawFrameCodec::FORMAT_GRAY8;
+#else
+    return IPLRawFrameCodec::FORMAT_GRAY8;
+#endif
+}
+
+int IPLSharedMemoryRing::slotCount()
+{
+#if defined(__linux__)
+    return _mapping ? (int) _mapping->header()->slotCount : 0;
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::queued
+ * \return number of published frames which were not read yet
+ */
+int IPLSharedMemoryRing::queued()
+{
+#if defined(__linux__)
+    int value = 0;
+    if(_mapping)
+        sem_getvalue(&_mapping->header()->filled, &value);
+    return value;
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::waitForFrame blocks until a frame is published without reading it
+ * \param timeoutMs
+ * \return true if a frame can be read
+ */
+bool IPLSharedMemoryRing::waitForFrame(int timeoutMs)
+{
+#if defined(__linux__)
+    if(!isValid())
+        return false;
+
+    IPLSharedMemoryRingHeader* h = _mapping->header();
+    if(!waitSemaphore(&h->filled, timeoutMs))
+        return false;
+
+    sem_post(&h->filled);
+    return true;
+#else
+    (void) timeoutMs;
+    return false;
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::read takes the next frame
+ * \param timeoutMs
+ * \param latestOnly skip to the newest published frame
+ * \param sequence producer sequence number of the frame
+ * \param error set if the ring is not usable
+ * \return new image, owned by the caller, or NULL if no frame arrived in time
+ */
+IPLImage* IPLSharedMemoryRing::read(int timeoutMs, bool latestOnly, uint64_t& sequence, std::string& error)
+{
+#if defined(__linux__)
+    if(!isValid())
+    {
+        error = _mapping ? "The ring was closed by its creator." : "The ring is not open.";
+        return NULL;
+    }
+
+    IPLSharedMemoryRingHeader* h = _mapping->header();
+    if(!waitSemaphore(&h->filled, timeoutMs))
+        return NULL;
+
+    uint64_t next = _nextRead++;
+    if(latestOnly)
+    {
+        while(sem_trywait(&h->filled) == 0)
+        {
+            _mapping->release(next);
+            next = _nextRead++;
+        }
+    }
+
+    uchar* slot = _mapping->slot(next);
+    uchar* data = slot + IPL_SHM_RING_ALIGNMENT;
+    sequence = ((IPLSharedMemorySlot*) slot)->sequence;
+
+    int width   = (int) h->width;
+    int height  = (int) h->height;
+    IPLRawFrameCodec::Format format = (IPLRawFrameCodec::Format) h->format;
+
+    if(!IPLRawFrameCodec::isPlanarFloat(format))
+    {
+        IPLImage* image = IPLRawFrameCodec::decode(format, width, height, data);
+        _mapping->release(next);
+        return image;
+    }
+
+    // the planes point into the slot, the last one releases it
+    std::shared_ptr<Mapping> mapping = _mapping;
+    std::shared_ptr<ipl_basetype> lease((ipl_basetype*) data, [mapping, next](ipl_basetype*) { mapping->release(next); });
+
+    size_t planeSize = (size_t) width * height;
+    int channels = IPLRawFrameCodec::channels(format);
+    std::vector<IPLImagePlane*> planes;
+    for(int i=0; i < channels; i++)
+        planes.push_back(new IPLImagePlane(width, height, std::shared_ptr<ipl_basetype>(lease, lease.get() + i * planeSize)));
+
+    IPLImage* image = new IPLImage(channels == 3 ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE, planes);
+    for(size_t i=0; i < planes.size(); i++)
+        delete planes[i];
+
+    return image;
+#else
+    (void) timeoutMs; (void) latestOnly; (void) sequence;
+    error = "Shared memory rings are only supported on Linux.";
+    return NULL;
+#endif
+}
+
+/*!
+ * \brief IPLSharedMemoryRing::write publishes a frame, the image must have the size of the ring
+ * \param image
+ * \param timeoutMs how long to wait for a free slot, 0 drops the frame if the ring is full
+ * \param sequence sequence number of the published frame
+ * \return false if the frame was not published
+ */
+bool IPLSharedMemoryRing::write(IPLImage* image, int timeoutMs, uint64_t& sequence)
+{
+#if defined(__linux__)
+    if(!isValid())
+        return false;
+
+    IPLSharedMemoryRingHeader* h = _mapping->header();
+    if(image->width() != (int) h->width || image->height() != (int) h->height)
+        return false;
+
+    if(!waitSemaphore(&h->empty, timeoutMs))
+        return false;
+
+    uint64_t next = h->writeSequence.load();
+    uchar* slot = _mapping->slot(next);
+
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    IPLSharedMemorySlot* info = (IPLSharedMemorySlot*) slot;
+    info->sequence      = next;
+    info->timestampUs   = (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+    IPLRawFrameCodec::encode(image, (IPLRawFrameCodec::Format) h->format, slot + IPL_SHM_RING_ALIGNMENT);
+
+    h->writeSequence.store(next + 1);
+    sem_post(&h->filled);
+
+    sequence = next;
+    return true;
+#else
+    (void) image; (void) timeoutMs; (void) sequence;
+    return false;
+#endif
+}
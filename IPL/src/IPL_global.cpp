@@ -29,7 +29,12 @@ const char* const dataTypeNames[IPL_NUM_DATATYPES] = {
     "IPL_MATRIX",
     "IPL_SHAPES",
     "IPL_UNDEFINED",
-    "IPL_KEYPOINTS"
+    "IPL_KEYPOINTS",
+    "IPL_CV_MAT",
+    "IPL_VECTOR",
+    "IPL_PYRAMID",
+    "IPL_INTEGRAL_IMAGE",
+    "IPL_COMPONENT_TREE"
 };
 
 const char *dataTypeName(IPLDataType type)
@@ -19,16 +19,26 @@
 
 #include "IPLAccumulate.h"
 
+#include <cmath>
+#include <limits>
+
 void IPLAccumulate::init()
 {
     // init
     _result         = NULL;
+    _count          = 0;
+    _method         = -1;
+    _resetCounter   = 0;
+    _width          = 0;
+    _height         = 0;
+    _planes         = 0;
+    _type           = IPL_IMAGE_COLOR;
+    _dirty          = false;
 
     // basic settings
     setClassName("IPLAccumulate");
     setTitle("Accumulate");
     setCategory(IPLProcess::CATEGORY_OBJECTS);
-    setOpenCVSupport(IPLOpenCVSupport::OPENCV_ONLY);
     setDescription("Adds an image to the accumulator.");
 
     // inputs and outputs
@@ -36,73 +46,183 @@ void IPLAccumulate::init()
     addOutput("Image", IPL_IMAGE_COLOR);
 
     // properties
-    addProcessPropertyInt("method", "Method:Default|Square|Product|Weighted", "default|square|product|weighted", 0, IPL_WIDGET_GROUP);
+    addProcessPropertyInt("method", "Method:Default|Square|Product|Weighted|Sum|Mean|Variance|Standard Deviation|Minimum|Maximum",
+                          "default|square|product|weighted|sum|mean|variance|stddev|minimum|maximum", 0, IPL_WIDGET_GROUP);
     addProcessPropertyDouble("weighted_weight", "Weight", "", 0.5, IPL_WIDGET_SLIDER, 0.0, 2.0);
+    addProcessPropertyInt("reset", "Reset", "", 0, IPL_WIDGET_BUTTON);
 }
 
 void IPLAccumulate::destroy()
 {
-    //delete _result;
+    delete _result;
 }
 
-bool IPLAccumulate::processInputData(IPLData* data , int, bool)
+/*!
+ * \brief IPLAccumulate::reset starts a new accumulation for the size and planes of image
+ */
+void IPLAccumulate::reset(IPLImage* image, int method)
 {
-    IPLImage* image = data->toImage();
+    _width  = image->width();
+    _height = image->height();
+    _planes = image->getNumberOfPlanes();
+    _type   = image->type() == IPL_IMAGE_BW ? IPL_IMAGE_GRAYSCALE : image->type();
+    _method = method;
+    _count  = 0;
+
+    size_t size = (size_t) _planes * _width * _height;
+    float initial = 0.0f;
+    if(method == METHOD_MINIMUM)
+        initial = std::numeric_limits<float>::max();
+    else if(method == METHOD_MAXIMUM)
+        initial = -std::numeric_limits<float>::max();
+    _accumulator.assign(size, initial);
+
+    if(method == METHOD_VARIANCE || method == METHOD_STDDEV)
+        _m2.assign(size, 0.0f);
+    else
+        std::vector<float>().swap(_m2);
 
-    // init result
-    if(!_result)
-    {
-        int width = image->width();
-        int height = image->height();
+    delete _result;
+    _result = NULL;
+}
 
-        _result = new IPLImage(image->type(), width, height);
-        _result->fillColor(0.0);
-    }
+bool IPLAccumulate::processInputData(IPLData* data , int, bool)
+{
+    IPLImage* image = data->toImage();
 
     // get properties
     int method              = getProcessPropertyInt("method");
-    double weight           = getProcessPropertyDouble("weighted_weight");
+    float weight            = getProcessPropertyDouble("weighted_weight");
+    int resetCounter        = getProcessPropertyInt("reset");
 
-    /*std::stringstream s;
-    s << "Window: ";
-    s << window;
-    addInformation(s.str());*/
+    if(method != _method || resetCounter != _resetCounter
+            || image->width() != _width || image->height() != _height
+            || image->getNumberOfPlanes() != _planes)
+    {
+        reset(image, method);
+        _resetCounter = resetCounter;
+    }
 
     notifyProgressEventHandler(-1);
-    cv::Mat input = image->toCvMat();
-    cv::Mat output = _result->toCvMat();
-
-    input.convertTo(input, CV_32FC3);
-    output.convertTo(output, CV_32FC3);
 
+    _count++;
+    bool first = (_count == 1);
+    float invCount = 1.0f / _count;
+    int width = _width;
+    int height = _height;
+    int planes = _planes;
 
-    if(method == 0)
+    // update in place, every row is an independent contiguous loop
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
     {
-        cv::accumulate(input, output);
-        output *= 0.5;
-    }
-    else if(method == 1)
-    {
-        cv::accumulateSquare(input, output);
-    }
-    else if(method == 2)
-    {
-        cv::accumulateProduct(input, input, output);
-    }
-    else if(method == 3)
-    {
-        cv::accumulateWeighted(input, output, weight);
+        for(int p = 0; p < planes; p++)
+        {
+            const float* in = &image->plane(p)->p(0, y);
+            size_t offset = ((size_t) p * height + y) * width;
+            float* acc = &_accumulator[offset];
+
+            switch(method)
+            {
+            case METHOD_DEFAULT:
+                for(int x = 0; x < width; x++)
+                    acc[x] = first ? in[x] : (acc[x] + in[x]) * 0.5f;
+                break;
+            case METHOD_SQUARE:
+            case METHOD_PRODUCT:
+                for(int x = 0; x < width; x++)
+                    acc[x] += in[x] * in[x];
+                break;
+            case METHOD_WEIGHTED:
+                for(int x = 0; x < width; x++)
+                    acc[x] = first ? in[x] : acc[x] + weight * (in[x] - acc[x]);
+                break;
+            case METHOD_SUM:
+                for(int x = 0; x < width; x++)
+                    acc[x] += in[x];
+                break;
+            case METHOD_MEAN:
+                for(int x = 0; x < width; x++)
+                    acc[x] += (in[x] - acc[x]) * invCount;
+                break;
+            case METHOD_VARIANCE:
+            case METHOD_STDDEV:
+            {
+                float* m2 = &_m2[offset];
+                for(int x = 0; x < width; x++)
+                {
+                    float delta = in[x] - acc[x];
+                    acc[x] += delta * invCount;
+                    m2[x] += delta * (in[x] - acc[x]);
+                }
+                break;
+            }
+            case METHOD_MINIMUM:
+                for(int x = 0; x < width; x++)
+                    acc[x] = std::min(acc[x], in[x]);
+                break;
+            case METHOD_MAXIMUM:
+                for(int x = 0; x < width; x++)
+                    acc[x] = std::max(acc[x], in[x]);
+                break;
+            }
+        }
     }
 
-    output.convertTo(output, CV_8UC3);
+    _dirty = true;
 
-    delete _result;
-    _result = new IPLImage(output);
+    std::stringstream s;
+    s << "Frames: " << _count;
+    addInformation(s.str());
 
     return true;
 }
 
+/*!
+ * \brief IPLAccumulate::getResultData fills the output image from the accumulator when it is requested
+ */
 IPLData* IPLAccumulate::getResultData( int )
 {
+    if(_count == 0)
+        return _result;
+
+    if(!_dirty && _result)
+        return _result;
+
+    if(!_result)
+        _result = new IPLImage(_type, _width, _height);
+
+    int width = _width;
+    int height = _height;
+    int planes = std::min(_planes, _result->getNumberOfPlanes());
+    int method = _method;
+    float invCount = 1.0f / _count;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int p = 0; p < planes; p++)
+        {
+            size_t offset = ((size_t) p * height + y) * width;
+            const float* acc = &_accumulator[offset];
+            float* out = &_result->plane(p)->p(0, y);
+
+            if(method == METHOD_VARIANCE || method == METHOD_STDDEV)
+            {
+                const float* m2 = &_m2[offset];
+                for(int x = 0; x < width; x++)
+                    out[x] = m2[x] * invCount;
+                if(method == METHOD_STDDEV)
+                    for(int x = 0; x < width; x++)
+                        out[x] = std::sqrt(out[x]);
+            }
+            else
+            {
+                std::copy(acc, acc + width, out);
+            }
+        }
+    }
+
+    _dirty = false;
     return _result;
 }
@@ -19,20 +19,6 @@
 
 #include "IPLArithmeticOperations.h"
 
-using namespace std;
-
-#define Arithmetic_Add(A,B)          min(1.0f, (A + B))
-#define Arithmetic_Sub(A,B)          max(0.0f, (A - B))
-#define Arithmetic_Mul(A,B)          (A * B) / 1.0f
-#define Arithmetic_Div(A,B)          ((B > 0.0f ? ((A / B) / 1.0f) : 0.0f))
-#define Arithmetic_Max(A,B)          max(A, B)
-#define Arithmetic_Min(A,B)          min(A, B)
-#define Arithmetic_And(A,B)          (A == 1.0f && B == 1.0f ? 1.0f : 0.0f)
-#define Arithmetic_Or(A,B)           (A == 1.0f || B == 1.0f ? 1.0f : 0.0f)
-#define Arithmetic_Xor(A,B)          ((A == 1.0f) != (B == 1.0f) ? 1.0f : 0.0f)
-#define Arithmetic_Not(A)            (A == 1.0f ? 0.0f : 1.0f)
-#define Arithmetic_Atan2(A,B)        atan2(A,B);
-
 void IPLArithmeticOperations::init()
 {
     // init
@@ -66,116 +52,26 @@ void IPLArithmeticOperations::destroy()
 bool IPLArithmeticOperations::processInputData(IPLData* data, int imageIndex, bool)
 {
     IPLImage* image = data->toImage();
-	
-    // save the first image
-    if(imageIndex == 0)
-    {
-        delete _inputA;
-        _inputA = new IPLImage(*image);
-    }
 
-    // save the second image
+    // only keep a reference, the inputs stay valid during the processing run
+    if(imageIndex == 0)
+        _inputA = image;
     if(imageIndex == 1)
-    {
-        delete _inputB;
-        _inputB = new IPLImage(*image);
-    }
+        _inputB = image;
 
-    // only continue if we have 2 valid inputs
+    // wait for the other input
     if(!(_inputA && _inputB))
     {
-        return false;
+        return true;
     }
 
-    // delete previous result
-    delete _result;
-    _result = NULL;
-
-    // the result will be the max size of both inputs
-    int width  = std::max(_inputA->width(), _inputB->width());
-    int height = std::max(_inputA->height(), _inputB->height());
-
-    // copy constructor doesnt work:
-    // _result = new IPLImage(*image);
-
     // get properties
     _operation   = getProcessPropertyInt("operation");
 
-    int maxNrOfPlanes = std::max( _inputA->getNumberOfPlanes(), _inputB->getNumberOfPlanes());
-    int progress = 0;
-    int maxProgress = maxNrOfPlanes*height;
+    notifyProgressEventHandler(-1);
 
-    IPLDataType type = IPL_IMAGE_COLOR;
-    if(maxNrOfPlanes == 1)
-        type = IPL_IMAGE_GRAYSCALE;
-
-    // create result
-    _result = new IPLImage(type, width, height);
-
-    #pragma omp parallel for
-    for( int planeNr=0; planeNr < maxNrOfPlanes; planeNr++ )
-    {
-        // prevent reading unavailable planes
-        IPLImagePlane* planeA   = _inputA->plane(std::min(planeNr, _inputA->getNumberOfPlanes()-1));
-        IPLImagePlane* planeB   = _inputB->plane(std::min(planeNr, _inputB->getNumberOfPlanes()-1));
-        IPLImagePlane* newplane = _result->plane(planeNr);
-
-        for(int y=0; y<height; y++)
-        {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
-
-            for(int x=0; x<width; x++)
-            {
-                float valueA = planeA->cp(x,y);
-                float valueB = planeB->cp(x,y);
-                float value = 0;
-
-                //ADD|SUB|MUL|DIV|MIN|MAX|AND|OR|XOR|NOT|ADD Constant|SUB Constant|MUL Constant|DIV Constant
-                switch (_operation) {
-                case 0:
-                    value = Arithmetic_Add(valueA, valueB);
-                    break;
-                case 1:
-                    value = Arithmetic_Sub(valueA, valueB);
-                    break;
-                case 2:
-                    value = Arithmetic_Mul(valueA, valueB);
-                    break;
-                case 3:
-                    value = Arithmetic_Div(valueA, valueB);
-                    break;
-                case 4:
-                    value = Arithmetic_Min(valueA, valueB);
-                    break;
-                case 5:
-                    value = Arithmetic_Max(valueA, valueB);
-                    break;
-                case 6:
-                    value = Arithmetic_And(valueA, valueB);
-                    break;
-                case 7:
-                    value = Arithmetic_Or(valueA, valueB);
-                    break;
-                case 8:
-                    value = Arithmetic_Xor(valueA, valueB);
-                    break;
-                case 9:
-                    value = Arithmetic_Not(valueA);
-                    break;
-                case 10:
-                    value = Arithmetic_Atan2(valueA, valueB);
-                    break;
-                }
-
-                value = value > 1.0 ? 1.0 : value;
-                newplane->p(x,y) = value;
-            }
-        }
-    }
-
-    //_inputA = NULL;
-    //_inputB = NULL;
+    // the result will be the max size of both inputs
+    _result = IPLArithmetic::apply(_operation, _inputA, _inputB, _result);
 
     return true;
 }
@@ -184,3 +80,21 @@ IPLImage* IPLArithmeticOperations::getResultData( int )
 {
     return _result;
 }
+
+/*!
+ * \brief IPLArithmeticOperations::beforeProcessing drops the input references of an aborted run
+ */
+void IPLArithmeticOperations::beforeProcessing()
+{
+    _inputA = NULL;
+    _inputB = NULL;
+}
+
+/*!
+ * \brief IPLArithmeticOperations::afterProcessing drops the input references, they may change before the next run
+ */
+void IPLArithmeticOperations::afterProcessing()
+{
+    _inputA = NULL;
+    _inputB = NULL;
+}
@@ -19,13 +19,6 @@
 
 #include "IPLArithmeticOperationsConstant.h"
 
-using namespace std;
-
-#define Arithmetic_Add(A,B)          min(1.0f, (A + B))
-#define Arithmetic_Sub(A,B)          max(0.0f, (A - B))
-#define Arithmetic_Mul(A,B)          min(1.0f, (A * B))
-#define Arithmetic_Div(A,B)          min(1.0f, ((B > 0.0f ? (A / B) : 1.0f)))
-
 void IPLArithmeticOperationsConstant::init()
 {
     // init
@@ -58,61 +51,26 @@ void IPLArithmeticOperationsConstant::destroy()
 bool IPLArithmeticOperationsConstant::processInputData(IPLData* data, int, bool)
 {
     IPLImage* image = data->toImage();
-	
-    // delete previous result
-    delete _result;
-    _result = NULL;
-
-    int width = image->width();
-    int height = image->height();
-    _result = new IPLImage( image->type(), width, height );
 
     // get properties
     _operation   = getProcessPropertyInt("operation");
     _constant    = getProcessPropertyDouble("constant");
 
-    int nrOfPlanes = image->getNumberOfPlanes();
-    int progress = 0;
-    int maxProgress = nrOfPlanes*height;
-
-    #pragma omp parallel for
-    for( int planeNr=0; planeNr < nrOfPlanes; planeNr++ )
-    {
-        // prevent reading unavailable planes
-        IPLImagePlane* inputPlane = image->plane(planeNr);
-        IPLImagePlane* newplane   = _result->plane(planeNr);
-
-        for(int y=0; y<height; y++)
-        {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
-
-            for(int x=0; x<width; x++)
-            {
-                float valueA = inputPlane->cp(x,y);
-                float value = 0.0f;
+    notifyProgressEventHandler(-1);
 
-                // ADD Constant|SUB Constant|MUL Constant|DIV Constant
-                switch (_operation) {
-                case 0:
-                    value = Arithmetic_Add(valueA, _constant);
-                    break;
-                case 1:
-                    value = Arithmetic_Sub(valueA, _constant);
-                    break;
-                case 2:
-                    value = Arithmetic_Mul(valueA, _constant);
-                    break;
-                case 3:
-                    value = Arithmetic_Div(valueA, _constant);
-                    break;
-                }
+    // ADD Constant|SUB Constant|MUL Constant|DIV Constant
+    static const int operations[] = { IPLArithmetic::ADD, IPLArithmetic::SUB, IPLArithmetic::MUL, IPLArithmetic::DIV };
+    int operation = operations[std::max(0, std::min(_operation, 3))];
 
-                newplane->p(x,y) = value;
-            }
-        }
+    // dividing by 0 gives 1.0 for every pixel
+    if(operation == IPLArithmetic::DIV && _constant <= 0.0f)
+    {
+        _result = IPLArithmetic::apply(IPLArithmetic::MAX, image, 1.0f, _result);
+        return true;
     }
 
+    _result = IPLArithmetic::apply(operation, image, _constant, _result);
+
     return true;
 }
 
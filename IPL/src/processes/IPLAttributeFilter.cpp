@@ -0,0 +1,87 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLAttributeFilter.h"
+
+void IPLAttributeFilter::init()
+{
+    // init
+    _result     = NULL;
+
+    // basic settings
+    setClassName("IPLAttributeFilter");
+    setTitle("Attribute Filter");
+    setCategory(IPLProcess::CATEGORY_MORPHOLOGY);
+    setKeywords("area opening, area closing, connected filter, max-tree, min-tree, contrast, h-maxima");
+    setDescription("Removes all components of the component tree whose area, bounding box size (larger "
+                   "side) or contrast is below the threshold. Area and bounding box are in pixels, the "
+                   "contrast is the height of the component above its surrounding, 0..1.");
+
+    // inputs and outputs
+    addInput("Component Tree", IPL_COMPONENT_TREE);
+    addOutput("Image", IPL_IMAGE_GRAYSCALE);
+
+    // properties
+    addProcessPropertyInt("attribute", "Attribute:Area|Bounding Box|Contrast", "", IPLComponentTree::AREA, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("size", "Minimum Size", "Area or bounding box size in pixels", 100, IPL_WIDGET_SPINNER, 1, 100000000);
+    addProcessPropertyDouble("contrast", "Minimum Contrast", "", 0.1, IPL_WIDGET_SLIDER, 0.0, 1.0);
+}
+
+void IPLAttributeFilter::destroy()
+{
+    delete _result;
+}
+
+bool IPLAttributeFilter::processInputData(IPLData* data, int, bool)
+{
+    IPLComponentTree* tree = data->toComponentTree();
+    if(!tree)
+    {
+        addError("Input must be a component tree.");
+        return false;
+    }
+
+    // get properties
+    int attribute   = getProcessPropertyInt("attribute");
+    int size        = getProcessPropertyInt("size");
+    double contrast = getProcessPropertyDouble("contrast");
+
+    int width = tree->width();
+    int height = tree->height();
+
+    // reuse the result if possible
+    if(!_result || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        _result = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+    }
+
+    notifyProgressEventHandler(-1);
+
+    std::vector<double> values;
+    tree->attribute(attribute, values);
+    tree->filter(values, attribute == IPLComponentTree::CONTRAST ? contrast : size, _result);
+
+    return true;
+}
+
+IPLData* IPLAttributeFilter::getResultData(int)
+{
+    return _result;
+}
@@ -0,0 +1,381 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLBackgroundSubtraction.h"
+
+#include <cmath>
+
+namespace
+{
+    const float INITIAL_VARIANCE = (15.0f / 255.0f) * (15.0f / 255.0f);
+    const float MIN_VARIANCE = (4.0f / 255.0f) * (4.0f / 255.0f);
+    const float FOREGROUND_RATE = 0.1f;
+}
+
+void IPLBackgroundSubtraction::init()
+{
+    // init
+    _foreground     = NULL;
+    _background     = NULL;
+    _modelType      = -1;
+    _components     = 0;
+    _resetCounter   = 0;
+    _width          = 0;
+    _height         = 0;
+    _planes         = 0;
+    _type           = IPL_IMAGE_COLOR;
+    _initialized    = false;
+    _dirty          = false;
+
+    // basic settings
+    setClassName("IPLBackgroundSubtraction");
+    setTitle("Background Subtraction");
+    setCategory(IPLProcess::CATEGORY_OBJECTS);
+    setKeywords("motion detection, foreground, background model, MoG");
+    setDescription("Learns a per-pixel background model from an image sequence and marks pixels "
+                   "which do not fit the model as foreground. The learning rate defines how fast "
+                   "the model adapts to changes.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Foreground", IPL_IMAGE_BW);
+    addOutput("Background", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("model", "Model:Running Gaussian|Mixture of Gaussians", "gaussian|mog", 0, IPL_WIDGET_GROUP);
+    addProcessPropertyInt("mog_components", "Components", "Gaussians per pixel", 3, IPL_WIDGET_SLIDER, 2, 5);
+    addProcessPropertyDouble("mog_ratio", "Background Ratio", "Minimum weight of the background components", 0.7, IPL_WIDGET_SLIDER, 0.1, 1.0);
+    addProcessPropertyDouble("learning_rate", "Learning Rate", "", 0.02, IPL_WIDGET_SLIDER, 0.0, 0.5);
+    addProcessPropertyDouble("threshold", "Threshold", "Distance in standard deviations", 3.0, IPL_WIDGET_SLIDER, 0.5, 10.0);
+    addProcessPropertyInt("reset", "Reset", "", 0, IPL_WIDGET_BUTTON);
+}
+
+void IPLBackgroundSubtraction::destroy()
+{
+    delete _foreground;
+    delete _background;
+}
+
+/*!
+ * \brief IPLBackgroundSubtraction::reset allocates the model and the foreground mask
+ */
+void IPLBackgroundSubtraction::reset(IPLImage* image, int model, int components)
+{
+    _width          = image->width();
+    _height         = image->height();
+    _planes         = image->getNumberOfPlanes();
+    _type           = image->type() == IPL_IMAGE_BW ? IPL_IMAGE_GRAYSCALE : image->type();
+    _modelType      = model;
+    _components     = components;
+    _initialized    = false;
+
+    size_t pixels = (size_t) _width * _height;
+    if(model == 0)
+        _model.assign(2 * _planes * pixels, 0.0f);
+    else
+        _model.assign(pixels * components * (2 + _planes), 0.0f);
+
+    delete _foreground;
+    _foreground = new IPLImage(IPL_IMAGE_BW, _width, _height);
+    delete _background;
+    _background = NULL;
+}
+
+bool IPLBackgroundSubtraction::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    int model               = getProcessPropertyInt("model");
+    int components          = getProcessPropertyInt("mog_components");
+    float backgroundRatio   = getProcessPropertyDouble("mog_ratio");
+    float alpha             = getProcessPropertyDouble("learning_rate");
+    float threshold         = getProcessPropertyDouble("threshold");
+    int resetCounter        = getProcessPropertyInt("reset");
+
+    if(model != _modelType || (model == 1 && components != _components) || resetCounter != _resetCounter
+            || image->width() != _width || image->height() != _height
+            || image->getNumberOfPlanes() != _planes)
+    {
+        reset(image, model, components);
+        _resetCounter = resetCounter;
+    }
+
+    notifyProgressEventHandler(-1);
+
+    if(model == 0)
+        updateGaussian(image, alpha, threshold);
+    else
+        updateMixture(image, alpha, threshold, backgroundRatio);
+
+    _initialized = true;
+    _dirty = true;
+
+    return true;
+}
+
+/*!
+ * \brief IPLBackgroundSubtraction::updateGaussian classifies and learns with one Gaussian per pixel and plane
+ * The squared distances of all planes, normalized by the variances, are summed
+ * up per row and compared with threshold² times the number of planes.
+ * Foreground pixels are learned with a tenth of the learning rate, so moving
+ * objects do not blur into the background but stopped objects still do.
+ */
+void IPLBackgroundSubtraction::updateGaussian(IPLImage* image, float alpha, float threshold)
+{
+    int width = _width;
+    int height = _height;
+    int planes = _planes;
+    size_t pixels = (size_t) width * height;
+    float limit = threshold * threshold * planes;
+    bool initialized = _initialized;
+
+    float alphaForeground = alpha * FOREGROUND_RATE;
+
+    #pragma omp parallel
+    {
+        std::vector<float> distance(width);
+
+        #pragma omp for
+        for(int y = 0; y < height; y++)
+        {
+            std::fill(distance.begin(), distance.end(), 0.0f);
+            float* dist = &distance[0];
+            float* mask = &_foreground->plane(0)->p(0, y);
+
+            if(!initialized)
+            {
+                for(int p = 0; p < planes; p++)
+                {
+                    const float* in = &image->plane(p)->p(0, y);
+                    float* mean = &_model[p * pixels + (size_t) y * width];
+                    float* var = &_model[(planes + p) * pixels + (size_t) y * width];
+                    for(int x = 0; x < width; x++)
+                    {
+                        mean[x] = in[x];
+                        var[x] = INITIAL_VARIANCE;
+                    }
+                }
+                std::fill(mask, mask + width, 0.0f);
+                continue;
+            }
+
+            // classify, the row stays in the cache for the update
+            for(int p = 0; p < planes; p++)
+            {
+                const float* in = &image->plane(p)->p(0, y);
+                const float* mean = &_model[p * pixels + (size_t) y * width];
+                const float* var = &_model[(planes + p) * pixels + (size_t) y * width];
+                for(int x = 0; x < width; x++)
+                {
+                    float d = in[x] - mean[x];
+                    dist[x] += d * d / var[x];
+                }
+            }
+
+            for(int x = 0; x < width; x++)
+            {
+                mask[x] = dist[x] > limit ? 1.0f : 0.0f;
+                dist[x] = mask[x] > 0.0f ? alphaForeground : alpha;
+            }
+
+            // learn, foreground pixels slower
+            for(int p = 0; p < planes; p++)
+            {
+                const float* in = &image->plane(p)->p(0, y);
+                float* mean = &_model[p * pixels + (size_t) y * width];
+                float* var = &_model[(planes + p) * pixels + (size_t) y * width];
+                for(int x = 0; x < width; x++)
+                {
+                    float a = dist[x];
+                    float d = in[x] - mean[x];
+                    mean[x] += a * d;
+                    var[x] = std::max(var[x] + a * (d * d - var[x]), MIN_VARIANCE);
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLBackgroundSubtraction::updateMixture classifies and learns with K Gaussians per pixel
+ * The components of a pixel are kept sorted by weight / standard deviation.
+ * A pixel is background if it matches one of the first components whose
+ * weights sum up to the background ratio.
+ */
+void IPLBackgroundSubtraction::updateMixture(IPLImage* image, float alpha, float threshold, float backgroundRatio)
+{
+    int width = _width;
+    int height = _height;
+    int planes = _planes;
+    int K = _components;
+    int stride = 2 + planes;
+    float limit = threshold * threshold * planes;
+    bool initialized = _initialized;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* in[4];
+        for(int p = 0; p < planes && p < 4; p++)
+            in[p] = &image->plane(p)->p(0, y);
+        float* mask = &_foreground->plane(0)->p(0, y);
+        float pixel[4];
+        float tmp[2 + 4];
+
+        for(int x = 0; x < width; x++)
+        {
+            float* c = &_model[((size_t) y * width + x) * K * stride];
+            for(int p = 0; p < planes && p < 4; p++)
+                pixel[p] = in[p][x];
+
+            if(!initialized)
+            {
+                c[0] = 1.0f;
+                c[1] = INITIAL_VARIANCE;
+                for(int p = 0; p < planes && p < 4; p++)
+                    c[2 + p] = pixel[p];
+                mask[x] = 0.0f;
+                continue;
+            }
+
+            // first matching component and background decision
+            int matched = -1;
+            float matchedDistance = 0.0f;
+            float cumulative = 0.0f;
+            bool foreground = true;
+            for(int k = 0; k < K; k++)
+            {
+                float* component = c + k * stride;
+                if(component[0] <= 0.0f)
+                    break;
+
+                float d = 0.0f;
+                for(int p = 0; p < planes && p < 4; p++)
+                {
+                    float diff = pixel[p] - component[2 + p];
+                    d += diff * diff;
+                }
+                if(d < limit * component[1])
+                {
+                    matched = k;
+                    matchedDistance = d;
+                    foreground = cumulative > backgroundRatio;
+                    break;
+                }
+                cumulative += component[0];
+            }
+            mask[x] = foreground ? 1.0f : 0.0f;
+
+            // learn
+            float sum = 0.0f;
+            for(int k = 0; k < K; k++)
+            {
+                c[k * stride] *= (1.0f - alpha);
+                sum += c[k * stride];
+            }
+
+            int updated = matched;
+            if(matched >= 0)
+            {
+                float* component = c + matched * stride;
+                component[0] += alpha;
+                sum += alpha;
+                float rho = std::min(1.0f, alpha / component[0]);
+                for(int p = 0; p < planes && p < 4; p++)
+                    component[2 + p] += rho * (pixel[p] - component[2 + p]);
+                component[1] = std::max(component[1] + rho * (matchedDistance / planes - component[1]), MIN_VARIANCE);
+            }
+            else
+            {
+                // replace the least probable component
+                updated = K - 1;
+                float* component = c + updated * stride;
+                sum += alpha - component[0];
+                component[0] = alpha;
+                component[1] = INITIAL_VARIANCE;
+                for(int p = 0; p < planes && p < 4; p++)
+                    component[2 + p] = pixel[p];
+            }
+
+            if(sum > 0.0f)
+                for(int k = 0; k < K; k++)
+                    c[k * stride] /= sum;
+
+            // move the updated component to its rank
+            while(updated > 0)
+            {
+                float* a = c + (updated - 1) * stride;
+                float* b = c + updated * stride;
+                if(a[0] * a[0] / a[1] >= b[0] * b[0] / b[1])
+                    break;
+                std::copy(a, a + stride, tmp);
+                std::copy(b, b + stride, a);
+                std::copy(tmp, tmp + stride, b);
+                updated--;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLBackgroundSubtraction::getResultData returns the mask or fills the background image on request
+ */
+IPLData* IPLBackgroundSubtraction::getResultData(int index)
+{
+    if(index == 0 || !_initialized)
+        return index == 0 ? _foreground : _background;
+
+    if(!_dirty && _background)
+        return _background;
+
+    if(!_background)
+        _background = new IPLImage(_type, _width, _height);
+
+    int width = _width;
+    int height = _height;
+    int planes = std::min(_planes, _background->getNumberOfPlanes());
+    size_t pixels = (size_t) width * height;
+    int stride = 2 + _planes;
+    int K = _components;
+    int model = _modelType;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int p = 0; p < planes; p++)
+        {
+            float* out = &_background->plane(p)->p(0, y);
+            if(model == 0)
+            {
+                const float* mean = &_model[p * pixels + (size_t) y * width];
+                std::copy(mean, mean + width, out);
+            }
+            else
+            {
+                // mean of the most probable component
+                for(int x = 0; x < width; x++)
+                    out[x] = _model[((size_t) y * width + x) * K * stride + 2 + p];
+            }
+        }
+    }
+
+    _dirty = false;
+    return _background;
+}
@@ -19,36 +19,49 @@
 
 #include "IPLBlendImages.h"
 
-using namespace std;
-
-#define ChannelBlend_Normal(B,L)     (B)
-#define ChannelBlend_Lighten(B,L)    ((L > B) ? L:B)
-#define ChannelBlend_Darken(B,L)     ((L > B) ? B:L)
-#define ChannelBlend_Multiply(B,L)   ((B * L) / 1.0)
-#define ChannelBlend_Average(B,L)    ((B + L) / 2)
-#define ChannelBlend_Add(B,L)        (B + L)
-#define ChannelBlend_Subtract(B,L)   (B + L - 1.0)
-#define ChannelBlend_Difference(B,L) (abs(B - L))
-#define ChannelBlend_Negation(B,L)   (1.0 - abs(1.0 - B - L))
-#define ChannelBlend_Screen(B,L)     (1.0 - ((1.0 - B) * (1.0 - L)))
-#define ChannelBlend_Exclusion(B,L)  (B + L - 2 * B * L / 1.0)
-#define ChannelBlend_Overlay(B,L)    ((L < 0.5) ? (2 * B * L):(1.0 - 2 * (B - 0.5) * (1.0 - L)))
-//#define ChannelBlend_SoftLight(B,L)  ((L < 0.5)?(2*((B>>1)+64))*((float)L/1.0):(1.0-(2*(1.0-((B>>1)+64))*(float)(1.0-L)/1.0)))
-#define ChannelBlend_SoftLight(B,L)  (((1.0-L)*B*L)+ (L*ChannelBlend_Screen(B,L)))
-#define ChannelBlend_HardLight(B,L)  (ChannelBlend_Overlay(L,B))
-#define ChannelBlend_ColorDodge(B,L) (B/(1.0-L))
-#define ChannelBlend_ColorBurn(B,L)  (1-(1.0-B)/L)
-#define ChannelBlend_LinearDodge(B,L)(ChannelBlend_Add(B,L))
-#define ChannelBlend_LinearBurn(B,L) (ChannelBlend_Subtract(B,L))
-#define ChannelBlend_LinearLight(B,L)((L < 0.5)?ChannelBlend_LinearBurn(B,(2 * L)):ChannelBlend_LinearDodge(B,(2 * (L - 0.5))))
-#define ChannelBlend_VividLight(B,L) ((L < 0.5)?ChannelBlend_ColorBurn(B,(2 * L)):ChannelBlend_ColorDodge(B,(2 * (L - 0.5))))
-#define ChannelBlend_PinLight(B,L)   ((L < 0.5)?ChannelBlend_Darken(B,(2 * L)):ChannelBlend_Lighten(B,(2 * (L - 0.5))))
-#define ChannelBlend_HardMix(B,L)    ((ChannelBlend_VividLight(B,L) < 0.5) ? 0:1.0)
-#define ChannelBlend_Reflect(B,L)    ((L == 1.0) ? L:min(1.0, (B * B / (1.0 - L))))
-#define ChannelBlend_Glow(B,L)       (ChannelBlend_Reflect(L,B))
-#define ChannelBlend_Phoenix(B,L)    (min(B,L) - max(B,L) + 1.0)
-#define ChannelBlend_Alpha(B,L,O)    (B + (1.0 - O) * L)
-#define ChannelBlend_AlphaF(B,L,F,O) (ChannelBlend_Alpha(F(B,L),L,O))
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// one functor per blend mode, B is the base (A) and L the blend layer (B)
+// all modes are branch free so the row loops can be vectorized
+struct BlendNormal      { static inline float apply(float B, float)   { return B; } };
+struct BlendLighten     { static inline float apply(float B, float L) { return std::max(B, L); } };
+struct BlendDarken      { static inline float apply(float B, float L) { return std::min(B, L); } };
+struct BlendMultiply    { static inline float apply(float B, float L) { return B * L; } };
+struct BlendAverage     { static inline float apply(float B, float L) { return (B + L) * 0.5f; } };
+struct BlendAdd         { static inline float apply(float B, float L) { return B + L; } };
+struct BlendSubtract    { static inline float apply(float B, float L) { return B + L - 1.0f; } };
+struct BlendDifference  { static inline float apply(float B, float L) { return std::fabs(B - L); } };
+struct BlendNegation    { static inline float apply(float B, float L) { return 1.0f - std::fabs(1.0f - B - L); } };
+struct BlendScreen      { static inline float apply(float B, float L) { return 1.0f - (1.0f - B) * (1.0f - L); } };
+struct BlendExclusion   { static inline float apply(float B, float L) { return B + L - 2.0f * B * L; } };
+struct BlendOverlay     { static inline float apply(float B, float L) { return (L < 0.5f) ? 2.0f * B * L : 1.0f - 2.0f * (B - 0.5f) * (1.0f - L); } };
+struct BlendSoftLight   { static inline float apply(float B, float L) { return (1.0f - L) * B * L + L * BlendScreen::apply(B, L); } };
+struct BlendHardLight   { static inline float apply(float B, float L) { return BlendOverlay::apply(L, B); } };
+struct BlendColorDodge  { static inline float apply(float B, float L) { return B / (1.0f - L); } };
+struct BlendColorBurn   { static inline float apply(float B, float L) { return 1.0f - (1.0f - B) / L; } };
+struct BlendLinearLight { static inline float apply(float B, float L) { return (L < 0.5f) ? BlendSubtract::apply(B, 2.0f * L) : BlendAdd::apply(B, 2.0f * (L - 0.5f)); } };
+struct BlendVividLight  { static inline float apply(float B, float L) { return (L < 0.5f) ? BlendColorBurn::apply(B, 2.0f * L) : BlendColorDodge::apply(B, 2.0f * (L - 0.5f)); } };
+struct BlendPinLight    { static inline float apply(float B, float L) { return (L < 0.5f) ? BlendDarken::apply(B, 2.0f * L) : BlendLighten::apply(B, 2.0f * (L - 0.5f)); } };
+struct BlendHardMix     { static inline float apply(float B, float L) { return (BlendVividLight::apply(B, L) < 0.5f) ? 0.0f : 1.0f; } };
+struct BlendReflect     { static inline float apply(float B, float L) { return (L == 1.0f) ? L : std::min(1.0f, B * B / (1.0f - L)); } };
+struct BlendGlow        { static inline float apply(float B, float L) { return BlendReflect::apply(L, B); } };
+struct BlendPhoenix     { static inline float apply(float B, float L) { return std::min(B, L) - std::max(B, L) + 1.0f; } };
+
+template<class Mode>
+void blendRow(const float* a, const float* b, float* out, int n, float factorA, float factorB)
+{
+    for(int x = 0; x < n; x++)
+    {
+        float value = Mode::apply(factorA * a[x], factorB * b[x]);
+
+        // clamp to 0.0-1.0, NaN becomes 0.0
+        out[x] = std::min(1.0f, std::max(0.0f, value));
+    }
+}
+}
 
 void IPLBlendImages::init()
 {
@@ -81,168 +94,134 @@ void IPLBlendImages::init()
 void IPLBlendImages::destroy()
 {
     delete _result;
-    delete _inputA;
-    delete _inputB;
 }
 
-bool IPLBlendImages::processInputData(IPLData* data , int imageIndex, bool)
+/*!
+ * \brief IPLBlendImages::kernel returns the row kernel of a blend mode
+ */
+IPLBlendImages::RowKernel IPLBlendImages::kernel(int operation)
 {
-    IPLImage* image = data->toImage();
-	
-    // save the first image
-    if(imageIndex == 0)
+    switch(operation)
     {
-        delete _inputA;
-        _inputA = new IPLImage(*image);
+    case 1:  return &blendRow<BlendLighten>;
+    case 2:  return &blendRow<BlendDarken>;
+    case 3:  return &blendRow<BlendMultiply>;
+    case 4:  return &blendRow<BlendAverage>;
+    case 5:  return &blendRow<BlendAdd>;
+    case 6:  return &blendRow<BlendSubtract>;
+    case 7:  return &blendRow<BlendDifference>;
+    case 8:  return &blendRow<BlendNegation>;
+    case 9:  return &blendRow<BlendScreen>;
+    case 10: return &blendRow<BlendExclusion>;
+    case 11: return &blendRow<BlendOverlay>;
+    case 12: return &blendRow<BlendSoftLight>;
+    case 13: return &blendRow<BlendHardLight>;
+    case 14: return &blendRow<BlendColorDodge>;
+    case 15: return &blendRow<BlendColorBurn>;
+    case 16: return &blendRow<BlendAdd>;            // Linear Dodge
+    case 17: return &blendRow<BlendSubtract>;       // Linear Burn
+    case 18: return &blendRow<BlendLinearLight>;
+    case 19: return &blendRow<BlendVividLight>;
+    case 20: return &blendRow<BlendPinLight>;
+    case 21: return &blendRow<BlendHardMix>;
+    case 22: return &blendRow<BlendReflect>;
+    case 23: return &blendRow<BlendGlow>;
+    case 24: return &blendRow<BlendPhoenix>;
+    default: return &blendRow<BlendNormal>;
     }
+}
 
-    // save the second image
+bool IPLBlendImages::processInputData(IPLData* data , int imageIndex, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // only keep a reference, the inputs stay valid during the processing run
+    if(imageIndex == 0)
+        _inputA = image;
     if(imageIndex == 1)
-    {
-        delete _inputB;
-        _inputB = new IPLImage(*image);
-    }
+        _inputB = image;
 
-    // only continue if we have 2 valid inputs
+    // wait for the other input
     if(!(_inputA && _inputB))
     {
-        return false;
+        return true;
     }
 
-    // delete previous result
-    delete _result;
-    _result = NULL;
-
     // the result will be the max size of both inputs
-    int width  = std::max(_inputA->width(), _inputB->width());
-    int height = std::max(_inputA->height(), _inputB->height());
-
-    // copy constructor doesnt work:
-    // _result = new IPLImage(*image);
+    int widthA  = _inputA->width();
+    int heightA = _inputA->height();
+    int widthB  = _inputB->width();
+    int heightB = _inputB->height();
+    int width   = std::max(widthA, widthB);
+    int height  = std::max(heightA, heightB);
 
     // get properties
     _operation   = getProcessPropertyInt("operation");
     _factorA     = getProcessPropertyDouble("factorA");
     _factorB     = getProcessPropertyDouble("factorB");
 
-    int maxNrOfPlanes = std::max( _inputA->getNumberOfPlanes(), _inputB->getNumberOfPlanes());
-    int progress = 0;
-    int maxProgress = maxNrOfPlanes*height;
+    int planesA = _inputA->getNumberOfPlanes();
+    int planesB = _inputB->getNumberOfPlanes();
+    int maxNrOfPlanes = std::max(planesA, planesB);
 
     IPLDataType type = IPL_IMAGE_COLOR;
     if(maxNrOfPlanes == 1)
         type = IPL_IMAGE_GRAYSCALE;
 
-    // create result
-    _result = new IPLImage(type, width, height);
+    // reuse the result if possible
+    if(!_result || _result->type() != type || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        _result = new IPLImage(type, width, height);
+    }
+
+    notifyProgressEventHandler(-1);
+
+    RowKernel blend = kernel(_operation);
+    float factorA = (float) _factorA;
+    float factorB = (float) _factorB;
+
+    // pixels outside of an input are 0, so outside of the overlap the
+    // missing input is read from a row of zeros
+    std::vector<float> zeros(width, 0.0f);
+    const float* zero = &zeros[0];
 
     #pragma omp parallel for
-    for( int planeNr=0; planeNr < maxNrOfPlanes; planeNr++ )
+    for(int y = 0; y < height; y++)
     {
-        // prevent reading unavailable planes
-        IPLImagePlane* planeA   = _inputA->plane(std::min(planeNr, _inputA->getNumberOfPlanes()-1));
-        IPLImagePlane* planeB   = _inputB->plane(std::min(planeNr, _inputB->getNumberOfPlanes()-1));
-        IPLImagePlane* newplane = _result->plane(planeNr);
+        // valid pixels of both inputs in this row
+        int validA  = (y < heightA) ? widthA : 0;
+        int validB  = (y < heightB) ? widthB : 0;
+        int overlap = std::min(validA, validB);
+        int padding = std::max(validA, validB);
 
-        for(int y=0; y<height; y++)
+        for(int planeNr = 0; planeNr < maxNrOfPlanes; planeNr++)
         {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
-
-            for(int x=0; x<width; x++)
+            // prevent reading unavailable planes
+            IPLImagePlane* planeA = _inputA->plane(std::min(planeNr, planesA-1));
+            IPLImagePlane* planeB = _inputB->plane(std::min(planeNr, planesB-1));
+            const float* a = validA ? &planeA->p(0, y) : zero;
+            const float* b = validB ? &planeB->p(0, y) : zero;
+            float* out = &_result->plane(planeNr)->p(0, y);
+
+            // overlap
+            blend(a, b, out, overlap, factorA, factorB);
+
+            // only one input
+            if(padding > overlap)
             {
-                float valueA = _factorA * (float) planeA->cp(x,y);
-                float valueB = _factorB * (float) planeB->cp(x,y);
-                float value = 0.0f;
-
-                switch (_operation) {
-                case 1:
-                    value = ChannelBlend_Lighten(valueA, valueB);
-                    break;
-                case 2:
-                    value = ChannelBlend_Darken(valueA, valueB);
-                    break;
-                case 3:
-                    value = ChannelBlend_Multiply(valueA, valueB);
-                    break;
-                case 4:
-                    value = ChannelBlend_Average(valueA, valueB);
-                    break;
-                case 5:
-                    value = ChannelBlend_Add(valueA, valueB);
-                    break;
-                case 6:
-                    value = ChannelBlend_Subtract(valueA, valueB);
-                    break;
-                case 7:
-                    value = ChannelBlend_Difference(valueA, valueB);
-                    break;
-                case 8:
-                    value = ChannelBlend_Negation(valueA, valueB);
-                    break;
-                case 9:
-                    value = ChannelBlend_Screen(valueA, valueB);
-                    break;
-                case 10:
-                    value = ChannelBlend_Exclusion(valueA, valueB);
-                    break;
-                case 11:
-                    value = ChannelBlend_Overlay(valueA, valueB);
-                    break;
-                case 12:
-                    value = ChannelBlend_SoftLight(valueA, valueB);
-                    break;
-                case 13:
-                    value = ChannelBlend_HardLight(valueA, valueB);
-                    break;
-                case 14:
-                    value = ChannelBlend_ColorDodge(valueA, valueB);
-                    break;
-                case 15:
-                    value = ChannelBlend_ColorBurn(valueA, valueB);
-                    break;
-                case 16:
-                    value = ChannelBlend_LinearDodge(valueA, valueB);
-                    break;
-                case 17:
-                    value = ChannelBlend_LinearBurn(valueA, valueB);
-                    break;
-                case 18:
-                    value = ChannelBlend_LinearLight(valueA, valueB);
-                    break;
-                case 19:
-                    value = ChannelBlend_VividLight(valueA, valueB);
-                    break;
-                case 20:
-                    value = ChannelBlend_PinLight(valueA, valueB);
-                    break;
-                case 21:
-                    value = ChannelBlend_HardMix(valueA, valueB);
-                    break;
-                case 22:
-                    value = ChannelBlend_Reflect(valueA, valueB);
-                    break;
-                case 23:
-                    value = ChannelBlend_Glow(valueA, valueB);
-                    break;
-                case 24:
-                    value = ChannelBlend_Phoenix(valueA, valueB);
-                    break;
-                default:
-                    value = ChannelBlend_Normal(valueA, valueB);
-                    break;
-                }
-
-                // clamp to 0.0-1.0
-                value = min(1.0f, max(0.0f, value));
-                newplane->p(x,y) = value;
+                if(validA > validB)
+                    blend(a + overlap, zero, out + overlap, padding - overlap, factorA, factorB);
+                else
+                    blend(zero, b + overlap, out + overlap, padding - overlap, factorA, factorB);
             }
+
+            // no input
+            if(width > padding)
+                blend(zero, zero, out + padding, width - padding, factorA, factorB);
         }
     }
 
-    //_inputA = NULL;
-    //_inputB = NULL;
-
     return true;
 }
 
@@ -250,3 +229,21 @@ IPLImage* IPLBlendImages::getResultData( int )
 {
     return _result;
 }
+
+/*!
+ * \brief IPLBlendImages::beforeProcessing drops the input references of an aborted run
+ */
+void IPLBlendImages::beforeProcessing()
+{
+    _inputA = NULL;
+    _inputB = NULL;
+}
+
+/*!
+ * \brief IPLBlendImages::afterProcessing drops the input references, they may change before the next run
+ */
+void IPLBlendImages::afterProcessing()
+{
+    _inputA = NULL;
+    _inputB = NULL;
+}
@@ -0,0 +1,152 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLBoxFilter.h"
+
+#include <cmath>
+#include <algorithm>
+
+void IPLBoxFilter::init()
+{
+    // init
+    _result     = NULL;
+
+    // basic settings
+    setClassName("IPLBoxFilter");
+    setTitle("Box Filter");
+    setCategory(IPLProcess::CATEGORY_LOCALOPERATIONS);
+    setKeywords("mean, average, sum, variance, standard deviation, integral image");
+    setDescription("Local sum, mean, variance or standard deviation over a rectangular window, read from an "
+                   "integral image in constant time for any window size. Variance and standard deviation "
+                   "need the squared sum of the integral image.");
+
+    // inputs and outputs
+    addInput("Integral Image", IPL_INTEGRAL_IMAGE);
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("mode", "Output:Mean|Sum|Variance|Standard Deviation", "", MODE_MEAN, IPL_WIDGET_COMBOBOX);
+    addProcessPropertyInt("window_x", "Window Width", "", 5, IPL_WIDGET_SLIDER_ODD, 1, 255);
+    addProcessPropertyInt("window_y", "Window Height", "", 5, IPL_WIDGET_SLIDER_ODD, 1, 255);
+}
+
+void IPLBoxFilter::destroy()
+{
+    delete _result;
+}
+
+bool IPLBoxFilter::processInputData(IPLData* data, int, bool)
+{
+    IPLIntegralImage* integral = data->toIntegralImage();
+    if(!integral)
+    {
+        addError("Input must be an integral image.");
+        return false;
+    }
+
+    // get properties
+    int mode    = getProcessPropertyInt("mode");
+    int windowX = getProcessPropertyInt("window_x");
+    int windowY = getProcessPropertyInt("window_y");
+
+    if((mode == MODE_VARIANCE || mode == MODE_DEVIATION) && !integral->hasSquaredSum())
+    {
+        addError("Variance needs the squared sum, enable it in the Integral Image process.");
+        return false;
+    }
+
+    int width = integral->width();
+    int height = integral->height();
+    IPLDataType type = integral->planes() == 3 ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE;
+
+    // reuse the result if possible
+    if(!_result || _result->type() != type || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        _result = new IPLImage(type, width, height);
+    }
+
+    notifyProgressEventHandler(-1);
+
+    filter(integral, _result, mode, windowX, windowY);
+
+    return true;
+}
+
+IPLData* IPLBoxFilter::getResultData(int)
+{
+    return _result;
+}
+
+/*!
+ * \brief IPLBoxFilter::filter evaluates a windowX x windowY window around every pixel
+ * result must have the size of the integral image.
+ */
+void IPLBoxFilter::filter(IPLIntegralImage* integral, IPLImage* result, int mode, int windowX, int windowY)
+{
+    int width  = integral->width();
+    int height = integral->height();
+    int planes = std::min(integral->planes(), result->getNumberOfPlanes());
+    int rx = windowX / 2;
+    int ry = windowY / 2;
+    bool squared = (mode == MODE_VARIANCE || mode == MODE_DEVIATION);
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        int y0 = std::max(0, y - ry);
+        int y1 = std::min(height, y + ry + 1);
+
+        for(int p = 0; p < planes; p++)
+        {
+            const double* top    = integral->sumRow(p, y0);
+            const double* bottom = integral->sumRow(p, y1);
+            const double* top2   = squared ? integral->squaredSumRow(p, y0) : NULL;
+            const double* bottom2= squared ? integral->squaredSumRow(p, y1) : NULL;
+            float* out = &result->plane(p)->p(0, y);
+
+            for(int x = 0; x < width; x++)
+            {
+                int x0 = std::max(0, x - rx);
+                int x1 = std::min(width, x + rx + 1);
+                double count = (double) (x1 - x0) * (y1 - y0);
+                double sum = bottom[x1] - bottom[x0] - top[x1] + top[x0];
+
+                double value;
+                if(mode == MODE_SUM)
+                {
+                    value = sum;
+                }
+                else if(!squared)
+                {
+                    value = sum / count;
+                }
+                else
+                {
+                    double mean = sum / count;
+                    double sum2 = bottom2[x1] - bottom2[x0] - top2[x1] + top2[x0];
+                    value = std::max(0.0, sum2 / count - mean * mean);
+                    if(mode == MODE_DEVIATION)
+                        value = std::sqrt(value);
+                }
+                out[x] = (float) value;
+            }
+        }
+    }
+}
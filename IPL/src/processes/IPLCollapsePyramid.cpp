@@ -0,0 +1,257 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLCollapsePyramid.h"
+#include "IPLGaussianPyramid.h"
+
+#include <algorithm>
+
+void IPLCollapsePyramid::init()
+{
+    // init
+    _result     = NULL;
+    _inputA     = NULL;
+    _inputB     = NULL;
+    _mask       = NULL;
+
+    // basic settings
+    setClassName("IPLCollapsePyramid");
+    setTitle("Collapse Pyramid");
+    setCategory(IPLProcess::CATEGORY_GEOMETRY);
+    setKeywords("multiscale, multiband blending");
+    setDescription("Reconstructs an image from a Laplacian pyramid. If Pyramid B and a mask are connected, "
+                   "the pyramids are blended with a Gaussian pyramid of the mask first: "
+                   "white mask pixels take Pyramid A, black ones Pyramid B.");
+
+    // inputs and outputs
+    addInput("Pyramid A", IPL_PYRAMID);
+    addInput("Pyramid B", IPL_PYRAMID);
+    addInput("Mask", IPL_IMAGE_GRAYSCALE);
+    addOutput("Image", IPL_IMAGE_COLOR);
+}
+
+void IPLCollapsePyramid::destroy()
+{
+    delete _result;
+}
+
+bool IPLCollapsePyramid::processInputData(IPLData* data, int index, bool)
+{
+    // save the inputs
+    if(index == 0 || index == 1)
+    {
+        IPLPyramid* pyramid = data->toPyramid();
+        if(!pyramid || pyramid->levels() == 0)
+        {
+            addError("Invalid pyramid.");
+            return false;
+        }
+
+        if(index == 0)
+            _inputA = pyramid;
+        else
+            _inputB = pyramid;
+    }
+    else if(index == 2)
+    {
+        IPLImage* mask = data->toImage();
+        if(!mask)
+        {
+            addError("Invalid mask.");
+            return false;
+        }
+        _mask = mask;
+    }
+
+    // wait until all connected inputs of this run have arrived
+    if(!_inputA
+            || (inputs()->at(1).occupied && !_inputB)
+            || (inputs()->at(2).occupied && !_mask))
+    {
+        return true;
+    }
+
+    // delete previous result
+    delete _result;
+    _result = NULL;
+
+    if(!_inputA->isLaplacian())
+        addWarning("Pyramid A is a Gaussian pyramid, only level 0 is used.");
+
+    notifyProgressEventHandler(-1);
+
+    if(_inputB && _mask)
+    {
+        if(!_inputA->isLaplacian() || !_inputB->isLaplacian())
+        {
+            addError("Blending needs two Laplacian pyramids.");
+            return false;
+        }
+
+        IPLImage* a = _inputA->level(0);
+        IPLImage* b = _inputB->level(0);
+        if(a->width() != b->width() || a->height() != b->height()
+                || a->width() != _mask->width() || a->height() != _mask->height())
+        {
+            addError("Pyramid A, Pyramid B and the mask need the same size.");
+            return false;
+        }
+
+        if(_inputA->levels() != _inputB->levels())
+        {
+            addError("Pyramid A and Pyramid B need the same number of levels.");
+            return false;
+        }
+
+        IPLPyramid* blended = IPLCollapsePyramid::blend(_inputA, _inputB, _mask);
+        _result = IPLCollapsePyramid::collapse(blended);
+        delete blended;
+    }
+    else
+    {
+        _result = IPLCollapsePyramid::collapse(_inputA);
+    }
+
+    return true;
+}
+
+IPLData* IPLCollapsePyramid::getResultData(int)
+{
+    return _result;
+}
+
+/*!
+ * \brief IPLCollapsePyramid::beforeProcessing drops the input references of an aborted run
+ */
+void IPLCollapsePyramid::beforeProcessing()
+{
+    _inputA = NULL;
+    _inputB = NULL;
+    _mask = NULL;
+}
+
+/*!
+ * \brief IPLCollapsePyramid::afterProcessing drops the input references, they may change before the next run
+ */
+void IPLCollapsePyramid::afterProcessing()
+{
+    _inputA = NULL;
+    _inputB = NULL;
+    _mask = NULL;
+}
+
+/*!
+ * \brief IPLCollapsePyramid::collapse expands and adds all levels, starting at the residual
+ * Gaussian pyramids return a copy of level 0. The result is clamped to 0.0-1.0.
+ */
+IPLImage* IPLCollapsePyramid::collapse(IPLPyramid* pyramid)
+{
+    int levels = pyramid->levels();
+    if(!pyramid->isLaplacian())
+        return new IPLImage(*pyramid->level(0));
+
+    IPLImage* image = new IPLImage(*pyramid->level(levels-1));
+    for(int i = levels-2; i >= 0; i--)
+    {
+        IPLImage* band = pyramid->level(i);
+        IPLImage* expanded = new IPLImage(band->type(), band->width(), band->height());
+        IPLGaussianPyramid::expand(image, expanded);
+        delete image;
+
+        int width = band->width();
+        int nrOfPlanes = std::min(band->getNumberOfPlanes(), expanded->getNumberOfPlanes());
+        for(int planeNr = 0; planeNr < nrOfPlanes; planeNr++)
+        {
+            IPLImagePlane* bandPlane = band->plane(planeNr);
+            IPLImagePlane* expandedPlane = expanded->plane(planeNr);
+
+            #pragma omp parallel for
+            for(int y = 0; y < band->height(); y++)
+            {
+                const ipl_basetype* in = &bandPlane->p(0, y);
+                ipl_basetype* out = &expandedPlane->p(0, y);
+                for(int x = 0; x < width; x++)
+                    out[x] += in[x];
+            }
+        }
+        image = expanded;
+    }
+
+    // blended pyramids may overshoot
+    for(int planeNr = 0; planeNr < image->getNumberOfPlanes(); planeNr++)
+    {
+        IPLImagePlane* plane = image->plane(planeNr);
+        int width = image->width();
+
+        #pragma omp parallel for
+        for(int y = 0; y < image->height(); y++)
+        {
+            ipl_basetype* out = &plane->p(0, y);
+            for(int x = 0; x < width; x++)
+                out[x] = std::max(0.0f, std::min(1.0f, out[x]));
+        }
+    }
+
+    return image;
+}
+
+/*!
+ * \brief IPLCollapsePyramid::blend combines two Laplacian pyramids level by level
+ * L(i) = M(i) * A(i) + (1 - M(i)) * B(i), M is the Gaussian pyramid of the mask.
+ * A single plane mask is applied to all planes.
+ */
+IPLPyramid* IPLCollapsePyramid::blend(IPLPyramid* a, IPLPyramid* b, IPLImage* mask)
+{
+    IPLPyramid* maskPyramid = IPLGaussianPyramid::build(mask, a->levels());
+    IPLPyramid* pyramid = new IPLPyramid(true);
+
+    for(int i = 0; i < a->levels(); i++)
+    {
+        IPLImage* levelA = a->level(i);
+        IPLImage* levelB = b->level(i);
+        IPLImage* levelMask = maskPyramid->level(std::min(i, maskPyramid->levels()-1));
+
+        int nrOfPlanes = std::max(levelA->getNumberOfPlanes(), levelB->getNumberOfPlanes());
+        IPLImage* level = new IPLImage(nrOfPlanes > 1 ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE, levelA->width(), levelA->height());
+        int width = level->width();
+
+        for(int planeNr = 0; planeNr < level->getNumberOfPlanes(); planeNr++)
+        {
+            IPLImagePlane* planeA = levelA->plane(std::min(planeNr, levelA->getNumberOfPlanes()-1));
+            IPLImagePlane* planeB = levelB->plane(std::min(planeNr, levelB->getNumberOfPlanes()-1));
+            IPLImagePlane* planeMask = levelMask->plane(std::min(planeNr, levelMask->getNumberOfPlanes()-1));
+            IPLImagePlane* plane = level->plane(planeNr);
+
+            #pragma omp parallel for
+            for(int y = 0; y < level->height(); y++)
+            {
+                const ipl_basetype* inA = &planeA->p(0, y);
+                const ipl_basetype* inB = &planeB->p(0, y);
+                const ipl_basetype* m   = &planeMask->p(0, y);
+                ipl_basetype* out = &plane->p(0, y);
+                for(int x = 0; x < width; x++)
+                    out[x] = inB[x] + m[x] * (inA[x] - inB[x]);
+            }
+        }
+        pyramid->addLevel(level);
+    }
+
+    delete maskPyramid;
+    return pyramid;
+}
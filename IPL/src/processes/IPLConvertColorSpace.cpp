@@ -0,0 +1,74 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLConvertColorSpace.h"
+
+void IPLConvertColorSpace::init()
+{
+    // init
+    _result     = NULL;
+
+    // basic settings
+    setClassName("IPLConvertColorSpace");
+    setTitle("Convert Color Space");
+    setKeywords("RGB, sRGB, linear, HSV, HSL, Lab, YCbCr, XYZ");
+    setDescription("Converts the planes of a color image from one color space to another. "
+                   "All color spaces are scaled to 0..1, Lab is stored as L/100, (a+128)/255, (b+128)/255.");
+    setCategory(IPLProcess::CATEGORY_CONVERSIONS);
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("from", "From:RGB|Linear RGB|HSV|HSL|Lab|YCbCr|XYZ", "", IPLColorConversion::RGB, IPL_WIDGET_COMBOBOX, 0, 6);
+    addProcessPropertyInt("to", "To:RGB|Linear RGB|HSV|HSL|Lab|YCbCr|XYZ", "", IPLColorConversion::HSV, IPL_WIDGET_COMBOBOX, 0, 6);
+}
+
+void IPLConvertColorSpace::destroy()
+{
+    delete _result;
+}
+
+bool IPLConvertColorSpace::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // delete previous result
+    delete _result;
+    _result = NULL;
+
+    int from = getProcessPropertyInt("from");
+    int to = getProcessPropertyInt("to");
+
+    if(image->getNumberOfPlanes() < 3 && from != IPLColorConversion::RGB)
+        addWarning("The input has only one plane, it is treated as gray RGB image.");
+
+    notifyProgressEventHandler(-1);
+
+    _result = new IPLImage(IPL_IMAGE_COLOR, image->width(), image->height());
+    IPLColorConversion::convert(image, _result, from, to);
+
+    return true;
+}
+
+IPLImage* IPLConvertColorSpace::getResultData(int)
+{
+    return _result;
+}
@@ -48,27 +48,12 @@ bool IPLConvertToColor::processInputData(IPLData* data, int, bool)
     delete _result;
     _result = NULL;
 
-    int width = image->width();
-    int height = image->height();
+    notifyProgressEventHandler(-1);
 
-    int progress = 0;
-    int maxProgress = image->height();
-
-    _result = new IPLImage( IPL_IMAGE_COLOR, width, height );
-
-    for(int y=0; y<height; y++)
-    {
-        // progress
-        notifyProgressEventHandler(100*progress++/maxProgress);
-
-        for(int x=0; x<width; x++)
-        {
-            ipl_basetype value = image->plane(0)->p(x, y);
-            _result->plane(0)->p(x, y) = value;
-            _result->plane(1)->p(x, y) = value;
-            _result->plane(2)->p(x, y) = value;
-        }
-    }
+    // every plane gets its own copy: processes write planes independently
+    _result = new IPLImage(IPL_IMAGE_COLOR, image->width(), image->height());
+    for(int planeNr = 0; planeNr < _result->getNumberOfPlanes(); planeNr++)
+        *_result->plane(planeNr) = *image->plane(0);
 
     return true;
 }
@@ -58,84 +58,16 @@ bool IPLConvertToGray::processInputData(IPLData* data, int, bool)
     int width = image->width();
     int height = image->height();
 
-    IPLImagePlane* plane;
-    IPLImagePlane* newplane;
-    IPLImagePlane* red;
-    IPLImagePlane* green;
-    IPLImagePlane* blue;
-
     // properties
     double weight_r = getProcessPropertyDouble("weight_r");
     double weight_g = getProcessPropertyDouble("weight_g");
     double weight_b = getProcessPropertyDouble("weight_b");
 
-    int progress = 0;
-    int maxProgress = image->height();
-
-    switch( image->type() )
-    {
-    case IPL_IMAGE_BW:
-        _result = new IPLImage( IPL_IMAGE_GRAYSCALE, width, height );
-        plane = image->plane( 0 );
-        newplane = _result->plane( 0 );
-
-        for(int y=0; y<height; y++)
-        {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
-
-            for(int x=0; x<width; x++)
-            {
-                newplane->p(x,y) = plane->p(x,y);
-            }
-        }
-        break;
-    case IPL_IMAGE_GRAYSCALE:
-        _result = new IPLImage( IPL_IMAGE_GRAYSCALE, width, height );
-        plane = image->plane( 0 );
-        newplane = _result->plane( 0 );
-
-        for(int y=0; y<height; y++)
-        {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
-
-            for(int x=0; x<width; x++)
-            {
-                newplane->p(x,y) = plane->p(x,y);
-            }
-        }
-        break;
-    case IPL_IMAGE_COLOR:
-        _result = new IPLImage( IPL_IMAGE_GRAYSCALE, width, height );
-        newplane = _result->plane( 0 );
-        red = image->plane( 0 );
-        green = image->plane( 1 );
-        blue = image->plane( 2 );
-        //unsigned char r, b, g;
-
-        for(int y=0; y<height; y++)
-        {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
+    notifyProgressEventHandler(-1);
 
-            for(int x=0; x<width; x++)
-            {
-                //r = red->p(x,y);
-                //g = green->p(x,y);
-                //b = blue->p(x,y);
-                //unsigned char pixel = HIBYTE(red->p(x,y) * 77 + green->p(x,y) * 151 + blue->p(x,y) * 28); //!< Fast
-                //unsigned char pixel = (unsigned char) (0.2125 * red->p(x,y)) + (0.7154 * green->p(x,y)) + (0.0721 * blue->p(x,y)); //!< Slower
-                //unsigned char pixel = (unsigned char) ((r+r+r+b+g+g+g+g)>>3); //!< Even Faster
-                //ipl_basetype pixel = (0.2125f * red->p(x,y)) + (0.7154f * green->p(x,y)) + (0.0721f * blue->p(x,y)); //!< Slower
-                ipl_basetype pixel = (weight_r * red->p(x,y)) + (weight_g * green->p(x,y)) + (weight_b * blue->p(x,y)); //!< Slower
-                pixel = (pixel > 1.0) ? 1.0 : pixel;
-                pixel = (pixel < 0.0) ? 0.0 : pixel;
-                newplane->p(x,y) = pixel;
-            }
-        }
-        break;
-    }
+    // binary and gray-scale images are copied
+    _result = new IPLImage( IPL_IMAGE_GRAYSCALE, width, height );
+    IPLColorConversion::gray(image, _result, weight_r, weight_g, weight_b);
 
     return true;
 }
@@ -0,0 +1,246 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLDemosaic.h"
+
+#include <algorithm>
+
+namespace
+{
+//! color filter sites, GR is green in a red row, GB green in a blue row
+enum Site
+{
+    SITE_R = 0,
+    SITE_GR,
+    SITE_GB,
+    SITE_B
+};
+
+/*!
+ * \brief The Bilinear struct averages the nearest samples of the missing colors
+ */
+struct Bilinear
+{
+    template<int SITE>
+    static inline void apply(const float* p, int s, float& r, float& g, float& b)
+    {
+        float c = p[0];
+        if(SITE == SITE_R || SITE == SITE_B)
+        {
+            float cross = (p[-s] + p[s] + p[-1] + p[1]) * 0.25f;
+            float diagonal = (p[-s-1] + p[-s+1] + p[s-1] + p[s+1]) * 0.25f;
+            g = cross;
+            r = SITE == SITE_R ? c : diagonal;
+            b = SITE == SITE_R ? diagonal : c;
+        }
+        else
+        {
+            float horizontal = (p[-1] + p[1]) * 0.5f;
+            float vertical = (p[-s] + p[s]) * 0.5f;
+            g = c;
+            r = SITE == SITE_GR ? horizontal : vertical;
+            b = SITE == SITE_GR ? vertical : horizontal;
+        }
+    }
+};
+
+/*!
+ * \brief The Malvar struct implements the gradient-corrected 5x5 filters of Malvar, He and Cutler
+ */
+struct Malvar
+{
+    template<int SITE>
+    static inline void apply(const float* p, int s, float& r, float& g, float& b)
+    {
+        float c = p[0];
+        float cross = p[-s] + p[s] + p[-1] + p[1];
+        float cross2 = p[-2*s] + p[2*s] + p[-2] + p[2];
+        float diagonal = p[-s-1] + p[-s+1] + p[s-1] + p[s+1];
+        if(SITE == SITE_R || SITE == SITE_B)
+        {
+            float green = (4.0f*c + 2.0f*cross - cross2) * 0.125f;
+            float other = (6.0f*c + 2.0f*diagonal - 1.5f*cross2) * 0.125f;
+            g = green;
+            r = SITE == SITE_R ? c : other;
+            b = SITE == SITE_R ? other : c;
+        }
+        else
+        {
+            float horizontal2 = p[-2] + p[2];
+            float vertical2 = p[-2*s] + p[2*s];
+            float horizontal = (5.0f*c + 4.0f*(p[-1] + p[1]) - horizontal2 + 0.5f*vertical2 - diagonal) * 0.125f;
+            float vertical = (5.0f*c + 4.0f*(p[-s] + p[s]) - vertical2 + 0.5f*horizontal2 - diagonal) * 0.125f;
+            g = c;
+            r = SITE == SITE_GR ? horizontal : vertical;
+            b = SITE == SITE_GR ? vertical : horizontal;
+        }
+    }
+};
+
+typedef void (*RowKernel)(const float*, int, float*, float*, float*, int);
+
+//! one row with EVEN sites at even and ODD sites at odd columns
+template<class Method, int EVEN, int ODD>
+void demosaicRow(const float* p, int s, float* r, float* g, float* b, int width)
+{
+    int x = 0;
+    for(; x + 1 < width; x += 2)
+    {
+        Method::template apply<EVEN>(p + x, s, r[x], g[x], b[x]);
+        Method::template apply<ODD>(p + x + 1, s, r[x+1], g[x+1], b[x+1]);
+    }
+    if(x < width)
+        Method::template apply<EVEN>(p + x, s, r[x], g[x], b[x]);
+
+    for(x = 0; x < width; x++)
+    {
+        r[x] = std::min(1.0f, std::max(0.0f, r[x]));
+        g[x] = std::min(1.0f, std::max(0.0f, g[x]));
+        b[x] = std::min(1.0f, std::max(0.0f, b[x]));
+    }
+}
+
+//! the four row types: R G, G R, G B, B G
+template<class Method>
+RowKernel rowKernel(int row)
+{
+    switch(row)
+    {
+    case 0:     return demosaicRow<Method, SITE_R, SITE_GR>;
+    case 1:     return demosaicRow<Method, SITE_GR, SITE_R>;
+    case 2:     return demosaicRow<Method, SITE_GB, SITE_B>;
+    default:    return demosaicRow<Method, SITE_B, SITE_GB>;
+    }
+}
+
+//! mirrors i into 0..n-1 without repeating the border pixel, keeps the Bayer phase
+inline int reflect(int i, int n)
+{
+    if(i < 0)
+        i = -i;
+    if(i >= n)
+        i = 2*(n-1) - i;
+    return std::min(n-1, std::max(0, i));
+}
+}
+
+void IPLDemosaic::init()
+{
+    // init
+    _result     = NULL;
+
+    // basic settings
+    setClassName("IPLDemosaic");
+    setTitle("Demosaic");
+    setCategory(IPLProcess::CATEGORY_CONVERSIONS);
+    setKeywords("Bayer, debayer, RAW, sensor, color filter array, CFA");
+    setDescription("Interpolates a color image from a Bayer mosaic (single plane sensor image), bilinear or "
+                   "with the gradient-corrected filters of Malvar, He and Cutler. Load 16 bit sensor dumps "
+                   "with Load Image in RAW mode.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_GRAYSCALE);
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("pattern", "Pattern:RGGB|BGGR|GRBG|GBRG", "Colors of the top left 2x2 pixels",
+                          PATTERN_RGGB, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("method", "Method:Bilinear|Malvar-He-Cutler", "", METHOD_MALVAR, IPL_WIDGET_RADIOBUTTONS);
+}
+
+void IPLDemosaic::destroy()
+{
+    delete _result;
+}
+
+bool IPLDemosaic::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    int pattern = getProcessPropertyInt("pattern");
+    int method  = getProcessPropertyInt("method");
+
+    int width = image->width();
+    int height = image->height();
+
+    // reuse the result if possible
+    if(!_result || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        _result = new IPLImage(IPL_IMAGE_COLOR, width, height);
+    }
+
+    notifyProgressEventHandler(-1);
+
+    demosaic(image, _result, pattern, method);
+
+    return true;
+}
+
+IPLData* IPLDemosaic::getResultData(int)
+{
+    return _result;
+}
+
+/*!
+ * \brief IPLDemosaic::demosaic interpolates the first plane of mosaic into the color image result
+ */
+void IPLDemosaic::demosaic(IPLImage* mosaic, IPLImage* result, int pattern, int method)
+{
+    int width = mosaic->width();
+    int height = mosaic->height();
+
+    // row types of even and odd rows
+    static const int rows[4][2] = { {0, 2}, {3, 1}, {1, 3}, {2, 0} };
+    RowKernel kernels[2];
+    for(int i = 0; i < 2; i++)
+    {
+        int row = rows[std::min(3, std::max(0, pattern))][i];
+        kernels[i] = method == METHOD_BILINEAR ? rowKernel<Bilinear>(row) : rowKernel<Malvar>(row);
+    }
+
+    // copy with 2 mirrored pixels on every side
+    const int border = 2;
+    int pitch = width + 2*border;
+    std::vector<float> padded((size_t) pitch * (height + 2*border));
+    #pragma omp parallel for
+    for(int y = -border; y < height + border; y++)
+    {
+        const float* in = &mosaic->plane(0)->p(0, reflect(y, height));
+        float* out = &padded[(size_t) (y + border) * pitch + border];
+        std::copy(in, in + width, out);
+        for(int x = 1; x <= border; x++)
+        {
+            out[-x] = in[reflect(-x, width)];
+            out[width-1 + x] = in[reflect(width-1 + x, width)];
+        }
+    }
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* p = &padded[(size_t) (y + border) * pitch + border];
+        kernels[y % 2](p, pitch,
+                       &result->plane(0)->p(0, y),
+                       &result->plane(1)->p(0, y),
+                       &result->plane(2)->p(0, y),
+                       width);
+    }
+}
@@ -0,0 +1,272 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLDistanceTransform.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace
+{
+/*!
+ * \brief squaredDistance1D is the 1D squared distance transform of f with n samples
+ * Lower envelope of parabolas (Felzenszwalb and Huttenlocher), v and z are work buffers
+ */
+void squaredDistance1D(const float* f, float* d, int n, int* v, double* z)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+
+    for(int q = 1; q < n; q++)
+    {
+        double s = ((f[q] + (double) q*q) - (f[v[k]] + (double) v[k]*v[k])) / (2.0 * (q - v[k]));
+        while(s <= z[k])
+        {
+            k--;
+            s = ((f[q] + (double) q*q) - (f[v[k]] + (double) v[k]*v[k])) / (2.0 * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k+1] = INF;
+    }
+
+    k = 0;
+    for(int q = 0; q < n; q++)
+    {
+        while(z[k+1] < q)
+            k++;
+        double dq = q - v[k];
+        d[q] = (float) (dq*dq + f[v[k]]);
+    }
+}
+}
+
+void IPLDistanceTransform::init()
+{
+    // init
+    _distance   = NULL;
+    _seeds      = NULL;
+
+    // basic settings
+    setClassName("IPLDistanceTransform");
+    setTitle("Distance Transform");
+    setCategory(IPLProcess::CATEGORY_OBJECTS);
+    setKeywords("euclidean distance, seeds, markers, watershed");
+    setDescription("Euclidean distance of every foreground pixel to the background, normalized by the maximum "
+                   "distance. The seeds are labeled regions around the object centers, they can be used "
+                   "as markers for the Watershed process.");
+
+    // inputs and outputs
+    addInput("Binary Image", IPL_IMAGE_BW);
+    addOutput("Distance", IPL_IMAGE_GRAYSCALE);
+    addOutput("Seeds", IPL_IMAGE_GRAYSCALE);
+
+    // properties
+    addProcessPropertyDouble("seed_level", "Seed Level", "Seeds are the regions with at least this fraction of the maximum distance of their object",
+                             0.7, IPL_WIDGET_SLIDER, 0.0, 1.0);
+}
+
+void IPLDistanceTransform::destroy()
+{
+    delete _distance;
+    delete _seeds;
+}
+
+bool IPLDistanceTransform::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    float seedLevel = getProcessPropertyDouble("seed_level");
+
+    int width = image->width();
+    int height = image->height();
+    size_t pixels = (size_t) width * height;
+
+    notifyProgressEventHandler(-1);
+
+    std::vector<unsigned char> mask(pixels);
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* in = &image->plane(0)->p(0, y);
+        unsigned char* m = &mask[(size_t) y * width];
+        for(int x = 0; x < width; x++)
+            m[x] = in[x] > 0.5f;
+    }
+
+    std::vector<float> dist;
+    distance(mask, width, height, dist);
+
+    // maximum distance of every object
+    std::vector<int> objects;
+    int objectCount = labelComponents(mask, width, height, objects);
+    std::vector<float> objectMax(objectCount + 1, 0.0f);
+    float maxDistance = 0.0f;
+    for(size_t i = 0; i < pixels; i++)
+    {
+        objectMax[objects[i]] = std::max(objectMax[objects[i]], dist[i]);
+        maxDistance = std::max(maxDistance, dist[i]);
+    }
+
+    // seeds around the centers of the objects
+    std::vector<unsigned char> seedMask(pixels);
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int x = 0; x < width; x++)
+        {
+            size_t i = (size_t) y * width + x;
+            seedMask[i] = mask[i] && dist[i] >= seedLevel * objectMax[objects[i]];
+        }
+    }
+    std::vector<int> seeds;
+    int seedCount = labelComponents(seedMask, width, height, seeds);
+
+    delete _distance;
+    delete _seeds;
+    _distance = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+    _seeds = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+
+    float distanceScale = maxDistance > 0.0f ? 1.0f / maxDistance : 0.0f;
+    float seedScale = seedCount > 0 ? 1.0f / seedCount : 0.0f;
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        float* d = &_distance->plane(0)->p(0, y);
+        float* s = &_seeds->plane(0)->p(0, y);
+        for(int x = 0; x < width; x++)
+        {
+            size_t i = (size_t) y * width + x;
+            d[x] = dist[i] * distanceScale;
+            s[x] = seeds[i] * seedScale;
+        }
+    }
+
+    std::stringstream s;
+    s << "Seeds: " << seedCount << ", maximum distance: " << maxDistance;
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLData* IPLDistanceTransform::getResultData(int index)
+{
+    if(index == 0)
+        return _distance;
+    return _seeds;
+}
+
+/*!
+ * \brief IPLDistanceTransform::distance computes the Euclidean distance of the mask pixels to the closest 0 pixel
+ * Pixels outside of the image do not count as background.
+ */
+void IPLDistanceTransform::distance(const std::vector<unsigned char>& mask, int width, int height, std::vector<float>& result)
+{
+    const float INF = 1e20f;
+    result.resize((size_t) width * height);
+
+    // columns
+    #pragma omp parallel
+    {
+        int n = std::max(width, height);
+        std::vector<float> f(n), d(n);
+        std::vector<double> z(n + 1);
+        std::vector<int> v(n);
+
+        #pragma omp for
+        for(int x = 0; x < width; x++)
+        {
+            for(int y = 0; y < height; y++)
+                f[y] = mask[(size_t) y * width + x] ? INF : 0.0f;
+            squaredDistance1D(&f[0], &d[0], height, &v[0], &z[0]);
+            for(int y = 0; y < height; y++)
+                result[(size_t) y * width + x] = d[y];
+        }
+    }
+
+    // rows
+    #pragma omp parallel
+    {
+        std::vector<float> d(width);
+        std::vector<double> z(width + 1);
+        std::vector<int> v(width);
+
+        #pragma omp for
+        for(int y = 0; y < height; y++)
+        {
+            float* row = &result[(size_t) y * width];
+            squaredDistance1D(row, &d[0], width, &v[0], &z[0]);
+            for(int x = 0; x < width; x++)
+                row[x] = d[x] >= INF ? 0.0f : std::sqrt(d[x]);   // 0 if there is no background at all
+        }
+    }
+}
+
+/*!
+ * \brief IPLDistanceTransform::labelComponents labels the 8-connected components of mask
+ * \return number of components, labels are 1..n and 0 for the background
+ */
+int IPLDistanceTransform::labelComponents(const std::vector<unsigned char>& mask, int width, int height, std::vector<int>& labels)
+{
+    labels.assign((size_t) width * height, 0);
+    std::vector<int> stack;
+    int count = 0;
+
+    for(int start = 0; start < width * height; start++)
+    {
+        if(!mask[start] || labels[start])
+            continue;
+
+        labels[start] = ++count;
+        stack.push_back(start);
+        while(!stack.empty())
+        {
+            int i = stack.back();
+            stack.pop_back();
+            int x = i % width;
+            int y = i / width;
+            for(int dy = -1; dy <= 1; dy++)
+            {
+                int ny = y + dy;
+                if(ny < 0 || ny >= height)
+                    continue;
+                for(int dx = -1; dx <= 1; dx++)
+                {
+                    int nx = x + dx;
+                    if(nx < 0 || nx >= width)
+                        continue;
+                    int n = ny * width + nx;
+                    if(mask[n] && !labels[n])
+                    {
+                        labels[n] = count;
+                        stack.push_back(n);
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,351 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLFrameBuffer.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+void IPLFrameBuffer::init()
+{
+    // init
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+    {
+        _results[i] = NULL;
+        _dirty[i]   = false;
+    }
+    _medianActive   = false;
+    _extremaActive  = false;
+    _frames         = 0;
+    _head           = -1;
+    _count          = 0;
+    _resetCounter   = 0;
+    _width          = 0;
+    _height         = 0;
+    _planes         = 0;
+    _pixels         = 0;
+    _type           = IPL_IMAGE_COLOR;
+
+    // basic settings
+    setClassName("IPLFrameBuffer");
+    setTitle("Frame Buffer");
+    setCategory(IPLProcess::CATEGORY_OBJECTS);
+    setKeywords("temporal, median, mean, minimum, maximum, frame difference, ring buffer");
+    setDescription("Keeps the last N frames and computes the temporal mean, median, minimum, "
+                   "maximum and the difference to the previous frame.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Mean", IPL_IMAGE_COLOR);
+    addOutput("Median", IPL_IMAGE_COLOR);
+    addOutput("Minimum", IPL_IMAGE_COLOR);
+    addOutput("Maximum", IPL_IMAGE_COLOR);
+    addOutput("Difference", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("frames", "Frames", "Number of frames in the buffer", 5, IPL_WIDGET_SLIDER, 2, 64);
+    addProcessPropertyInt("reset", "Reset", "", 0, IPL_WIDGET_BUTTON);
+}
+
+void IPLFrameBuffer::destroy()
+{
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+        delete _results[i];
+}
+
+/*!
+ * \brief IPLFrameBuffer::reset allocates an empty ring for the size and planes of image
+ */
+void IPLFrameBuffer::reset(IPLImage* image, int frames)
+{
+    _width          = image->width();
+    _height         = image->height();
+    _planes         = image->getNumberOfPlanes();
+    _pixels         = (size_t) _width * _height;
+    _type           = image->type() == IPL_IMAGE_BW ? IPL_IMAGE_GRAYSCALE : image->type();
+    _frames         = frames;
+    _head           = -1;
+    _count          = 0;
+    _medianActive   = false;
+    _extremaActive  = false;
+
+    _ring.assign((size_t) frames * _planes * _pixels, 0.0f);
+    _sum.assign((size_t) _planes * _pixels, 0.0);
+    std::vector<float>().swap(_sorted);
+    std::vector<float>().swap(_minimum);
+    std::vector<float>().swap(_maximum);
+
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+    {
+        delete _results[i];
+        _results[i] = NULL;
+        _dirty[i]   = false;
+    }
+}
+
+bool IPLFrameBuffer::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    int frames          = getProcessPropertyInt("frames");
+    int resetCounter    = getProcessPropertyInt("reset");
+
+    if(frames != _frames || resetCounter != _resetCounter
+            || image->width() != _width || image->height() != _height
+            || image->getNumberOfPlanes() != _planes)
+    {
+        reset(image, frames);
+        _resetCounter = resetCounter;
+    }
+
+    notifyProgressEventHandler(-1);
+
+    int next = (_head + 1) % _frames;
+    bool full = (_count == _frames);
+    int count = _count;
+    int width = _width;
+    int height = _height;
+    int planes = _planes;
+    int N = _frames;
+    bool median = _medianActive;
+    bool extrema = _extremaActive;
+
+    #pragma omp parallel
+    {
+        std::vector<float> leaving(width);
+
+        #pragma omp for
+        for(int y = 0; y < height; y++)
+        {
+            for(int p = 0; p < planes; p++)
+            {
+                size_t offset = (size_t) p * _pixels + (size_t) y * width;
+                const float* in = &image->plane(p)->p(0, y);
+                float* dst = slot(next, p) + (size_t) y * width;
+                float* old = &leaving[0];
+                double* sum = &_sum[offset];
+
+                // the slot of the new frame holds the frame leaving the window
+                if(full)
+                {
+                    std::copy(dst, dst + width, old);
+                    for(int x = 0; x < width; x++)
+                        sum[x] += (double) in[x] - old[x];
+                }
+                else
+                {
+                    for(int x = 0; x < width; x++)
+                        sum[x] += in[x];
+                }
+                std::copy(in, in + width, dst);
+
+                if(median)
+                {
+                    for(int x = 0; x < width; x++)
+                    {
+                        float* window = &_sorted[(offset + x) * N];
+                        int n = count;
+                        if(full)
+                        {
+                            float* pos = std::lower_bound(window, window + n, old[x]);
+                            std::copy(pos + 1, window + n, pos);
+                            n--;
+                        }
+                        float* pos = std::upper_bound(window, window + n, in[x]);
+                        std::copy_backward(pos, window + n, window + n + 1);
+                        *pos = in[x];
+                    }
+                }
+
+                if(extrema)
+                {
+                    float* minimum = &_minimum[offset];
+                    float* maximum = &_maximum[offset];
+                    for(int x = 0; x < width; x++)
+                    {
+                        float v = in[x];
+                        bool rescanMin = full && old[x] == minimum[x] && v > minimum[x];
+                        bool rescanMax = full && old[x] == maximum[x] && v < maximum[x];
+                        minimum[x] = std::min(minimum[x], v);
+                        maximum[x] = std::max(maximum[x], v);
+                        if(rescanMin || rescanMax)
+                        {
+                            float mn = v, mx = v;
+                            for(int k = 0; k < N; k++)
+                            {
+                                float s = slot(k, p)[(size_t) y * width + x];
+                                mn = std::min(mn, s);
+                                mx = std::max(mx, s);
+                            }
+                            if(rescanMin)
+                                minimum[x] = mn;
+                            if(rescanMax)
+                                maximum[x] = mx;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    _head = next;
+    _count = std::min(_count + 1, _frames);
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+        _dirty[i] = true;
+
+    return true;
+}
+
+/*!
+ * \brief IPLFrameBuffer::activateMedian builds the sorted windows from the frames in the ring
+ */
+void IPLFrameBuffer::activateMedian()
+{
+    if(_medianActive)
+        return;
+
+    int N = _frames;
+    int count = _count;
+    _sorted.assign((size_t) _planes * _pixels * N, 0.0f);
+
+    #pragma omp parallel for
+    for(int p = 0; p < _planes; p++)
+    {
+        for(size_t i = 0; i < _pixels; i++)
+        {
+            float* window = &_sorted[((size_t) p * _pixels + i) * N];
+            for(int k = 0; k < count; k++)
+                window[k] = slot((_head - k + N) % N, p)[i];
+            std::sort(window, window + count);
+        }
+    }
+    _medianActive = true;
+}
+
+/*!
+ * \brief IPLFrameBuffer::activateExtrema computes minimum and maximum of the frames in the ring
+ */
+void IPLFrameBuffer::activateExtrema()
+{
+    if(_extremaActive)
+        return;
+
+    int N = _frames;
+    int count = _count;
+    _minimum.assign((size_t) _planes * _pixels, std::numeric_limits<float>::max());
+    _maximum.assign((size_t) _planes * _pixels, -std::numeric_limits<float>::max());
+
+    for(int p = 0; p < _planes; p++)
+    {
+        float* minimum = &_minimum[(size_t) p * _pixels];
+        float* maximum = &_maximum[(size_t) p * _pixels];
+        for(int k = 0; k < count; k++)
+        {
+            const float* frame = slot((_head - k + N) % N, p);
+            #pragma omp parallel for
+            for(int y = 0; y < _height; y++)
+            {
+                size_t offset = (size_t) y * _width;
+                for(int x = 0; x < _width; x++)
+                {
+                    minimum[offset + x] = std::min(minimum[offset + x], frame[offset + x]);
+                    maximum[offset + x] = std::max(maximum[offset + x], frame[offset + x]);
+                }
+            }
+        }
+    }
+    _extremaActive = true;
+}
+
+/*!
+ * \brief IPLFrameBuffer::getResultData fills the requested output from the current state
+ */
+IPLData* IPLFrameBuffer::getResultData(int index)
+{
+    if(index < 0 || index >= NUM_OUTPUTS || _count == 0)
+        return NULL;
+
+    if(index == OUTPUT_MEDIAN)
+        activateMedian();
+    if(index == OUTPUT_MINIMUM || index == OUTPUT_MAXIMUM)
+        activateExtrema();
+
+    if(!_results[index])
+    {
+        _results[index] = new IPLImage(_type, _width, _height);
+        _dirty[index] = true;
+    }
+    if(!_dirty[index])
+        return _results[index];
+
+    IPLImage* result = _results[index];
+    int planes = std::min(_planes, result->getNumberOfPlanes());
+    int width = _width;
+    int N = _frames;
+    int count = _count;
+    int previous = (_head - 1 + N) % N;
+
+    #pragma omp parallel for
+    for(int y = 0; y < _height; y++)
+    {
+        for(int p = 0; p < planes; p++)
+        {
+            size_t offset = (size_t) p * _pixels + (size_t) y * width;
+            float* out = &result->plane(p)->p(0, y);
+
+            switch(index)
+            {
+            case OUTPUT_MEAN:
+            {
+                const double* sum = &_sum[offset];
+                double inv = 1.0 / count;
+                for(int x = 0; x < width; x++)
+                    out[x] = (float) (sum[x] * inv);
+                break;
+            }
+            case OUTPUT_MEDIAN:
+                for(int x = 0; x < width; x++)
+                {
+                    const float* window = &_sorted[(offset + x) * N];
+                    out[x] = (count % 2) ? window[count/2] : 0.5f * (window[count/2 - 1] + window[count/2]);
+                }
+                break;
+            case OUTPUT_MINIMUM:
+                std::copy(&_minimum[offset], &_minimum[offset] + width, out);
+                break;
+            case OUTPUT_MAXIMUM:
+                std::copy(&_maximum[offset], &_maximum[offset] + width, out);
+                break;
+            case OUTPUT_DIFFERENCE:
+            {
+                const float* newest = slot(_head, p) + (size_t) y * width;
+                const float* before = slot(previous, p) + (size_t) y * width;
+                for(int x = 0; x < width; x++)
+                    out[x] = (count > 1) ? std::fabs(newest[x] - before[x]) : 0.0f;
+                break;
+            }
+            }
+        }
+    }
+
+    _dirty[index] = false;
+    return result;
+}
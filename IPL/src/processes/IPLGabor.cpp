@@ -75,13 +75,21 @@ bool IPLGabor::processInputData(IPLData* data, int, bool)
     double direction = getProcessPropertyDouble("direction");
     double deviation = getProcessPropertyDouble("deviation");
 
-    //int progress = 0;
-    //int maxProgress = image->height() * image->getNumberOfPlanes();
+    std::vector<double> qEven, qOdd;
+    IPLGabor::kernels(window, wavelength, direction, deviation, qEven, qOdd);
 
+    IPLGabor::gabor(image, _result0, _result1, _result2, qEven.data(), qOdd.data(), window/2);
+
+    return true;
+}
+
+void IPLGabor::kernels(int window, int wavelength, double direction, double deviation,
+                       std::vector<double>& qEven, std::vector<double>& qOdd)
+{
     int w2 = window/2;
     int area = window*window;
-    double* qEven = new double [area];
-    double* qOdd = new double [area];
+    qEven.assign(area, 0.0);
+    qOdd.assign(area, 0.0);
 
     double k = 2.0 * PI / (double) wavelength;
     double k2 = k * k;
@@ -91,8 +99,6 @@ bool IPLGabor::processInputData(IPLData* data, int, bool)
     double ky = -k * sin( direction );
 
     int index = 0;
-    double E = 0.0;
-    double O =0.0;
     for( int x = -w2; x <= w2; x++ )
     {
         for( int y = -w2; y <= w2; y++)
@@ -100,17 +106,24 @@ bool IPLGabor::processInputData(IPLData* data, int, bool)
             double compensate = k2/d2;
             double envelope = exp( -k2 * sig2 * (x*x+y*y) );
             double DC = exp( -d2/2.0);
-            E += qEven[index] = compensate * envelope * ( cos( kx*x + ky*y ) - DC );
-            O += qOdd[index++]  = compensate * envelope * ( sin( kx*x + ky*y )- DC );
+            qEven[index] = compensate * envelope * ( cos( kx*x + ky*y ) - DC );
+            qOdd[index++]  = compensate * envelope * ( sin( kx*x + ky*y )- DC );
         }
     }
+}
+
+void IPLGabor::gabor(IPLImage* image, IPLImage* evenResult, IPLImage* oddResult, IPLImage* powerResult,
+                     const double* qEven, const double* qOdd, int w2)
+{
+    int width = image->width();
+    int height = image->height();
 
     for( int planeNr=0; planeNr < image->getNumberOfPlanes(); planeNr++ )
     {
         IPLImagePlane* plane        = image->plane( planeNr );
-        IPLImagePlane* evenplane    = _result0->plane( planeNr );
-        IPLImagePlane* oddplane     = _result1->plane( planeNr );
-        IPLImagePlane* powerplane   = _result2->plane( planeNr );
+        IPLImagePlane* evenplane    = evenResult->plane( planeNr );
+        IPLImagePlane* oddplane     = oddResult->plane( planeNr );
+        IPLImagePlane* powerplane   = powerResult->plane( planeNr );
         for(int x=w2; x<width-w2; x++)
         {
             for(int y=w2; y<height-w2; y++)
@@ -140,8 +153,63 @@ bool IPLGabor::processInputData(IPLData* data, int, bool)
             }
         }
     }
-    delete [] qEven;
-    delete [] qOdd;
+}
+
+/*!
+ * \brief IPLGabor::processInputDataBatch
+ * The Gabor kernels are built once for all frames, the frames are filtered in parallel.
+ */
+bool IPLGabor::processInputDataBatch(const std::vector<IPLData*>& inputs, int inputIndex, bool useOpenCV,
+                                     std::vector<IPLData*>& results, int outputIndex)
+{
+    if(outputIndex < 0 || outputIndex > 2 || inputs.size() < 2)
+        return IPLProcess::processInputDataBatch(inputs, inputIndex, useOpenCV, results, outputIndex);
+
+    int window = getProcessPropertyInt("window");
+    int wavelength = getProcessPropertyInt("wavelength");
+    double direction = getProcessPropertyDouble("direction");
+    double deviation = getProcessPropertyDouble("deviation");
+
+    std::vector<double> qEven, qOdd;
+    IPLGabor::kernels(window, wavelength, direction, deviation, qEven, qOdd);
+
+    int nrOfFrames = (int) inputs.size();
+    results.assign(nrOfFrames, NULL);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int i=0; i < nrOfFrames; i++)
+    {
+        IPLImage* image = inputs[i]->toImage();
+        IPLImage* out[3];
+        for(int j=0; j < 3; j++)
+            out[j] = new IPLImage(image->type(), image->width(), image->height());
+
+        IPLGabor::gabor(image, out[0], out[1], out[2], qEven.data(), qOdd.data(), window/2);
+
+        // only the requested output is handed to the caller
+        for(int j=0; j < 3; j++)
+        {
+            if(j == outputIndex)
+                results[i] = out[j];
+            else
+                delete out[j];
+        }
+    }
+
+    // keep the last frame as regular result
+    delete _result0;
+    delete _result1;
+    delete _result2;
+    _result0 = NULL;
+    _result1 = NULL;
+    _result2 = NULL;
+    IPLImage* last = new IPLImage(*results.back()->toImage());
+    if(outputIndex == 0)
+        _result0 = last;
+    else if(outputIndex == 1)
+        _result1 = last;
+    else
+        _result2 = last;
 
     return true;
 }
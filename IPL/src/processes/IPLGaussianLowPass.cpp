@@ -45,11 +45,12 @@ void IPLGaussianLowPass::init()
 void IPLGaussianLowPass::destroy()
 {
     delete _result;
+    delete _kernel;
 }
 
-void IPLGaussianLowPass::gauss(IPLImage* image, IPLImage* result, IPLData* kernel, int height, int window, double sigma, int width, int N)
+std::vector<float> IPLGaussianLowPass::kernel(double sigma, int N)
 {
-    float* filter = new float [window];
+    std::vector<float> filter(2*N+1);
     float sum = 0;
     for( int k = -N; k <= N; ++k )
     {
@@ -58,12 +59,24 @@ void IPLGaussianLowPass::gauss(IPLImage* image, IPLImage* result, IPLData* kerne
         filter[k+N] = val;
     }
 
-    kernel = new IPLMatrix(1, window, filter);
-
     float sumFactor = 1.0f/sum;
-    for( int k = 0; k < window; ++k )
+    for( size_t k = 0; k < filter.size(); ++k )
         filter[k] *= sumFactor;
 
+    return filter;
+}
+
+void IPLGaussianLowPass::gauss(IPLImage* image, IPLImage* result, IPLData* kernel, int height, int window, double sigma, int width, int N)
+{
+    std::vector<float> filter = IPLGaussianLowPass::kernel(sigma, N);
+    IPLGaussianLowPass::gauss(image, result, filter.data(), N);
+}
+
+void IPLGaussianLowPass::gauss(IPLImage* image, IPLImage* result, const float* filter, int N)
+{
+    int width  = image->width();
+    int height = image->height();
+
     //int progress = 0;
     //int maxProgress = image->height() * image->getNumberOfPlanes() * 2;
     int nrOfPlanes = image->getNumberOfPlanes();
@@ -123,7 +136,17 @@ void IPLGaussianLowPass::gauss(IPLImage* image, IPLImage* result, IPLData* kerne
         }
         delete tmpI;
     }
-    delete [] filter;
+}
+
+void IPLGaussianLowPass::window(double sigma, int& window, int& N)
+{
+    // cattin variant
+    //int N = ceil( sigma * sqrt( 2.0*log( 1.0/0.015 ) ) + 1.0 );
+    //int window = 2*N+1;
+
+    // opencv variant
+    window = 2 * ceil((sigma - 0.8)/0.3 +1) + 1;
+    N = (window-1) / 2;
 }
 
 bool IPLGaussianLowPass::processInputData(IPLData* data, int, bool useOpenCV)
@@ -144,14 +167,8 @@ bool IPLGaussianLowPass::processInputData(IPLData* data, int, bool useOpenCV)
     // get properties
     double sigma = getProcessPropertyDouble("sigma");
 
-    // cattin variant
-    //int N = ceil( sigma * sqrt( 2.0*log( 1.0/0.015 ) ) + 1.0 );
-    //int window = 2*N+1;
-
-
-    // opencv variant
-    int window = 2 * ceil((sigma - 0.8)/0.3 +1) + 1;
-    int N = (window-1) / 2;
+    int window, N;
+    IPLGaussianLowPass::window(sigma, window, N);
 
     addInformation("Window: " + std::to_string(window));
     addInformation("N: " + std::to_string(N));
@@ -172,11 +189,54 @@ bool IPLGaussianLowPass::processInputData(IPLData* data, int, bool useOpenCV)
     }
     else
     {
-        IPLGaussianLowPass::gauss(image, _result, _kernel, height, window, sigma, width, N);
+        std::vector<float> filter = IPLGaussianLowPass::kernel(sigma, N);
+        _kernel = new IPLMatrix(1, window, filter.data());
+
+        IPLGaussianLowPass::gauss(image, _result, filter.data(), N);
         return true;
     }
 }
 
+/*!
+ * \brief IPLGaussianLowPass::processInputDataBatch
+ * The kernel is built once for all frames, the frames are filtered in parallel.
+ */
+bool IPLGaussianLowPass::processInputDataBatch(const std::vector<IPLData*>& inputs, int inputIndex, bool useOpenCV,
+                                               std::vector<IPLData*>& results, int outputIndex)
+{
+    if(useOpenCV || outputIndex != 0 || inputs.size() < 2)
+        return IPLProcess::processInputDataBatch(inputs, inputIndex, useOpenCV, results, outputIndex);
+
+    double sigma = getProcessPropertyDouble("sigma");
+
+    int window, N;
+    IPLGaussianLowPass::window(sigma, window, N);
+
+    std::vector<float> filter = IPLGaussianLowPass::kernel(sigma, N);
+
+    int nrOfFrames = (int) inputs.size();
+    results.assign(nrOfFrames, NULL);
+    for(int i=0; i < nrOfFrames; i++)
+    {
+        IPLImage* image = inputs[i]->toImage();
+        results[i] = new IPLImage(image->type(), image->width(), image->height());
+    }
+
+    notifyProgressEventHandler(-1);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int i=0; i < nrOfFrames; i++)
+        IPLGaussianLowPass::gauss(inputs[i]->toImage(), results[i]->toImage(), filter.data(), N);
+
+    // keep the last frame as regular result
+    delete _result;
+    _result = new IPLImage(*results.back()->toImage());
+    delete _kernel;
+    _kernel = new IPLMatrix(1, window, filter.data());
+
+    return true;
+}
+
 IPLData* IPLGaussianLowPass::getResultData(int index)
 {
     if(index == 0)
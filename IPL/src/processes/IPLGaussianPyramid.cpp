@@ -0,0 +1,344 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLGaussianPyramid.h"
+
+#include <vector>
+#include <algorithm>
+
+void IPLGaussianPyramid::init()
+{
+    // init
+    _mosaic     = NULL;
+    _pyramid    = NULL;
+    _level      = NULL;
+
+    // basic settings
+    setClassName("IPLGaussianPyramid");
+    setTitle("Gaussian Pyramid");
+    setCategory(IPLProcess::CATEGORY_GEOMETRY);
+    setKeywords("multiscale, reduce, downsample");
+    setDescription("Builds all levels of a Gaussian pyramid with the 5-tap binomial filter. "
+                   "Every level has half the width and height of the previous one.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Mosaic", IPL_IMAGE_COLOR);
+    addOutput("Pyramid", IPL_PYRAMID);
+    addOutput("Level", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("levels", "Levels", "Number of levels including the original size", 5, IPL_WIDGET_SLIDER, 1, 10);
+    addProcessPropertyInt("level", "Output Level", "Level for the Level output", 1, IPL_WIDGET_SLIDER, 0, 9);
+}
+
+void IPLGaussianPyramid::destroy()
+{
+    delete _mosaic;
+    delete _pyramid;
+    delete _level;
+}
+
+bool IPLGaussianPyramid::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    if(image->type() == IPL_IMAGE_ORIENTED)
+    {
+        addError("Oriented images are not supported.");
+        return false;
+    }
+
+    // delete previous result
+    delete _mosaic;
+    _mosaic = NULL;
+    delete _pyramid;
+    _pyramid = NULL;
+    delete _level;
+    _level = NULL;
+
+    // get properties
+    int levels  = getProcessPropertyInt("levels");
+    int level   = getProcessPropertyInt("level");
+
+    notifyProgressEventHandler(-1);
+
+    _pyramid = IPLGaussianPyramid::build(image, levels);
+    _mosaic  = IPLGaussianPyramid::mosaic(_pyramid);
+
+    if(_pyramid->levels() < levels)
+        addWarning("The image is too small for " + std::to_string(levels) + " levels.");
+
+    level = std::min(level, _pyramid->levels()-1);
+    _level = new IPLImage(*_pyramid->level(level));
+
+    addInformation("Levels: " + std::to_string(_pyramid->levels()));
+
+    return true;
+}
+
+IPLData* IPLGaussianPyramid::getResultData(int index)
+{
+    if(index == 0)
+        return _mosaic;
+    else if(index == 1)
+        return _pyramid;
+
+    return _level;
+}
+
+//! index for reflect 101 border mode (dcb|abcd|cba), same as OpenCV
+static inline int reflect101(int i, int n)
+{
+    if(n == 1)
+        return 0;
+
+    while(i < 0 || i >= n)
+    {
+        if(i < 0)
+            i = -i;
+        if(i >= n)
+            i = 2*(n-1) - i;
+    }
+    return i;
+}
+
+//! index of a coarse sample next to the border, reflect 101 in the fine domain
+static inline int coarseIndex(int i, int n, int fineSize)
+{
+    if(i < 0)
+        return (n > 1) ? 1 : 0;
+
+    if(i >= n)
+        return (fineSize % 2 == 1) ? std::max(n-2, 0) : n-1;
+
+    return i;
+}
+
+/*!
+ * \brief IPLGaussianPyramid::reduce low-pass filters and subsamples by 2
+ * Only every second column is computed in the horizontal pass and only every
+ * second row in the vertical pass. Both passes work on contiguous rows and
+ * are parallelized over the rows.
+ * \param image
+ * \param result has the size ((width+1)/2, (height+1)/2)
+ */
+void IPLGaussianPyramid::reduce(IPLImage* image, IPLImage* result)
+{
+    int width           = image->width();
+    int height          = image->height();
+    int resultWidth     = result->width();
+    int resultHeight    = result->height();
+    const ipl_basetype f = 1.0f / 16.0f;
+
+    IPLImagePlane tmp(resultWidth, height);
+
+    int nrOfPlanes = std::min(image->getNumberOfPlanes(), result->getNumberOfPlanes());
+    for(int planeNr = 0; planeNr < nrOfPlanes; planeNr++)
+    {
+        IPLImagePlane* plane        = image->plane(planeNr);
+        IPLImagePlane* resultPlane  = result->plane(planeNr);
+
+        // horizontal run, every second column
+        #pragma omp parallel
+        {
+            std::vector<ipl_basetype> row(width + 4);
+            ipl_basetype* padded = row.data() + 2;
+
+            #pragma omp for
+            for(int y = 0; y < height; y++)
+            {
+                const ipl_basetype* in = &plane->p(0, y);
+                std::copy(in, in + width, padded);
+                padded[-2]      = in[reflect101(-2, width)];
+                padded[-1]      = in[reflect101(-1, width)];
+                padded[width]   = in[reflect101(width, width)];
+                padded[width+1] = in[reflect101(width+1, width)];
+
+                ipl_basetype* out = &tmp.p(0, y);
+                for(int x = 0; x < resultWidth; x++)
+                {
+                    const ipl_basetype* c = padded + 2*x;
+                    out[x] = (c[-2] + c[2] + 4.0f*(c[-1] + c[1]) + 6.0f*c[0]) * f;
+                }
+            }
+        }
+
+        // vertical run, every second row
+        #pragma omp parallel for
+        for(int y = 0; y < resultHeight; y++)
+        {
+            const ipl_basetype* r0 = &tmp.p(0, reflect101(2*y-2, height));
+            const ipl_basetype* r1 = &tmp.p(0, reflect101(2*y-1, height));
+            const ipl_basetype* r2 = &tmp.p(0, reflect101(2*y,   height));
+            const ipl_basetype* r3 = &tmp.p(0, reflect101(2*y+1, height));
+            const ipl_basetype* r4 = &tmp.p(0, reflect101(2*y+2, height));
+
+            ipl_basetype* out = &resultPlane->p(0, y);
+            for(int x = 0; x < resultWidth; x++)
+                out[x] = (r0[x] + r4[x] + 4.0f*(r1[x] + r3[x]) + 6.0f*r2[x]) * f;
+        }
+    }
+}
+
+/*!
+ * \brief IPLGaussianPyramid::expand upsamples by 2 and interpolates
+ * Polyphase form of the binomial filter: even samples (1 6 1)/8,
+ * odd samples (1 1)/2.
+ * \param image coarse image
+ * \param result fine image, width and height are 2n or 2n-1 of the coarse size
+ */
+void IPLGaussianPyramid::expand(IPLImage* image, IPLImage* result)
+{
+    int width           = image->width();
+    int height          = image->height();
+    int resultWidth     = result->width();
+    int resultHeight    = result->height();
+
+    IPLImagePlane tmp(resultWidth, height);
+
+    int nrOfPlanes = std::min(image->getNumberOfPlanes(), result->getNumberOfPlanes());
+    for(int planeNr = 0; planeNr < nrOfPlanes; planeNr++)
+    {
+        IPLImagePlane* plane        = image->plane(planeNr);
+        IPLImagePlane* resultPlane  = result->plane(planeNr);
+
+        // horizontal run
+        #pragma omp parallel
+        {
+            std::vector<ipl_basetype> row(width + 2);
+            ipl_basetype* padded = row.data() + 1;
+
+            #pragma omp for
+            for(int y = 0; y < height; y++)
+            {
+                const ipl_basetype* in = &plane->p(0, y);
+                std::copy(in, in + width, padded);
+                padded[-1]      = in[coarseIndex(-1, width, resultWidth)];
+                padded[width]   = in[coarseIndex(width, width, resultWidth)];
+
+                ipl_basetype* out = &tmp.p(0, y);
+                for(int x = 0; 2*x < resultWidth; x++)
+                    out[2*x] = (padded[x-1] + 6.0f*padded[x] + padded[x+1]) * 0.125f;
+                for(int x = 0; 2*x+1 < resultWidth; x++)
+                    out[2*x+1] = (padded[x] + padded[x+1]) * 0.5f;
+            }
+        }
+
+        // vertical run
+        #pragma omp parallel for
+        for(int y = 0; y < resultHeight; y++)
+        {
+            int j = y / 2;
+            ipl_basetype* out = &resultPlane->p(0, y);
+
+            if(y % 2 == 0)
+            {
+                const ipl_basetype* r0 = &tmp.p(0, coarseIndex(j-1, height, resultHeight));
+                const ipl_basetype* r1 = &tmp.p(0, j);
+                const ipl_basetype* r2 = &tmp.p(0, coarseIndex(j+1, height, resultHeight));
+                for(int x = 0; x < resultWidth; x++)
+                    out[x] = (r0[x] + 6.0f*r1[x] + r2[x]) * 0.125f;
+            }
+            else
+            {
+                const ipl_basetype* r1 = &tmp.p(0, j);
+                const ipl_basetype* r2 = &tmp.p(0, coarseIndex(j+1, height, resultHeight));
+                for(int x = 0; x < resultWidth; x++)
+                    out[x] = (r1[x] + r2[x]) * 0.5f;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLGaussianPyramid::build creates a Gaussian pyramid
+ * Stops early if the image can not be reduced any further.
+ */
+IPLPyramid* IPLGaussianPyramid::build(IPLImage* image, int levels)
+{
+    IPLPyramid* pyramid = new IPLPyramid(false);
+    pyramid->addLevel(new IPLImage(*image));
+
+    for(int i = 1; i < levels; i++)
+    {
+        IPLImage* previous = pyramid->level(i-1);
+        if(previous->width() < 2 && previous->height() < 2)
+            break;
+
+        IPLImage* next = new IPLImage(previous->type(), (previous->width()+1)/2, (previous->height()+1)/2);
+        IPLGaussianPyramid::reduce(previous, next);
+        pyramid->addLevel(next);
+    }
+    return pyramid;
+}
+
+/*!
+ * \brief IPLGaussianPyramid::mosaic shows all levels in one image
+ * Level 0 on the left, the other levels stacked on the right. The band-pass
+ * levels of a Laplacian pyramid are shifted by 0.5.
+ */
+IPLImage* IPLGaussianPyramid::mosaic(IPLPyramid* pyramid)
+{
+    IPLImage* base = pyramid->level(0);
+
+    int width  = base->width();
+    int height = base->height();
+    int stackHeight = 0;
+    if(pyramid->levels() > 1)
+    {
+        width += pyramid->level(1)->width();
+        for(int i = 1; i < pyramid->levels(); i++)
+            stackHeight += pyramid->level(i)->height();
+    }
+    height = std::max(height, stackHeight);
+
+    IPLImage* result = new IPLImage(base->type(), width, height);
+
+    int offsetX = 0;
+    int offsetY = 0;
+    for(int i = 0; i < pyramid->levels(); i++)
+    {
+        IPLImage* level = pyramid->level(i);
+        bool bandpass = pyramid->isLaplacian() && i < pyramid->levels()-1;
+        ipl_basetype offset = bandpass ? 0.5f : 0.0f;
+
+        for(int planeNr = 0; planeNr < level->getNumberOfPlanes(); planeNr++)
+        {
+            IPLImagePlane* plane = level->plane(planeNr);
+            IPLImagePlane* resultPlane = result->plane(planeNr);
+
+            #pragma omp parallel for
+            for(int y = 0; y < level->height(); y++)
+            {
+                for(int x = 0; x < level->width(); x++)
+                {
+                    ipl_basetype value = plane->p(x, y) + offset;
+                    resultPlane->p(offsetX + x, offsetY + y) = std::max(0.0f, std::min(1.0f, value));
+                }
+            }
+        }
+
+        if(i == 0)
+            offsetX = level->width();
+        else
+            offsetY += level->height();
+    }
+    return result;
+}
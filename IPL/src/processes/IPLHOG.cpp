@@ -0,0 +1,338 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLHOG.h"
+#include "IPLArithmetic.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+//! keeps the block norm away from 0 for empty blocks
+const float HOG_EPSILON = 1e-3f;
+
+//! L2-Hys clipping value
+const float HOG_CLIP = 0.2f;
+}
+
+void IPLHOG::init()
+{
+    // init
+    _result         = NULL;
+    _descriptors    = NULL;
+
+    // basic settings
+    setClassName("IPLHOG");
+    setTitle("HOG Descriptor");
+    setCategory(IPLProcess::CATEGORY_GRADIENTS);
+    setKeywords("histogram of oriented gradients, descriptor, detection, cells, blocks");
+    setDescription("Dense histograms of oriented gradients. Uses magnitude and phase of a connected oriented "
+                   "image, e.g. from the Gradient Operator, otherwise computes the gradient itself. Outputs "
+                   "the cell histograms as an image and the normalized block descriptors, one matrix row per block.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_ORIENTED);
+    addOutput("Image", IPL_IMAGE_GRAYSCALE);
+    addOutput("Descriptors", IPL_MATRIX);
+
+    // properties
+    addProcessPropertyInt("cell_size", "Cell Size", "Cell width and height in pixels", 8, IPL_WIDGET_SLIDER, 4, 32);
+    addProcessPropertyInt("block_size", "Block Size", "Block width and height in cells", 2, IPL_WIDGET_SLIDER, 1, 4);
+    addProcessPropertyInt("bins", "Bins", "", 9, IPL_WIDGET_SLIDER, 4, 18);
+    addProcessPropertyInt("orientation", "Orientation:Unsigned (0-180)|Signed (0-360)", "", 0, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("normalization", "Normalization:L2|L2-Hys", "", NORM_L2_HYS, IPL_WIDGET_RADIOBUTTONS);
+}
+
+void IPLHOG::destroy()
+{
+    delete _result;
+    delete _descriptors;
+}
+
+bool IPLHOG::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    int cellSize            = getProcessPropertyInt("cell_size");
+    int blockSize           = getProcessPropertyInt("block_size");
+    int bins                = getProcessPropertyInt("bins");
+    bool signedOrientation  = getProcessPropertyInt("orientation") == 1;
+    int normalization       = getProcessPropertyInt("normalization");
+
+    int width = image->width();
+    int height = image->height();
+    int cellsX = width / cellSize;
+    int cellsY = height / cellSize;
+
+    if(cellsX < blockSize || cellsY < blockSize)
+    {
+        addError("The image is smaller than one block.");
+        return false;
+    }
+
+    notifyProgressEventHandler(-1);
+
+    bool oriented = image->type() == IPL_IMAGE_ORIENTED && image->getNumberOfPlanes() >= 2;
+    gradient(image, oriented);
+
+    // cell position and weight of every column, clamped at the border
+    int cellWidth = cellsX * cellSize;
+    std::vector<int> cell0(cellWidth);
+    std::vector<int> cell1(cellWidth);
+    std::vector<float> weight1(cellWidth);
+    for(int x = 0; x < cellWidth; x++)
+    {
+        float c = std::min((float) (cellsX-1), std::max(0.0f, (x + 0.5f) / cellSize - 0.5f));
+        cell0[x] = (int) c;
+        cell1[x] = std::min(cell0[x] + 1, cellsX-1);
+        weight1[x] = c - cell0[x];
+    }
+
+    float range = signedOrientation ? 2.0f * (float) PI : (float) PI;
+    float binWidth = range / bins;
+
+    // every cell row reads the pixel rows which vote for it
+    _cells.assign((size_t) cellsX * cellsY * bins, 0.0f);
+    #pragma omp parallel for schedule(dynamic)
+    for(int j = 0; j < cellsY; j++)
+    {
+        float* histogram = &_cells[(size_t) j * cellsX * bins];
+        int y0 = std::max(0, (int) ((j - 0.5f) * cellSize) - 1);
+        int y1 = std::min(cellsY * cellSize, (int) ((j + 1.5f) * cellSize) + 1);
+
+        for(int y = y0; y < y1; y++)
+        {
+            float c = std::min((float) (cellsY-1), std::max(0.0f, (y + 0.5f) / cellSize - 0.5f));
+            int c0 = (int) c;
+            float w = c - c0;
+            float rowWeight = (c0 == j ? 1.0f - w : 0.0f) + (std::min(c0 + 1, cellsY-1) == j ? w : 0.0f);
+            if(rowWeight == 0.0f)
+                continue;
+
+            const float* magnitude = &_magnitude[(size_t) y * width];
+            const float* angle = &_angle[(size_t) y * width];
+            for(int x = 0; x < cellWidth; x++)
+            {
+                float a = angle[x];
+                if(a >= range)
+                    a -= range;
+
+                // two nearest bins
+                float b = a / binWidth - 0.5f;
+                int b0 = (int) std::floor(b);
+                float wb = b - b0;
+                if(b0 < 0)
+                    b0 += bins;
+                if(b0 >= bins)
+                    b0 -= bins;
+                int b1 = b0 + 1 < bins ? b0 + 1 : 0;
+
+                float m = magnitude[x] * rowWeight;
+                float m1 = m * weight1[x];
+                float m0 = m - m1;
+                float* h0 = histogram + cell0[x] * bins;
+                float* h1 = histogram + cell1[x] * bins;
+                h0[b0] += m0 * (1.0f - wb);
+                h0[b1] += m0 * wb;
+                h1[b0] += m1 * (1.0f - wb);
+                h1[b1] += m1 * wb;
+            }
+        }
+    }
+
+    // block norms from the integral of the cell energies
+    IPLImage energy(IPL_IMAGE_GRAYSCALE, cellsX, cellsY);
+    for(int j = 0; j < cellsY; j++)
+    {
+        for(int i = 0; i < cellsX; i++)
+        {
+            const float* histogram = &_cells[((size_t) j * cellsX + i) * bins];
+            float sum = 0.0f;
+            for(int k = 0; k < bins; k++)
+                sum += histogram[k] * histogram[k];
+            energy.plane(0)->p(i, j) = sum;
+        }
+    }
+    _energy.compute(&energy, false);
+
+    int blocksX = cellsX - blockSize + 1;
+    int blocksY = cellsY - blockSize + 1;
+    int length = blockSize * blockSize * bins;
+    std::vector<float> descriptors((size_t) blocksX * blocksY * length);
+
+    #pragma omp parallel for
+    for(int by = 0; by < blocksY; by++)
+    {
+        for(int bx = 0; bx < blocksX; bx++)
+        {
+            float* out = &descriptors[((size_t) by * blocksX + bx) * length];
+            for(int j = 0; j < blockSize; j++)
+            {
+                const float* row = &_cells[((size_t) (by + j) * cellsX + bx) * bins];
+                std::copy(row, row + blockSize * bins, out + j * blockSize * bins);
+            }
+
+            double norm = _energy.sum(0, bx, by, bx + blockSize, by + blockSize);
+            float scale = 1.0f / std::sqrt((float) norm + HOG_EPSILON * HOG_EPSILON);
+            for(int k = 0; k < length; k++)
+                out[k] *= scale;
+
+            if(normalization == NORM_L2_HYS)
+            {
+                float sum = 0.0f;
+                for(int k = 0; k < length; k++)
+                {
+                    out[k] = std::min(out[k], HOG_CLIP);
+                    sum += out[k] * out[k];
+                }
+                scale = 1.0f / std::sqrt(sum + HOG_EPSILON * HOG_EPSILON);
+                for(int k = 0; k < length; k++)
+                    out[k] *= scale;
+            }
+        }
+    }
+
+    delete _descriptors;
+    _descriptors = new IPLMatrix(blocksX * blocksY, length, &descriptors[0]);
+
+    // reuse the result if possible
+    if(!_result || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        _result = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+    }
+    else
+    {
+        _result->fillColor(0.0f);
+    }
+    drawCells(cellsX, cellsY, cellSize, bins, signedOrientation);
+
+    std::stringstream s;
+    s << "Cells: " << cellsX << "x" << cellsY << ", blocks: " << blocksX << "x" << blocksY
+      << ", descriptor length: " << length;
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLData* IPLHOG::getResultData(int index)
+{
+    if(index == 0)
+        return _result;
+    return _descriptors;
+}
+
+/*!
+ * \brief IPLHOG::gradient fills magnitude and angle (0..2 PI) of every pixel
+ * The angle is counterclockwise with y up, like the phase of the oriented image.
+ */
+void IPLHOG::gradient(IPLImage* image, bool oriented)
+{
+    int width = image->width();
+    int height = image->height();
+    size_t pixels = (size_t) width * height;
+    int planes = oriented ? 1 : image->getNumberOfPlanes();
+    float fullCircle = 2.0f * (float) PI;
+
+    _magnitude.resize(pixels);
+    _angle.resize(pixels);
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        float* magnitude = &_magnitude[(size_t) y * width];
+        float* angle = &_angle[(size_t) y * width];
+
+        if(oriented)
+        {
+            const float* m = &image->plane(0)->p(0, y);
+            const float* phase = &image->plane(1)->p(0, y);
+            for(int x = 0; x < width; x++)
+            {
+                magnitude[x] = m[x];
+                angle[x] = phase[x] * fullCircle;
+            }
+            continue;
+        }
+
+        // centered differences, the strongest plane wins
+        std::fill(magnitude, magnitude + width, -1.0f);
+        for(int p = 0; p < planes; p++)
+        {
+            IPLImagePlane* plane = image->plane(p);
+            const float* above = &plane->p(0, std::max(0, y-1));
+            const float* row = &plane->p(0, y);
+            const float* below = &plane->p(0, std::min(height-1, y+1));
+            for(int x = 0; x < width; x++)
+            {
+                float dx = row[std::min(width-1, x+1)] - row[std::max(0, x-1)];
+                float dy = below[x] - above[x];
+                float m = std::sqrt(dx*dx + dy*dy);
+                if(m > magnitude[x])
+                {
+                    magnitude[x] = m;
+                    float a = IPLArithmetic::atan2(-dy, dx);
+                    angle[x] = a < 0.0f ? a + fullCircle : a;
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * \brief IPLHOG::drawCells draws every cell histogram as a star of edge lines
+ * Each bin is a line perpendicular to its gradient direction, brighter for
+ * larger bins, scaled to the largest bin of the cell.
+ */
+void IPLHOG::drawCells(int cellsX, int cellsY, int cellSize, int bins, bool signedOrientation)
+{
+    float binWidth = (signedOrientation ? 2.0f * (float) PI : (float) PI) / bins;
+    float radius = cellSize * 0.5f - 0.5f;
+
+    #pragma omp parallel for
+    for(int j = 0; j < cellsY; j++)
+    {
+        for(int i = 0; i < cellsX; i++)
+        {
+            const float* histogram = &_cells[((size_t) j * cellsX + i) * bins];
+            float maximum = *std::max_element(histogram, histogram + bins);
+            if(maximum <= 0.0f)
+                continue;
+
+            float cx = (i + 0.5f) * cellSize - 0.5f;
+            float cy = (j + 0.5f) * cellSize - 0.5f;
+            for(int k = 0; k < bins; k++)
+            {
+                float v = histogram[k] / maximum;
+                float edge = (k + 0.5f) * binWidth + 0.5f * (float) PI;
+                float dx = std::cos(edge);
+                float dy = -std::sin(edge);
+                for(float t = -radius; t <= radius; t += 0.5f)
+                {
+                    int x = (int) std::floor(cx + t*dx + 0.5f);
+                    int y = (int) std::floor(cy + t*dy + 0.5f);
+                    float& out = _result->plane(0)->p(x, y);
+                    out = std::max(out, v);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLIntegral.h"
+
+#include <algorithm>
+
+void IPLIntegral::init()
+{
+    // init
+    _integral   = NULL;
+    _result     = NULL;
+
+    // basic settings
+    setClassName("IPLIntegral");
+    setTitle("Integral Image");
+    setCategory(IPLProcess::CATEGORY_LOCALOPERATIONS);
+    setKeywords("summed-area table, integral, sum, box");
+    setDescription("Computes the integral image (summed-area table) and optionally the integral of the "
+                   "squared pixels. Following processes like the Box Filter get the sum of any window "
+                   "from it in constant time.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Image", IPL_IMAGE_COLOR);
+    addOutput("Integral Image", IPL_INTEGRAL_IMAGE);
+
+    // properties
+    addProcessPropertyBool("squared", "Squared Sum", "Also compute the integral of the squared pixels, needed for variance",
+                           true, IPL_WIDGET_CHECKBOXES);
+}
+
+void IPLIntegral::destroy()
+{
+    delete _integral;
+    delete _result;
+}
+
+bool IPLIntegral::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    bool squared = getProcessPropertyBool("squared");
+
+    notifyProgressEventHandler(-1);
+
+    // the tables are reused for images of the same size
+    if(!_integral)
+        _integral = new IPLIntegralImage();
+    _integral->compute(image, squared);
+
+    // the preview is computed on request
+    delete _result;
+    _result = NULL;
+
+    return true;
+}
+
+IPLData* IPLIntegral::getResultData(int index)
+{
+    if(index == 1 || !_integral)
+        return _integral;
+
+    if(!_result)
+    {
+        int width = _integral->width();
+        int height = _integral->height();
+        int planes = _integral->planes();
+
+        _result = new IPLImage(planes == 3 ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE, width, height);
+        planes = std::min(planes, _result->getNumberOfPlanes());
+
+        for(int p = 0; p < planes; p++)
+        {
+            // normalized by the sum of the whole image
+            double total = _integral->sumRow(p, height)[width];
+            double scale = total > 0.0 ? 1.0 / total : 0.0;
+
+            #pragma omp parallel for
+            for(int y = 0; y < height; y++)
+            {
+                const double* row = _integral->sumRow(p, y+1) + 1;
+                float* out = &_result->plane(p)->p(0, y);
+                for(int x = 0; x < width; x++)
+                    out[x] = (float) (row[x] * scale);
+            }
+        }
+    }
+
+    return _result;
+}
@@ -0,0 +1,158 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLLaplacianPyramid.h"
+#include "IPLGaussianPyramid.h"
+
+#include <algorithm>
+
+void IPLLaplacianPyramid::init()
+{
+    // init
+    _mosaic     = NULL;
+    _pyramid    = NULL;
+    _level      = NULL;
+
+    // basic settings
+    setClassName("IPLLaplacianPyramid");
+    setTitle("Laplacian Pyramid");
+    setCategory(IPLProcess::CATEGORY_GEOMETRY);
+    setKeywords("multiscale, band-pass, blending");
+    setDescription("Builds all levels of a Laplacian pyramid. Use Collapse Pyramid to reconstruct "
+                   "or to blend two pyramids with a mask.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Mosaic", IPL_IMAGE_COLOR);
+    addOutput("Pyramid", IPL_PYRAMID);
+    addOutput("Level", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("levels", "Levels", "Number of levels including the residual", 5, IPL_WIDGET_SLIDER, 1, 10);
+    addProcessPropertyInt("level", "Output Level", "Level for the Level output, band-pass levels are shifted by 0.5", 0, IPL_WIDGET_SLIDER, 0, 9);
+}
+
+void IPLLaplacianPyramid::destroy()
+{
+    delete _mosaic;
+    delete _pyramid;
+    delete _level;
+}
+
+bool IPLLaplacianPyramid::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    if(image->type() == IPL_IMAGE_ORIENTED)
+    {
+        addError("Oriented images are not supported.");
+        return false;
+    }
+
+    // delete previous result
+    delete _mosaic;
+    _mosaic = NULL;
+    delete _pyramid;
+    _pyramid = NULL;
+    delete _level;
+    _level = NULL;
+
+    // get properties
+    int levels  = getProcessPropertyInt("levels");
+    int level   = getProcessPropertyInt("level");
+
+    notifyProgressEventHandler(-1);
+
+    _pyramid = IPLLaplacianPyramid::build(image, levels);
+    _mosaic  = IPLGaussianPyramid::mosaic(_pyramid);
+
+    if(_pyramid->levels() < levels)
+        addWarning("The image is too small for " + std::to_string(levels) + " levels.");
+
+    // band-pass levels are shifted for display
+    level = std::min(level, _pyramid->levels()-1);
+    IPLImage* selected = _pyramid->level(level);
+    _level = new IPLImage(selected->type(), selected->width(), selected->height());
+    ipl_basetype offset = (level < _pyramid->levels()-1) ? 0.5f : 0.0f;
+    for(int planeNr = 0; planeNr < _level->getNumberOfPlanes(); planeNr++)
+    {
+        IPLImagePlane* plane = selected->plane(planeNr);
+        IPLImagePlane* levelPlane = _level->plane(planeNr);
+
+        #pragma omp parallel for
+        for(int y = 0; y < selected->height(); y++)
+        {
+            for(int x = 0; x < selected->width(); x++)
+                levelPlane->p(x, y) = std::max(0.0f, std::min(1.0f, plane->p(x, y) + offset));
+        }
+    }
+
+    addInformation("Levels: " + std::to_string(_pyramid->levels()));
+
+    return true;
+}
+
+IPLData* IPLLaplacianPyramid::getResultData(int index)
+{
+    if(index == 0)
+        return _mosaic;
+    else if(index == 1)
+        return _pyramid;
+
+    return _level;
+}
+
+/*!
+ * \brief IPLLaplacianPyramid::build creates a Laplacian pyramid
+ * L(i) = G(i) - expand(G(i+1)), the last level is the Gaussian residual.
+ */
+IPLPyramid* IPLLaplacianPyramid::build(IPLImage* image, int levels)
+{
+    IPLPyramid* gaussian = IPLGaussianPyramid::build(image, levels);
+    IPLPyramid* pyramid = new IPLPyramid(true);
+
+    for(int i = 0; i < gaussian->levels()-1; i++)
+    {
+        IPLImage* current = gaussian->level(i);
+        IPLImage* band = new IPLImage(current->type(), current->width(), current->height());
+        IPLGaussianPyramid::expand(gaussian->level(i+1), band);
+
+        int width = current->width();
+        for(int planeNr = 0; planeNr < band->getNumberOfPlanes(); planeNr++)
+        {
+            IPLImagePlane* plane = current->plane(planeNr);
+            IPLImagePlane* bandPlane = band->plane(planeNr);
+
+            #pragma omp parallel for
+            for(int y = 0; y < current->height(); y++)
+            {
+                const ipl_basetype* in = &plane->p(0, y);
+                ipl_basetype* out = &bandPlane->p(0, y);
+                for(int x = 0; x < width; x++)
+                    out[x] = in[x] - out[x];
+            }
+        }
+        pyramid->addLevel(band);
+    }
+
+    pyramid->addLevel(new IPLImage(*gaussian->level(gaussian->levels()-1)));
+    delete gaussian;
+
+    return pyramid;
+}
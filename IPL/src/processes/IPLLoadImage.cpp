@@ -41,9 +41,11 @@ void IPLLoadImage::init()
                              "*.bmp, *.gif, *.hdr, *.jpg, *.png, *.psd, *.tiff, *.cr2 and many more...",
                              _path, IPL_WIDGET_FILE_OPEN);
     addProcessPropertyInt("mode", "Mode:Normal|RAW", "normal|raw", 0, IPL_WIDGET_GROUP);
-    addProcessPropertyInt("raw_width", "Width", "", 512, IPL_WIDGET_SLIDER, 1, 4096);
-    addProcessPropertyInt("raw_height", "Height", "", 512, IPL_WIDGET_SLIDER, 1, 4096);
-    addProcessPropertyInt("raw_format", "Pixel format:8 bit (Grayscale)|24 bit (RGB)|24 bit (BGR)|32 bit (RGBA)|32 bit (ABGR)", "", 0, IPL_WIDGET_COMBOBOX);
+    addProcessPropertyInt("raw_width", "Width", "", 512, IPL_WIDGET_SLIDER, 1, 16384);
+    addProcessPropertyInt("raw_height", "Height", "", 512, IPL_WIDGET_SLIDER, 1, 16384);
+    addProcessPropertyInt("raw_format", "Pixel format:8 bit (Grayscale)|24 bit (RGB)|24 bit (BGR)|32 bit (RGBA)|32 bit (ABGR)|16 bit (Grayscale)", "", 0, IPL_WIDGET_COMBOBOX);
+    addProcessPropertyInt("raw_bits", "Used Bits", "Used bits of 16 bit pixels (little endian), e.g. 12 for a 12 bit sensor",
+                          16, IPL_WIDGET_SLIDER, 9, 16);
     addProcessPropertyInt("raw_interleaved", "Byte Order:Interleaved|Planar",
                           "If you know your files's dimensions and byte order, you can load it as RAW data.",
                           0, IPL_WIDGET_COMBOBOX);
@@ -72,6 +74,7 @@ bool IPLLoadImage::processInputData(IPLData*, int, bool)
     int raw_height  = getProcessPropertyInt("raw_height");
     int raw_format  = getProcessPropertyInt("raw_format");
     int raw_interleaved  = getProcessPropertyInt("raw_interleaved");
+    int raw_bits    = getProcessPropertyInt("raw_bits");
 
     bool interleaved = (raw_interleaved == 0);
 
@@ -92,7 +95,7 @@ bool IPLLoadImage::processInputData(IPLData*, int, bool)
     if(mode == 0)
         success = IPLFileIO::loadFile(_path, this->_result, information);
     else
-        success = IPLFileIO::loadRawFile(_path, this->_result, raw_width, raw_height, (IPLRawImageType) raw_format, interleaved, information);
+        success = IPLFileIO::loadRawFile(_path, this->_result, raw_width, raw_height, (IPLRawImageType) raw_format, interleaved, information, raw_bits);
 
     if(success)
     {
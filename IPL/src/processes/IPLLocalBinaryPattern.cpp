@@ -0,0 +1,302 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLLocalBinaryPattern.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+//! top left pixel offset and bilinear weights of one neighbour
+struct Sample
+{
+    int     offset;
+    float   w00, w01, w10, w11;
+};
+
+//! interpolated samples equal to the center up to rounding count as greater or equal
+const float LBP_EPSILON = 1e-6f;
+
+inline unsigned int rotateRight(unsigned int code, int bits)
+{
+    unsigned int mask = (1u << bits) - 1;
+    return ((code >> 1) | (code << (bits-1))) & mask;
+}
+
+inline int bitCount(unsigned int code)
+{
+    int count = 0;
+    for(; code; code &= code - 1)
+        count++;
+    return count;
+}
+
+//! 0/1 transitions in the circular code
+inline int transitions(unsigned int code, int bits)
+{
+    return bitCount(code ^ rotateRight(code, bits));
+}
+
+//! compares one neighbour with a row of centers, sets bit where neighbour >= center
+inline void compareRow(const float* center, const Sample& s, int pitch, unsigned int bit,
+                       unsigned int* code, int width)
+{
+    const float* p00 = center + s.offset;
+    const float* p01 = p00 + 1;
+    const float* p10 = p00 + pitch;
+    const float* p11 = p10 + 1;
+    for(int x = 0; x < width; x++)
+    {
+        float v = s.w00*p00[x] + s.w01*p01[x] + s.w10*p10[x] + s.w11*p11[x];
+        code[x] |= (v - center[x] >= -LBP_EPSILON) ? bit : 0u;
+    }
+}
+}
+
+void IPLLocalBinaryPattern::init()
+{
+    // init
+    _result     = NULL;
+    _histograms = NULL;
+
+    // basic settings
+    setClassName("IPLLocalBinaryPattern");
+    setTitle("Local Binary Pattern");
+    setCategory(IPLProcess::CATEGORY_LOCALOPERATIONS);
+    setKeywords("LBP, texture, uniform, rotation invariant, histogram, descriptor");
+    setDescription("Local binary pattern texture labels with 8 or 16 neighbours on a circle. The label image "
+                   "is scaled to 0..1, the optional histograms hold the normalized label histogram of every "
+                   "cell, one row per cell.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_GRAYSCALE);
+    addOutput("Image", IPL_IMAGE_GRAYSCALE);
+    addOutput("Histograms", IPL_MATRIX);
+
+    // properties
+    addProcessPropertyInt("mode", "Mode:Basic|Uniform|Rotation Invariant|Uniform Rotation Invariant", "",
+                          MODE_BASIC, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("neighbours", "Neighbours:8|16", "", 0, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyDouble("radius", "Radius", "", 1.0, IPL_WIDGET_SLIDER, 1.0, 8.0);
+    addProcessPropertyBool("interpolation", "Interpolation", "Bilinear interpolation, otherwise the nearest pixel",
+                           true, IPL_WIDGET_CHECKBOXES);
+    addProcessPropertyBool("histograms", "Cell Histograms", "", false, IPL_WIDGET_CHECKBOXES);
+    addProcessPropertyInt("cell_size", "Cell Size", "", 16, IPL_WIDGET_SLIDER, 4, 128);
+}
+
+void IPLLocalBinaryPattern::destroy()
+{
+    delete _result;
+    delete _histograms;
+}
+
+bool IPLLocalBinaryPattern::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    int mode            = getProcessPropertyInt("mode");
+    int neighbours      = getProcessPropertyInt("neighbours") == 0 ? 8 : 16;
+    float radius        = getProcessPropertyDouble("radius");
+    bool interpolation  = getProcessPropertyBool("interpolation");
+    bool histograms     = getProcessPropertyBool("histograms");
+    int cellSize        = getProcessPropertyInt("cell_size");
+
+    std::vector<int> table;
+    int labels = mapping(mode, neighbours, table);
+
+    if(histograms && labels > 65536 / 8)
+    {
+        addError("Histograms of basic 16 neighbour codes are too large, use a uniform or rotation invariant mode.");
+        return false;
+    }
+
+    int width = image->width();
+    int height = image->height();
+
+    notifyProgressEventHandler(-1);
+
+    // copy with replicated border so every sample is inside
+    int border = (int) std::ceil(radius) + 1;
+    int pitch = width + 2*border;
+    std::vector<float> padded((size_t) pitch * (height + 2*border));
+    #pragma omp parallel for
+    for(int y = -border; y < height + border; y++)
+    {
+        const float* in = &image->plane(0)->p(0, std::min(height-1, std::max(0, y)));
+        float* out = &padded[(size_t) (y + border) * pitch + border];
+        for(int x = -border; x < width + border; x++)
+            out[x] = in[std::min(width-1, std::max(0, x))];
+    }
+
+    // neighbours counterclockwise starting on the right
+    std::vector<Sample> samples(neighbours);
+    for(int k = 0; k < neighbours; k++)
+    {
+        float angle = 2.0f * (float) PI * k / neighbours;
+        float dx = radius * std::cos(angle);
+        float dy = -radius * std::sin(angle);
+
+        Sample& s = samples[k];
+        if(!interpolation)
+        {
+            s.offset = (int) std::floor(dy + 0.5f) * pitch + (int) std::floor(dx + 0.5f);
+            s.w00 = 1.0f;
+            s.w01 = s.w10 = s.w11 = 0.0f;
+            continue;
+        }
+
+        // exact pixel positions get exact weights
+        float x0 = std::floor(dx);
+        float y0 = std::floor(dy);
+        float fx = dx - x0;
+        float fy = dy - y0;
+        if(fx < 1e-5f)          { fx = 0.0f; }
+        if(fx > 1.0f - 1e-5f)   { fx = 0.0f; x0 += 1.0f; }
+        if(fy < 1e-5f)          { fy = 0.0f; }
+        if(fy > 1.0f - 1e-5f)   { fy = 0.0f; y0 += 1.0f; }
+
+        s.offset = (int) y0 * pitch + (int) x0;
+        s.w00 = (1.0f - fx) * (1.0f - fy);
+        s.w01 = fx * (1.0f - fy);
+        s.w10 = (1.0f - fx) * fy;
+        s.w11 = fx * fy;
+    }
+
+    // reuse the result if possible
+    if(!_result || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        _result = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+    }
+
+    // one band of rows per cell row so the histograms need no synchronization
+    int band = histograms ? cellSize : 16;
+    int bands = (height + band - 1) / band;
+    int cellsX = (width + cellSize - 1) / cellSize;
+    std::vector<float> cellHistograms(histograms ? (size_t) bands * cellsX * labels : 0, 0.0f);
+    float scale = labels > 1 ? 1.0f / (labels - 1) : 0.0f;
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int b = 0; b < bands; b++)
+    {
+        std::vector<unsigned int> code(width);
+        float* histogram = histograms ? &cellHistograms[(size_t) b * cellsX * labels] : NULL;
+
+        for(int y = b*band; y < std::min(height, (b+1)*band); y++)
+        {
+            const float* center = &padded[(size_t) (y + border) * pitch + border];
+            std::fill(code.begin(), code.end(), 0u);
+            for(int k = 0; k < neighbours; k++)
+                compareRow(center, samples[k], pitch, 1u << k, &code[0], width);
+
+            float* out = &_result->plane(0)->p(0, y);
+            for(int x = 0; x < width; x++)
+            {
+                int label = table[code[x]];
+                out[x] = label * scale;
+                if(histogram)
+                    histogram[(x / cellSize) * labels + label] += 1.0f;
+            }
+        }
+    }
+
+    delete _histograms;
+    _histograms = NULL;
+    if(histograms)
+    {
+        // normalize by the pixels of every cell, border cells may be smaller
+        int cells = bands * cellsX;
+        for(int c = 0; c < cells; c++)
+        {
+            int cellWidth = std::min(cellSize, width - (c % cellsX) * cellSize);
+            int cellHeight = std::min(cellSize, height - (c / cellsX) * cellSize);
+            float normalize = 1.0f / (cellWidth * cellHeight);
+            float* histogram = &cellHistograms[(size_t) c * labels];
+            for(int i = 0; i < labels; i++)
+                histogram[i] *= normalize;
+        }
+        _histograms = new IPLMatrix(cells, labels, &cellHistograms[0]);
+
+        std::stringstream s;
+        s << "Cells: " << cellsX << "x" << bands << ", bins: " << labels;
+        addInformation(s.str());
+    }
+
+    return true;
+}
+
+IPLData* IPLLocalBinaryPattern::getResultData(int index)
+{
+    if(index == 0)
+        return _result;
+    return _histograms;
+}
+
+/*!
+ * \brief IPLLocalBinaryPattern::mapping fills the table from codes to labels
+ * Returns the number of labels.
+ */
+int IPLLocalBinaryPattern::mapping(int mode, int neighbours, std::vector<int>& table)
+{
+    int codes = 1 << neighbours;
+    table.resize(codes);
+
+    if(mode == MODE_UNIFORM)
+    {
+        int nonUniform = neighbours * (neighbours - 1) + 2;
+        int next = 0;
+        for(int code = 0; code < codes; code++)
+            table[code] = transitions(code, neighbours) <= 2 ? next++ : nonUniform;
+        return nonUniform + 1;
+    }
+
+    if(mode == MODE_ROTATION_INVARIANT)
+    {
+        // minimum rotation, the distinct minima are numbered in order
+        std::vector<int> label(codes, -1);
+        int next = 0;
+        for(int code = 0; code < codes; code++)
+        {
+            unsigned int minimum = code;
+            unsigned int rotated = code;
+            for(int k = 1; k < neighbours; k++)
+            {
+                rotated = rotateRight(rotated, neighbours);
+                minimum = std::min(minimum, rotated);
+            }
+            if(label[minimum] < 0)
+                label[minimum] = next++;
+            table[code] = label[minimum];
+        }
+        return next;
+    }
+
+    if(mode == MODE_UNIFORM_ROTATION_INVARIANT)
+    {
+        for(int code = 0; code < codes; code++)
+            table[code] = transitions(code, neighbours) <= 2 ? bitCount(code) : neighbours + 1;
+        return neighbours + 2;
+    }
+
+    for(int code = 0; code < codes; code++)
+        table[code] = code;
+    return codes;
+}
@@ -19,6 +19,9 @@
 
 #include "IPLLocalThreshold.h"
 
+#include <algorithm>
+#include <cmath>
+
 void IPLLocalThreshold::init()
 {
     // init
@@ -64,44 +67,29 @@ bool IPLLocalThreshold::processInputData(IPLData* data, int, bool)
     int window = getProcessPropertyInt("window");
     float aboveMean = getProcessPropertyDouble("aboveMean");
 
-    int progress = 0;
-    int maxProgress = image->height() * image->getNumberOfPlanes();
     int nrOfPlanes = image->getNumberOfPlanes();
 
-    #pragma omp parallel for
-    for( int planeNr=0; planeNr < nrOfPlanes; planeNr++ )
-    {
-        IPLImagePlane* plane = image->plane( planeNr );
-        IPLImagePlane* newplane = _result->plane( planeNr );
+    notifyProgressEventHandler(-1);
+
+    // sums of the pixels and the squared pixels
+    _integral.compute(image, true);
 
-        int w2 = window/2;
-        double area = (double)window*(double)window;
+    int w2 = window/2;
+    double area = (double)window*(double)window;
 
-        for(int y=w2; y < height-w2; y++)
+    #pragma omp parallel for
+    for(int y=w2; y < height-w2; y++)
+    {
+        for( int planeNr=0; planeNr < nrOfPlanes; planeNr++ )
         {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
+            IPLImagePlane* plane = image->plane( planeNr );
+            IPLImagePlane* newplane = _result->plane( planeNr );
+
             for(int x=w2; x < width-w2; x++)
             {
-                double localMean = 0.0;
-                for( int kx=-w2; kx<=w2; kx++ )
-                {
-                    for( int ky=-w2; ky<=w2; ky++ )
-                    {
-                        localMean += (double)plane->p(x+kx,y+ky);
-                    }
-                }
-                localMean /= area;
-                double deviation = 0.0;
-                for( int kx=-w2; kx<=w2; kx++ )
-                {
-                    for( int ky=-w2; ky<=w2; ky++ )
-                    {
-                        double diff =  (double)plane->p(x+kx, y+ky) - localMean;
-                        deviation += diff * diff;
-                    }
-                }
-                deviation = sqrt( deviation / area );
+                double localMean = _integral.sum(planeNr, x-w2, y-w2, x+w2+1, y+w2+1) / area;
+                double squaredMean = _integral.squaredSum(planeNr, x-w2, y-w2, x+w2+1, y+w2+1) / area;
+                double deviation = sqrt( std::max(0.0, squaredMean - localMean*localMean) );
                 double T = (localMean + aboveMean*deviation);
 
                 newplane->p(x,y) = (plane->p(x,y) >= T) ? 1.0 : 0.0;
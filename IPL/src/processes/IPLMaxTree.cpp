@@ -0,0 +1,96 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLMaxTree.h"
+
+void IPLMaxTree::init()
+{
+    // init
+    _tree       = NULL;
+    _result     = NULL;
+
+    // basic settings
+    setClassName("IPLMaxTree");
+    setTitle("Component Tree");
+    setCategory(IPLProcess::CATEGORY_MORPHOLOGY);
+    setKeywords("max-tree, min-tree, connected components, attribute, area opening");
+    setDescription("Builds the max-tree (bright components) or min-tree (dark components) of the image "
+                   "quantized to 8 or 16 bits. Connect the component tree to the Attribute Filter.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_GRAYSCALE);
+    addOutput("Image", IPL_IMAGE_GRAYSCALE);
+    addOutput("Component Tree", IPL_COMPONENT_TREE);
+
+    // properties
+    addProcessPropertyInt("tree", "Tree:Max-Tree|Min-Tree", "", 0, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("bits", "Quantization:8 bit|16 bit", "", 0, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyBool("parallel", "Parallel", "Build strips of the image in parallel and merge them",
+                           true, IPL_WIDGET_CHECKBOXES);
+}
+
+void IPLMaxTree::destroy()
+{
+    delete _tree;
+    delete _result;
+}
+
+bool IPLMaxTree::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    bool maxTree    = getProcessPropertyInt("tree") == 0;
+    int bits        = getProcessPropertyInt("bits") == 0 ? 8 : 16;
+    bool parallel   = getProcessPropertyBool("parallel");
+
+    notifyProgressEventHandler(-1);
+
+    if(!_tree)
+        _tree = new IPLComponentTree();
+    _tree->build(image, maxTree, bits, parallel);
+
+    // the preview is computed on request
+    delete _result;
+    _result = NULL;
+
+    std::stringstream s;
+    s << "Nodes: " << _tree->nodes();
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLData* IPLMaxTree::getResultData(int index)
+{
+    if(index == 1 || !_tree)
+        return _tree;
+
+    if(!_result)
+    {
+        std::vector<int> levels(_tree->nodes());
+        for(int node = 0; node < _tree->nodes(); node++)
+            levels[node] = _tree->level(node);
+
+        _result = new IPLImage(IPL_IMAGE_GRAYSCALE, _tree->width(), _tree->height());
+        _tree->reconstruct(levels, _result);
+    }
+
+    return _result;
+}
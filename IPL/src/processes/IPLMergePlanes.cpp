@@ -58,21 +58,22 @@ bool IPLMergePlanes::processInputData(IPLData* data, int imageIndex, bool)
 {
     IPLImage* image = data->toImage();
 	
-    // save the inputs
+    // save the inputs, only the first plane is used and shared without copying
+    std::vector<IPLImagePlane*> plane(1, image->plane(0));
     if(imageIndex == 0)
     {
         delete _inputA;
-        _inputA = new IPLImage(*image);
+        _inputA = new IPLImage(IPL_IMAGE_GRAYSCALE, plane);
     }
     if(imageIndex == 1)
     {
         delete _inputB;
-        _inputB = new IPLImage(*image);
+        _inputB = new IPLImage(IPL_IMAGE_GRAYSCALE, plane);
     }
     if(imageIndex == 2)
     {
         delete _inputC;
-        _inputC = new IPLImage(*image);
+        _inputC = new IPLImage(IPL_IMAGE_GRAYSCALE, plane);
     }
 
     // only continue if we have 3 valid inputs
@@ -88,7 +89,22 @@ bool IPLMergePlanes::processInputData(IPLData* data, int imageIndex, bool)
     int height  = std::max(std::max(_inputA->height(), _inputB->height()), _inputC->height());
 
     delete _result;
-    _result =  new IPLImage(IPL_IMAGE_COLOR, width, height);
+    _result = NULL;
+
+    // RGB planes of the same size are shared without copying
+    bool sameSize = _inputA->width() == _inputB->width() && _inputA->width() == _inputC->width()
+                 && _inputA->height() == _inputB->height() && _inputA->height() == _inputC->height();
+    if(inputType == 0 && sameSize)
+    {
+        std::vector<IPLImagePlane*> planes;
+        planes.push_back(_inputA->plane(0));
+        planes.push_back(_inputB->plane(0));
+        planes.push_back(_inputC->plane(0));
+        _result = new IPLImage(IPL_IMAGE_COLOR, planes);
+        return true;
+    }
+
+    _result = new IPLImage(IPL_IMAGE_COLOR, width, height);
 
     int progress = 0;
     int maxProgress = image->height() * _result->getNumberOfPlanes();
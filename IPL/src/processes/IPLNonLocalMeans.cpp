@@ -0,0 +1,284 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLNonLocalMeans.h"
+
+#include "IPLResampler.h"
+
+#include <cmath>
+
+void IPLNonLocalMeans::init()
+{
+    // init
+    _result     = NULL;
+    _progress   = 0;
+    _maxProgress = 1;
+
+    // basic settings
+    setClassName("IPLNonLocalMeans");
+    setTitle("Non-Local Means");
+    setDescription("Denoises an image by averaging pixels with similar neighbourhoods within the search window. "
+                   "The filter strength h is given in gray values (0..1).");
+    setKeywords("denoising, noise reduction, NLM");
+    setCategory(IPLProcess::CATEGORY_LOCALOPERATIONS);
+    setOpenCVSupport(IPLProcess::OPENCV_OPTIONAL);
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyDouble("h", "Filter Strength h", "", 0.05, IPL_WIDGET_SLIDER, 0.005, 0.5);
+    addProcessPropertyInt("patch", "Patch Size", "", 7, IPL_WIDGET_SLIDER_ODD, 3, 11);
+    addProcessPropertyInt("search", "Search Window", "", 21, IPL_WIDGET_SLIDER_ODD, 3, 35);
+    addProcessPropertyInt("color", "Color:Joint Distance|Per Plane", "", 0, IPL_WIDGET_RADIOBUTTONS);
+}
+
+void IPLNonLocalMeans::destroy()
+{
+    delete _result;
+}
+
+bool IPLNonLocalMeans::processInputData(IPLData* data, int, bool useOpenCV)
+{
+    IPLImage* image = data->toImage();
+
+    // delete previous result
+    delete _result;
+    _result = NULL;
+
+    // get properties
+    float h = getProcessPropertyDouble("h");
+    int patch = getProcessPropertyInt("patch");
+    int search = getProcessPropertyInt("search");
+    int color = getProcessPropertyInt("color");
+
+    int nrOfPlanes = image->getNumberOfPlanes();
+    IPLDataType type = image->type() == IPL_IMAGE_BW ? IPL_IMAGE_GRAYSCALE : image->type();
+
+    if(useOpenCV)
+    {
+        notifyProgressEventHandler(-1);
+
+        cv::Mat input = image->toCvMat();
+        cv::Mat result;
+        if(nrOfPlanes >= 3)
+        {
+            cv::cvtColor(input, input, cv::COLOR_BGRA2BGR);
+            cv::fastNlMeansDenoisingColored(input, result, h*255, h*255, patch, search);
+        }
+        else
+        {
+            cv::cvtColor(input, input, cv::COLOR_BGRA2GRAY);
+            cv::fastNlMeansDenoising(input, result, h*255, patch, search);
+        }
+        _result = new IPLImage(result);
+        return true;
+    }
+
+    _result = new IPLImage(type, image->width(), image->height());
+
+    _progress = 0;
+    _maxProgress = (color == 1) ? nrOfPlanes * image->height() : image->height();
+
+    if(color == 1)
+    {
+        for(int planeNr = 0; planeNr < nrOfPlanes; planeNr++)
+            denoise(image, _result, std::vector<int>(1, planeNr), h, patch/2, search/2);
+    }
+    else
+    {
+        std::vector<int> planes;
+        for(int planeNr = 0; planeNr < nrOfPlanes; planeNr++)
+            planes.push_back(planeNr);
+        denoise(image, _result, planes, h, patch/2, search/2);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief IPLNonLocalMeans::denoise filters the given planes of image into result
+ *
+ * For every offset (dx, dy) of the search window the squared difference
+ * between the image and the shifted image (mean over the planes) is
+ * integrated, every patch distance is then read with four lookups. The
+ * weight exp(-d/h²) is tabulated. The center pixel gets the largest weight
+ * of all other offsets, so it does not dominate the average.
+ */
+void IPLNonLocalMeans::denoise(IPLImage* image, IPLImage* result, const std::vector<int>& planes,
+                               float h, int patchRadius, int searchRadius)
+{
+    const int STRIP = 32;
+    const int TABLE_SIZE = 4096;
+    const float TABLE_MAX = 10.0f;      // exp(-10) is treated as 0
+
+    int width = image->width();
+    int height = image->height();
+    int nrOfPlanes = (int) planes.size();
+    int pad = patchRadius + searchRadius;
+    int paddedWidth = width + 2*pad;
+    int paddedHeight = height + 2*pad;
+
+    // reflected copies of the planes
+    std::vector<std::vector<float> > padded(nrOfPlanes);
+    for(int i = 0; i < nrOfPlanes; i++)
+    {
+        IPLImagePlane* plane = image->plane(planes[i]);
+        padded[i].resize((size_t) paddedWidth * paddedHeight);
+        for(int y = 0; y < paddedHeight; y++)
+        {
+            int sy = IPLResampler::borderIndex(y - pad, height, IPLResampler::BORDER_REFLECT);
+            float* row = &padded[i][(size_t) y * paddedWidth];
+            for(int x = 0; x < paddedWidth; x++)
+                row[x] = plane->p(IPLResampler::borderIndex(x - pad, width, IPLResampler::BORDER_REFLECT), sy);
+        }
+    }
+
+    // exp(-t) for t in [0, TABLE_MAX]
+    std::vector<float> expTable(TABLE_SIZE + 2);
+    for(int i = 0; i <= TABLE_SIZE + 1; i++)
+        expTable[i] = std::exp(-TABLE_MAX * i / TABLE_SIZE);
+    expTable[TABLE_SIZE + 1] = 0.0f;
+
+    int patchSize = 2*patchRadius + 1;
+    float scale = TABLE_SIZE / TABLE_MAX / std::max(h*h, 1e-8f) / (patchSize*patchSize) / nrOfPlanes;
+    int strips = (height + STRIP - 1) / STRIP;
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int strip = 0; strip < strips; strip++)
+    {
+        int y0 = strip * STRIP;
+        int y1 = std::min(y0 + STRIP, height);
+        int rows = y1 - y0;
+
+        // distances cover the strip plus the patch radius on all sides
+        int distWidth = width + 2*patchRadius;
+        int distHeight = rows + 2*patchRadius;
+        std::vector<float> dist(distWidth);
+        std::vector<float> weight(width);
+        std::vector<double> integral((size_t) (distWidth + 1) * (distHeight + 1), 0.0);
+        std::vector<float> weightSum((size_t) rows * width, 0.0f);
+        std::vector<float> weightMax((size_t) rows * width, 0.0f);
+        std::vector<float> sum((size_t) nrOfPlanes * rows * width, 0.0f);
+
+        for(int dy = -searchRadius; dy <= searchRadius; dy++)
+        {
+            for(int dx = -searchRadius; dx <= searchRadius; dx++)
+            {
+                if(dx == 0 && dy == 0)
+                    continue;
+
+                // integral image of the squared differences
+                for(int r = 0; r < distHeight; r++)
+                {
+                    int py = y0 - patchRadius + r + pad;
+                    int px = pad - patchRadius;
+                    std::fill(dist.begin(), dist.end(), 0.0f);
+                    for(int i = 0; i < nrOfPlanes; i++)
+                    {
+                        const float* a = &padded[i][(size_t) py * paddedWidth + px];
+                        const float* b = &padded[i][(size_t) (py + dy) * paddedWidth + px + dx];
+                        for(int c = 0; c < distWidth; c++)
+                        {
+                            float d = a[c] - b[c];
+                            dist[c] += d*d;
+                        }
+                    }
+
+                    const double* above = &integral[(size_t) r * (distWidth + 1)];
+                    double* current = &integral[(size_t) (r + 1) * (distWidth + 1)];
+                    double rowSum = 0.0;
+                    for(int c = 0; c < distWidth; c++)
+                    {
+                        rowSum += dist[c];
+                        current[c + 1] = above[c + 1] + rowSum;
+                    }
+                }
+
+                // patch distances, weights and weighted sums
+                for(int r = 0; r < rows; r++)
+                {
+                    const double* top = &integral[(size_t) r * (distWidth + 1)];
+                    const double* bottom = &integral[(size_t) (r + patchSize) * (distWidth + 1)];
+                    float* ws = &weightSum[(size_t) r * width];
+                    float* wm = &weightMax[(size_t) r * width];
+                    int py = y0 + r + pad + dy;
+
+                    for(int x = 0; x < width; x++)
+                    {
+                        double d = bottom[x + patchSize] - bottom[x] - top[x + patchSize] + top[x];
+                        float t = (float) d * scale;
+                        float w = 0.0f;
+                        if(t < TABLE_SIZE)
+                        {
+                            int i = (int) t;
+                            w = expTable[i] + (expTable[i + 1] - expTable[i]) * (t - i);
+                        }
+                        weight[x] = w;
+                    }
+
+                    for(int x = 0; x < width; x++)
+                    {
+                        ws[x] += weight[x];
+                        wm[x] = std::max(wm[x], weight[x]);
+                    }
+
+                    for(int i = 0; i < nrOfPlanes; i++)
+                    {
+                        float* s = &sum[((size_t) i * rows + r) * width];
+                        const float* shifted = &padded[i][(size_t) py * paddedWidth + pad + dx];
+                        for(int x = 0; x < width; x++)
+                            s[x] += weight[x] * shifted[x];
+                    }
+                }
+            }
+        }
+
+        // add the center pixel and normalize
+        for(int r = 0; r < rows; r++)
+        {
+            int py = y0 + r + pad;
+            for(int i = 0; i < nrOfPlanes; i++)
+            {
+                const float* center = &padded[i][(size_t) py * paddedWidth + pad];
+                const float* s = &sum[((size_t) i * rows + r) * width];
+                const float* ws = &weightSum[(size_t) r * width];
+                const float* wm = &weightMax[(size_t) r * width];
+                float* out = &result->plane(planes[i])->p(0, y0 + r);
+                for(int x = 0; x < width; x++)
+                {
+                    float wc = wm[x] > 0.0f ? wm[x] : 1.0f;
+                    out[x] = (s[x] + wc * center[x]) / (ws[x] + wc);
+                }
+            }
+        }
+
+        #pragma omp critical
+        {
+            _progress += rows;
+            notifyProgressEventHandler(100*_progress/_maxProgress);
+        }
+    }
+}
+
+IPLData* IPLNonLocalMeans::getResultData(int)
+{
+    return _result;
+}
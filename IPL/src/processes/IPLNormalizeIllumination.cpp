@@ -67,16 +67,22 @@ bool IPLNormalizeIllumination::processInputData(IPLData* data, int, bool)
     _cycles = 1 + 2*getProcessPropertyInt("cycles");
     int meanSel = getProcessPropertyInt("mean");
 
-    cv::Mat bgr32;
-    cv::Mat labMat;
-    cv::Mat splitLabMats[3];
-    cv::Mat *lMat;
-    image->toCvMat().convertTo(bgr32,CV_32F);
-    bgr32 *= 1.f/255.f;
-    cvtColor(bgr32,labMat,cv::COLOR_BGR2Lab);
-    split(labMat,splitLabMats);
-    // grab the lightness channel
-    lMat = &splitLabMats[0];
+    int width = image->width();
+    int height = image->height();
+
+    // float Lab conversion, the filters work on L in 0..100
+    IPLImage lab(IPL_IMAGE_COLOR, width, height);
+    IPLColorConversion::convert(image, &lab, IPLColorConversion::RGB, IPLColorConversion::LAB);
+
+    cv::Mat lightness(height, width, CV_32FC1);
+    for(int y = 0; y < height; y++)
+    {
+        const float* l = &lab.plane(0)->p(0, y);
+        float* row = lightness.ptr<float>(y);
+        for(int x = 0; x < width; x++)
+            row[x] = l[x] * 100.0f;
+    }
+    cv::Mat *lMat = &lightness;
 
     cv::Mat mu;
     cv::Mat result;
@@ -112,19 +118,33 @@ bool IPLNormalizeIllumination::processInputData(IPLData* data, int, bool)
     // to the lightness channel, a and b stay the same
     result = *lMat - mu + lightMean;
 
-    cv::Mat rgbResult32;
-    cv::Mat rgbResult;
-
-    // replace the lightness channel in the original with the modified
-    int from_to[] = { 0,0 };
-    mixChannels(&result,1,&labMat,1,from_to,1);
-
-    cvtColor(labMat,rgbResult32,cv::COLOR_Lab2BGR);
-    rgbResult32 *= 255.f;
-    rgbResult32.convertTo(rgbResult,CV_8U);
-
-    _result = new IPLImage(rgbResult);
-    _illumination = new IPLImage( mu );
+    // replace the lightness channel and convert back
+    _result = new IPLImage(IPL_IMAGE_COLOR, width, height);
+    _illumination = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+    for(int y = 0; y < height; y++)
+    {
+        const float* l = result.ptr<float>(y);
+        const float* m = mu.ptr<float>(y);
+        float* labL = &lab.plane(0)->p(0, y);
+        float* illumination = &_illumination->plane(0)->p(0, y);
+        for(int x = 0; x < width; x++)
+        {
+            labL[x] = l[x] * 0.01f;
+            illumination[x] = std::max(0.0f, std::min(1.0f, m[x] * 0.01f));
+        }
+    }
+    IPLColorConversion::convert(&lab, _result, IPLColorConversion::LAB, IPLColorConversion::RGB);
+
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        for(int p = 0; p < 3; p++)
+        {
+            float* row = &_result->plane(p)->p(0, y);
+            for(int x = 0; x < width; x++)
+                row[x] = std::max(0.0f, std::min(1.0f, row[x]));
+        }
+    }
 
     notifyProgressEventHandler(100);
     return true;
@@ -0,0 +1,98 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLRawVideoInput.h"
+
+void IPLRawVideoInput::init()
+{
+    // init
+    _result = NULL;
+
+    // basic settings
+    setClassName("IPLRawVideoInput");
+    setTitle("Raw Video Input");
+    setDescription("Reads headerless raw frames from stdin, e.g. from <i>ffmpeg -f rawvideo -pix_fmt gray|rgb24|gray16le|grayf32le -</i>. "
+                   "Frames are read ahead and decoded in the background. Use it with <i>ImagePlayServer --run</i> "
+                   "to process a stream without the GUI.");
+    setCategory(IPLProcess::CATEGORY_IO);
+    setKeywords("stdin, pipe, ffmpeg, rawvideo, stream");
+    setIsSource(true);
+    setIsSequence(true);
+
+    // inputs and outputs
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // all properties which can later be changed by gui
+    addProcessPropertyInt("width", "Width", "", 640, IPL_WIDGET_SPINNER, 1, 16384);
+    addProcessPropertyInt("height", "Height", "", 480, IPL_WIDGET_SPINNER, 1, 16384);
+    addProcessPropertyInt("format", "Format:gray8|rgb24|gray16|float", "", IPLRawFrameCodec::FORMAT_RGB24, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("queue_size", "Queue Size", "Frames which are read ahead", 8, IPL_WIDGET_SLIDER, 1, 64);
+    addProcessPropertyInt("wait", "Wait (ms)", "Maximum time to wait for a frame, 0 waits until the next frame or the end of the input", 0, IPL_WIDGET_SLIDER, 0, 10000);
+}
+
+void IPLRawVideoInput::destroy()
+{
+    delete _result;
+}
+
+bool IPLRawVideoInput::processInputData(IPLData*, int, bool)
+{
+    // get properties
+    int width       = getProcessPropertyInt("width");
+    int height      = getProcessPropertyInt("height");
+    int format      = getProcessPropertyInt("format");
+    int queueSize   = getProcessPropertyInt("queue_size");
+    int wait        = getProcessPropertyInt("wait");
+
+    IPLRawVideoIO::configureInput(width, height, (IPLRawFrameCodec::Format) format, queueSize);
+
+    notifyProgressEventHandler(-1);
+
+    IPLImage* image = IPLRawVideoIO::readFrame(wait);
+    if(!image)
+    {
+        if(IPLRawVideoIO::endOfInput())
+            addError("End of input stream.");
+        else
+            addError("No frame arrived in time.");
+        return false;
+    }
+
+    delete _result;
+    _result = image;
+
+    std::stringstream s;
+    s << "<b>Frames: </b>" << IPLRawVideoIO::framesRead() << "\n";
+    s << "<b>Queued: </b>" << IPLRawVideoIO::queued();
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLImage *IPLRawVideoInput::getResultData(int)
+{
+    return _result;
+}
+
+void IPLRawVideoInput::afterProcessing()
+{
+    // read the next frame as soon as this one is processed
+    if(!IPLRawVideoIO::endOfInput())
+        notifyPropertyChangedEventHandler();
+}
@@ -0,0 +1,98 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLRawVideoOutput.h"
+
+void IPLRawVideoOutput::init()
+{
+    // init
+    _result = NULL;
+    _width  = 0;
+    _height = 0;
+
+    // basic settings
+    setClassName("IPLRawVideoOutput");
+    setTitle("Raw Video Output");
+    setDescription("Writes every image as a headerless raw frame to stdout, e.g. for "
+                   "<i>ffmpeg -f rawvideo -pix_fmt gray|rgb24|gray16le|grayf32le -s WxH -i -</i>. "
+                   "All frames of a stream must have the same size.");
+    setCategory(IPLProcess::CATEGORY_IO);
+    setKeywords("stdout, pipe, ffmpeg, rawvideo, stream");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // all properties which can later be changed by gui
+    addProcessPropertyInt("format", "Format:gray8|rgb24|gray16|float", "", IPLRawFrameCodec::FORMAT_RGB24, IPL_WIDGET_RADIOBUTTONS);
+}
+
+void IPLRawVideoOutput::destroy()
+{
+    delete _result;
+}
+
+bool IPLRawVideoOutput::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    int format = getProcessPropertyInt("format");
+
+    // pass the input through without copying
+    std::vector<IPLImagePlane*> planes;
+    for(int i=0; i < image->getNumberOfPlanes(); i++)
+        planes.push_back(image->plane(i));
+    delete _result;
+    _result = new IPLImage(image->type(), planes);
+
+    // raw video has no header, the consumer only knows the first size
+    if(_width == 0)
+    {
+        _width  = image->width();
+        _height = image->height();
+    }
+    if(image->width() != _width || image->height() != _height)
+    {
+        std::stringstream s;
+        s << "The stream was started with " << _width << "x" << _height << ", the frame size can not change.";
+        addError(s.str());
+        return false;
+    }
+
+    notifyProgressEventHandler(-1);
+
+    std::string error;
+    if(!IPLRawVideoIO::writeFrame(image, (IPLRawFrameCodec::Format) format, error))
+    {
+        addError(error);
+        return false;
+    }
+
+    std::stringstream s;
+    s << "<b>Frames: </b>" << IPLRawVideoIO::framesWritten();
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLImage *IPLRawVideoOutput::getResultData(int)
+{
+    return _result;
+}
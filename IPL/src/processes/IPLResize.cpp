@@ -28,7 +28,7 @@ void IPLResize::init()
     setClassName("IPLResize");
     setTitle("Resize Image");
     setCategory(IPLProcess::CATEGORY_GEOMETRY);
-    setOpenCVSupport(IPLProcess::OPENCV_ONLY);
+    setOpenCVSupport(IPLProcess::OPENCV_OPTIONAL);
 
     // inputs and outputs
     addInput("Image", IPL_IMAGE_COLOR);
@@ -49,7 +49,7 @@ void IPLResize::destroy()
     delete _result;
 }
 
-bool IPLResize::processInputData(IPLData* data, int, bool)
+bool IPLResize::processInputData(IPLData* data, int, bool useOpenCV)
 {
     IPLImage* image = data->toImage();
 	
@@ -92,6 +92,28 @@ bool IPLResize::processInputData(IPLData* data, int, bool)
 
     notifyProgressEventHandler(-1);
 
+    if(!useOpenCV)
+    {
+        if(mode == 1)
+        {
+            width = (int) std::floor(image->width() * factor_x + 0.5);
+            height = (int) std::floor(image->height() * factor_y + 0.5);
+        }
+        width = std::max(width, 1);
+        height = std::max(height, 1);
+
+        // binary images stay binary only with nearest neighbour
+        IPLDataType type = image->type();
+        if(type == IPL_IMAGE_BW && interpolation != IPLResampler::INTER_NEAREST)
+            type = IPL_IMAGE_GRAYSCALE;
+
+        delete _result;
+        _result = new IPLImage(type, width, height);
+        IPLResampler::resize(image, _result, interpolation);
+
+        return true;
+    }
+
     cv::Mat result;
     if(mode == 0)
         cv::resize(image->toCvMat(), result, cv::Size(width, height), 0, 0, interpolation);
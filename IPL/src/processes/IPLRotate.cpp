@@ -28,7 +28,7 @@ void IPLRotate::init()
     setClassName("IPLRotate");
     setTitle("Rotate/Zoom Image");
     setCategory(IPLProcess::CATEGORY_GEOMETRY);
-    setOpenCVSupport(IPLProcess::OPENCV_ONLY);
+    setOpenCVSupport(IPLProcess::OPENCV_OPTIONAL);
 
     // inputs and outputs
     addInput("Image", IPL_IMAGE_COLOR);
@@ -46,7 +46,7 @@ void IPLRotate::destroy()
     delete _result;
 }
 
-bool IPLRotate::processInputData(IPLData* data, int, bool)
+bool IPLRotate::processInputData(IPLData* data, int, bool useOpenCV)
 {
     IPLImage* image = data->toImage();
 	
@@ -71,7 +71,22 @@ bool IPLRotate::processInputData(IPLData* data, int, bool)
     s << "<b>Width</b>: " << width;
     addInformation(s.str());*/
 
-    _result = new IPLImage(image->type(), image->width(), image->height());
+    if(!useOpenCV)
+    {
+        IPLDataType type = image->type();
+        if(type == IPL_IMAGE_BW && interpolation != IPLResampler::INTER_NEAREST)
+            type = IPL_IMAGE_GRAYSCALE;
+
+        double matrix[6];
+        IPLResampler::rotationMatrix(center.x(), center.y(), angle, scale, matrix);
+
+        notifyProgressEventHandler(-1);
+
+        _result = new IPLImage(type, image->width(), image->height());
+        IPLResampler::warpAffine(image, _result, matrix, interpolation);
+
+        return true;
+    }
 
     cv::Mat result;
 
@@ -0,0 +1,143 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLSharedMemoryInput.h"
+
+void IPLSharedMemoryInput::init()
+{
+    // init
+    _result     = NULL;
+    _ring       = NULL;
+    _name       = "";
+    _sequence   = 0;
+    _skipped    = 0;
+    _deliver    = true;
+
+    // basic settings
+    setClassName("IPLSharedMemoryInput");
+    setTitle("Shared Memory Input");
+    setDescription("Reads frames from a POSIX shared-memory ring buffer which is created by another process, "
+                   "see IPLSharedMemoryRing.h for the layout. Frames in float format are used without copying. "
+                   "<i>Latest Only</i> skips frames which are queued when processing is too slow. Linux only.");
+    setCategory(IPLProcess::CATEGORY_IO);
+    setKeywords("shm, ring buffer, stream, acquisition");
+    setIsSource(true);
+    setIsSequence(true);
+
+    // inputs and outputs
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // all properties which can later be changed by gui
+    addProcessPropertyString("name", "Name", "POSIX shared memory name", "/imageplay_in", IPL_WIDGET_TEXTFIELD);
+    addProcessPropertyBool("latest_only", "Latest Only", "", false, IPL_WIDGET_CHECKBOXES);
+    addProcessPropertyInt("wait", "Wait (ms)", "Maximum time to wait for a new frame per execution", 50, IPL_WIDGET_SLIDER, 1, 1000);
+}
+
+void IPLSharedMemoryInput::destroy()
+{
+    delete _result;
+    delete _ring;
+}
+
+bool IPLSharedMemoryInput::processInputData(IPLData*, int, bool)
+{
+    // get properties
+    std::string name    = getProcessPropertyString("name");
+    bool latestOnly     = getProcessPropertyBool("latest_only");
+    int wait            = getProcessPropertyInt("wait");
+
+    if(!_ring)
+        _ring = new IPLSharedMemoryRing;
+
+    // attach again when the name changed or the producer created a new ring
+    if(name != _name || !_ring->isValid())
+    {
+        _name = name;
+        _deliver = true;
+
+        std::string error;
+        if(!_ring->attach(_name, error))
+        {
+            addError(error);
+            return false;
+        }
+    }
+
+    notifyProgressEventHandler(-1);
+
+    // the following steps only run when afterProcessing announced a new frame,
+    // otherwise just wait for the next one without consuming it
+    if(_deliver)
+    {
+        uint64_t sequence = 0;
+        std::string error;
+        IPLImage* image = _ring->read(wait, latestOnly, sequence, error);
+        if(!error.empty())
+            addWarning(error);
+
+        if(image)
+        {
+            if(_result && sequence > _sequence + 1)
+                _skipped += sequence - _sequence - 1;
+
+            // releases the slot of the previous frame
+            delete _result;
+            _result = image;
+            _sequence = sequence;
+        }
+    }
+    else
+    {
+        _ring->waitForFrame(wait);
+    }
+
+    const char* formatNames[] = {"gray8", "rgb24", "gray16", "gray float", "RGB float"};
+
+    std::stringstream s;
+    s << "<b>Ring: </b>" << _ring->width() << "x" << _ring->height() << " "
+      << formatNames[_ring->format()] << ", " << _ring->slotCount() << " slots\n";
+    if(_result)
+        s << "<b>Sequence: </b>" << _sequence << "\n";
+    else
+        s << "Waiting for frames\n";
+    s << "<b>Queued: </b>" << _ring->queued() << "\n";
+    s << "<b>Skipped: </b>" << _skipped;
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLImage *IPLSharedMemoryInput::getResultData(int)
+{
+    return _result;
+}
+
+void IPLSharedMemoryInput::afterProcessing()
+{
+    if(!_ring || !_ring->isValid())
+        return;
+
+    // a queued frame runs the whole chain, otherwise only this process is
+    // executed again to keep waiting
+    _deliver = _ring->queued() > 0;
+    if(_deliver)
+        notifyPropertyChangedEventHandler();
+    else
+        setUpdateNeeded(true);
+}
@@ -0,0 +1,115 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLSharedMemoryOutput.h"
+
+void IPLSharedMemoryOutput::init()
+{
+    // init
+    _result     = NULL;
+    _ring       = NULL;
+    _slots      = 0;
+    _dropped    = 0;
+
+    // basic settings
+    setClassName("IPLSharedMemoryOutput");
+    setTitle("Shared Memory Output");
+    setDescription("Publishes every image to a POSIX shared-memory ring buffer which can be read by another process, "
+                   "see IPLSharedMemoryRing.h for the layout. When all slots are in use, the process waits up to "
+                   "<i>Wait</i> milliseconds for a free slot and drops the frame otherwise. Linux only.");
+    setCategory(IPLProcess::CATEGORY_IO);
+    setKeywords("shm, ring buffer, stream");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // all properties which can later be changed by gui
+    addProcessPropertyString("name", "Name", "POSIX shared memory name", "/imageplay_out", IPL_WIDGET_TEXTFIELD);
+    addProcessPropertyInt("format", "Format:Gray 8 bit|RGB 24 bit|Gray 16 bit|Gray Float|RGB Float", "",
+                          IPLRawFrameCodec::FORMAT_RGB24, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("slots", "Slots", "Number of frames in the ring", 4, IPL_WIDGET_SLIDER, 2, 64);
+    addProcessPropertyInt("wait", "Wait (ms)", "Maximum time to wait for a free slot, 0 drops frames immediately", 0, IPL_WIDGET_SLIDER, 0, 1000);
+}
+
+void IPLSharedMemoryOutput::destroy()
+{
+    delete _result;
+    delete _ring;
+}
+
+bool IPLSharedMemoryOutput::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // get properties
+    std::string name    = getProcessPropertyString("name");
+    IPLRawFrameCodec::Format format = (IPLRawFrameCodec::Format) getProcessPropertyInt("format");
+    int slots           = getProcessPropertyInt("slots");
+    int wait            = getProcessPropertyInt("wait");
+
+    // pass the input through without copying
+    std::vector<IPLImagePlane*> planes;
+    for(int i=0; i < image->getNumberOfPlanes(); i++)
+        planes.push_back(image->plane(i));
+    delete _result;
+    _result = new IPLImage(image->type(), planes);
+
+    if(!_ring)
+        _ring = new IPLSharedMemoryRing;
+
+    if(!_ring->isOpen() || name != _ring->name() || format != _ring->format() || slots != _slots
+            || image->width() != _ring->width() || image->height() != _ring->height())
+    {
+        _slots = slots;
+        _dropped = 0;
+
+        std::string error;
+        if(!_ring->create(name, image->width(), image->height(), format, slots, error))
+        {
+            addError(error);
+            return false;
+        }
+    }
+
+    notifyProgressEventHandler(-1);
+
+    uint64_t sequence = 0;
+    bool published = _ring->write(image, wait, sequence);
+    if(!published)
+    {
+        _dropped++;
+        addWarning("No free slot, the frame was dropped.");
+    }
+
+    std::stringstream s;
+    s << "<b>Ring: </b>" << _ring->name() << ", " << _ring->width() << "x" << _ring->height() << "\n";
+    if(published)
+        s << "<b>Sequence: </b>" << sequence << "\n";
+    s << "<b>Queued: </b>" << _ring->queued() << "\n";
+    s << "<b>Dropped: </b>" << _dropped;
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLImage *IPLSharedMemoryOutput::getResultData(int)
+{
+    return _result;
+}
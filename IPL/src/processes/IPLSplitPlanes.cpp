@@ -28,11 +28,11 @@ void IPLSplitPlanes::init()
     // basic settings
     setClassName("IPLSplitPlanes");
     setTitle("Split Planes");
-    setKeywords("RGB, HSV, HSL, channels");
+    setKeywords("RGB, HSV, HSL, Lab, YCbCr, XYZ, channels");
     setCategory(IPLProcess::CATEGORY_CONVERSIONS);
 
     // properties
-    addProcessPropertyInt("output_type", "Color Model:RGB|HSV|HSL", "", _outputType, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("output_type", "Color Model:RGB|HSV|HSL|Lab|YCbCr|XYZ", "", _outputType, IPL_WIDGET_RADIOBUTTONS);
     addProcessPropertyInt("hue_shift", "Hue Shift", "0° - 360°", _hueShift, IPL_WIDGET_SLIDER, 0, 360);
 
     // inputs and outputs
@@ -70,101 +70,54 @@ bool IPLSplitPlanes::processInputData(IPLData* data, int, bool)
     int outputType = getProcessPropertyInt("output_type");
     float hueShift = getProcessPropertyInt("hue_shift") / 360.0;
 
-    int progress = 0;
-    int maxProgress = image->height() * image->getNumberOfPlanes();
+    static const int spaces[] = { IPLColorConversion::RGB, IPLColorConversion::HSV, IPLColorConversion::HSL,
+                                  IPLColorConversion::LAB, IPLColorConversion::YCBCR, IPLColorConversion::XYZ };
+    static const char* names[][3] = { {"Red", "Green", "Blue"},
+                                      {"Hue", "Saturation", "Value"},
+                                      {"Hue", "Saturation", "Lightness"},
+                                      {"L", "a", "b"},
+                                      {"Y", "Cb", "Cr"},
+                                      {"X", "Y", "Z"} };
+    outputType = std::max(0, std::min(outputType, 5));
+    int space = spaces[outputType];
 
-    // RGB
-    if(outputType == 0)
-    {
-        setOutputName(0, "Red");
-        setOutputName(1, "Green");
-        setOutputName(2, "Blue");
+    for(int i=0; i<3; i++)
+        setOutputName(i, names[outputType][i]);
+
+    notifyProgressEventHandler(-1);
 
+    // RGB, the outputs share the planes of the input
+    if(space == IPLColorConversion::RGB)
+    {
         for( int planeNr=0; planeNr < image->getNumberOfPlanes(); planeNr++ )
         {
-            IPLImage* newImage = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-            _result.push_back(newImage);
-
-            // copy data
-            for(int y=0; y<height; y++)
-            {
-                // progress
-                notifyProgressEventHandler(100*progress++/maxProgress);
-
-                for(int x=0; x<width; x++)
-                {
-                    newImage->plane(0)->p(x, y) = image->plane(planeNr)->p(x, y);
-                }
-            }
+            std::vector<IPLImagePlane*> plane(1, image->plane(planeNr));
+            _result.push_back(new IPLImage(IPL_IMAGE_GRAYSCALE, plane));
         }
+        return true;
     }
-    // HSV
-    else if(outputType == 1)
-    {
-        IPLImage* image_h = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-        IPLImage* image_s = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-        IPLImage* image_v = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-        _result.push_back(image_h);
-        _result.push_back(image_s);
-        _result.push_back(image_v);
-
-        IPLImagePlane* input_r = image->plane(0);
-        IPLImagePlane* input_g = image->plane(1);
-        IPLImagePlane* input_b = image->plane(2);
-
-        setOutputName(0, "Hue");
-        setOutputName(1, "Saturation");
-        setOutputName(2, "Value");
-
-        // copy data
-        for(int y=0; y<height; y++)
-        {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
 
-            for(int x=0; x<width; x++)
-            {
-                float hsv[3];
-                IPLColor::rgbToHsv(input_r->p(x,y), input_g->p(x,y), input_b->p(x,y), hsv);
-                float hue = fmod(hsv[0] + hueShift, 1.0);
-                image_h->plane(0)->p(x, y) = hue;
-                image_s->plane(0)->p(x, y) = hsv[1];
-                image_v->plane(0)->p(x, y) = hsv[2];
-            }
-        }
+    // other color models, converted directly into the output planes
+    IPLImagePlane* input[3];
+    IPLImagePlane* output[3];
+    for(int i=0; i<3; i++)
+    {
+        _result.push_back(new IPLImage(IPL_IMAGE_GRAYSCALE, width, height));
+        input[i] = image->plane(image->getNumberOfPlanes() >= 3 ? i : 0);
+        output[i] = _result[i]->plane(0);
     }
-    // HSL
-    else if(outputType == 2)
+    IPLColorConversion::convert(input, output, IPLColorConversion::RGB, space);
+
+    if((space == IPLColorConversion::HSV || space == IPLColorConversion::HSL) && hueShift > 0)
     {
-        IPLImage* image_h = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-        IPLImage* image_s = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-        IPLImage* image_l = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
-        _result.push_back(image_h);
-        _result.push_back(image_s);
-        _result.push_back(image_l);
-
-        IPLImagePlane* input_r = image->plane(0);
-        IPLImagePlane* input_g = image->plane(1);
-        IPLImagePlane* input_b = image->plane(2);
-
-        setOutputName(0, "Hue");
-        setOutputName(1, "Saturation");
-        setOutputName(2, "Lightness");
-
-        // copy data
+        #pragma omp parallel for
         for(int y=0; y<height; y++)
         {
-            // progress
-            notifyProgressEventHandler(100*progress++/maxProgress);
-
+            float* hue = &output[0]->p(0, y);
             for(int x=0; x<width; x++)
             {
-                float hsl[3];
-                IPLColor::rgbToHsl(input_r->p(x,y), input_g->p(x,y), input_b->p(x,y), hsl);
-                float hue = fmod(hsl[0] + hueShift, 1.0);
-                image_h->plane(0)->p(x, y) = hue;
-                image_s->plane(0)->p(x, y) = hsl[1];
-                image_l->plane(0)->p(x, y) = hsl[2];
+                float h = hue[x] + hueShift;
+                hue[x] = (h >= 1.0f) ? h - 1.0f : h;
             }
         }
     }
@@ -0,0 +1,436 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLSuperpixels.h"
+#include "IPLColorConversion.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+//! cluster center in Lab and image coordinates
+struct Cluster
+{
+    float l, a, b;
+    float x, y;
+};
+
+//! squared Lab gradient at the inner pixel i
+inline float gradient(const std::vector<float>* lab, int i, int width)
+{
+    float g = 0.0f;
+    for(int c = 0; c < 3; c++)
+    {
+        const float* plane = &lab[c][0];
+        float dx = plane[i+1] - plane[i-1];
+        float dy = plane[i+width] - plane[i-width];
+        g += dx*dx + dy*dy;
+    }
+    return g;
+}
+}
+
+void IPLSuperpixels::init()
+{
+    // init
+    _result         = NULL;
+    _meanColor      = NULL;
+    _numberOfLabels = 0;
+
+    // basic settings
+    setClassName("IPLSuperpixels");
+    setTitle("Superpixels");
+    setCategory(IPLProcess::CATEGORY_OBJECTS);
+    setKeywords("SLIC, segmentation, oversegmentation, clustering, regions");
+    setDescription("SLIC superpixels: clusters the pixels by Lab color and position into compact regions of "
+                   "about the same size. Outputs the superpixel labels and the mean color of every superpixel.");
+
+    // inputs and outputs
+    addInput("Image", IPL_IMAGE_COLOR);
+    addOutput("Labels", IPL_IMAGE_GRAYSCALE);
+    addOutput("Mean Color", IPL_IMAGE_COLOR);
+
+    // properties
+    addProcessPropertyInt("superpixels", "Superpixels", "Approximate number of superpixels", 400, IPL_WIDGET_SLIDER, 4, 20000);
+    addProcessPropertyDouble("compactness", "Compactness", "Weight of the spatial distance, larger values give more regular superpixels",
+                             10.0, IPL_WIDGET_SLIDER, 1.0, 40.0);
+    addProcessPropertyInt("iterations", "Iterations", "", 10, IPL_WIDGET_SLIDER, 1, 30);
+}
+
+void IPLSuperpixels::destroy()
+{
+    delete _result;
+    delete _meanColor;
+}
+
+bool IPLSuperpixels::processInputData(IPLData* data, int, bool)
+{
+    IPLImage* image = data->toImage();
+
+    int width = image->width();
+    int height = image->height();
+    size_t pixels = (size_t) width * height;
+
+    // get properties
+    int superpixels     = std::min(getProcessPropertyInt("superpixels"), (int) pixels);
+    float compactness   = getProcessPropertyDouble("compactness");
+    int iterations      = getProcessPropertyInt("iterations");
+
+    // Lab in its natural range: L 0..100, a and b about -128..127
+    bool color = image->getNumberOfPlanes() >= 3;
+    std::vector<float> lab[3];
+    for(int c = 0; c < 3; c++)
+        lab[c].resize(pixels);
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        size_t offset = (size_t) y * width;
+        float* l = &lab[0][offset];
+        float* a = &lab[1][offset];
+        float* b = &lab[2][offset];
+        IPLColorConversion::fromRGB(IPLColorConversion::LAB,
+                                    &image->plane(0)->p(0, y),
+                                    &image->plane(color ? 1 : 0)->p(0, y),
+                                    &image->plane(color ? 2 : 0)->p(0, y),
+                                    l, a, b, width);
+        for(int x = 0; x < width; x++)
+        {
+            l[x] = l[x] * 100.0f;
+            a[x] = (a[x] - 0.5f) * 255.0f;
+            b[x] = (b[x] - 0.5f) * 255.0f;
+        }
+    }
+
+    // regular grid of cluster centers
+    float step = std::sqrt((float) pixels / superpixels);
+    int gridX = std::max(1, (int) (width / step + 0.5f));
+    int gridY = std::max(1, (int) (height / step + 0.5f));
+    float stepX = (float) width / gridX;
+    float stepY = (float) height / gridY;
+    float S = std::sqrt(stepX * stepY);
+    int clusters = gridX * gridY;
+
+    std::vector<Cluster> centers(clusters);
+    for(int j = 0; j < gridY; j++)
+    {
+        for(int i = 0; i < gridX; i++)
+        {
+            int cx = (int) ((i + 0.5f) * stepX);
+            int cy = (int) ((j + 0.5f) * stepY);
+
+            // move to the lowest gradient in the 3x3 neighbourhood
+            if(width > 2 && height > 2)
+            {
+                int bestX = cx;
+                int bestY = cy;
+                float best = -1.0f;
+                for(int y = std::max(1, cy-1); y <= std::min(height-2, cy+1); y++)
+                {
+                    for(int x = std::max(1, cx-1); x <= std::min(width-2, cx+1); x++)
+                    {
+                        float g = gradient(lab, y*width + x, width);
+                        if(best < 0.0f || g < best)
+                        {
+                            best = g;
+                            bestX = x;
+                            bestY = y;
+                        }
+                    }
+                }
+                cx = bestX;
+                cy = bestY;
+            }
+
+            Cluster& c = centers[j*gridX + i];
+            c.l = lab[0][cy*width + cx];
+            c.a = lab[1][cy*width + cx];
+            c.b = lab[2][cy*width + cx];
+            c.x = (float) cx;
+            c.y = (float) cy;
+        }
+    }
+
+    // grid cell of every column, pixels start in the cluster of their cell
+    std::vector<int> cellX(width);
+    for(int x = 0; x < width; x++)
+        cellX[x] = std::min(gridX-1, (int) (x / stepX));
+
+    _labels.resize(pixels);
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        int cellY = std::min(gridY-1, (int) (y / stepY));
+        int* label = &_labels[(size_t) y * width];
+        for(int x = 0; x < width; x++)
+            label[x] = cellY*gridX + cellX[x];
+    }
+
+    // D^2 = dc^2 + (ds/S)^2 m^2
+    float spatialWeight = (compactness * compactness) / (S * S);
+    std::vector<double> sums((size_t) clusters * 6);
+
+    for(int iteration = 0; iteration < iterations; iteration++)
+    {
+        notifyProgressEventHandler(100*iteration/iterations);
+
+        // assignment: every pixel looks at the centers of the neighbouring cells
+        #pragma omp parallel for
+        for(int y = 0; y < height; y++)
+        {
+            size_t offset = (size_t) y * width;
+            const float* l = &lab[0][offset];
+            const float* a = &lab[1][offset];
+            const float* b = &lab[2][offset];
+            int* label = &_labels[offset];
+
+            int cellY = std::min(gridY-1, (int) (y / stepY));
+            int j0 = std::max(0, cellY-1);
+            int j1 = std::min(gridY-1, cellY+1);
+
+            int x = 0;
+            for(int cell = 0; cell < gridX; cell++)
+            {
+                // centers of the neighbouring cells whose window contains this row
+                int candidates[9];
+                float rowDistance[9];
+                int count = 0;
+                for(int j = j0; j <= j1; j++)
+                {
+                    for(int i = std::max(0, cell-1); i <= std::min(gridX-1, cell+1); i++)
+                    {
+                        const Cluster& c = centers[j*gridX + i];
+                        float dy = y - c.y;
+                        if(std::abs(dy) > S)
+                            continue;
+                        candidates[count] = j*gridX + i;
+                        rowDistance[count] = dy*dy * spatialWeight;
+                        count++;
+                    }
+                }
+
+                for(; x < width && cellX[x] == cell; x++)
+                {
+                    float best = -1.0f;
+                    int bestLabel = label[x];
+                    for(int k = 0; k < count; k++)
+                    {
+                        const Cluster& c = centers[candidates[k]];
+                        float dx = x - c.x;
+
+                        // 2S x 2S search window around the center
+                        if(std::abs(dx) > S)
+                            continue;
+
+                        float dl = l[x] - c.l;
+                        float da = a[x] - c.a;
+                        float db = b[x] - c.b;
+                        float d = dl*dl + da*da + db*db + dx*dx * spatialWeight + rowDistance[k];
+                        if(best < 0.0f || d < best)
+                        {
+                            best = d;
+                            bestLabel = candidates[k];
+                        }
+                    }
+                    label[x] = bestLabel;
+                }
+            }
+        }
+
+        // update: centers move to the mean of their pixels, summed per thread
+        std::fill(sums.begin(), sums.end(), 0.0);
+        #pragma omp parallel
+        {
+            std::vector<double> local(sums.size(), 0.0);
+
+            #pragma omp for
+            for(int y = 0; y < height; y++)
+            {
+                size_t offset = (size_t) y * width;
+                const float* l = &lab[0][offset];
+                const float* a = &lab[1][offset];
+                const float* b = &lab[2][offset];
+                const int* label = &_labels[offset];
+                for(int x = 0; x < width; x++)
+                {
+                    double* sum = &local[(size_t) label[x] * 6];
+                    sum[0] += l[x];
+                    sum[1] += a[x];
+                    sum[2] += b[x];
+                    sum[3] += x;
+                    sum[4] += y;
+                    sum[5] += 1.0;
+                }
+            }
+
+            #pragma omp critical
+            for(size_t i = 0; i < sums.size(); i++)
+                sums[i] += local[i];
+        }
+
+        for(int k = 0; k < clusters; k++)
+        {
+            const double* sum = &sums[(size_t) k * 6];
+            if(sum[5] == 0.0)
+                continue;
+
+            Cluster& c = centers[k];
+            c.l = (float) (sum[0] / sum[5]);
+            c.a = (float) (sum[1] / sum[5]);
+            c.b = (float) (sum[2] / sum[5]);
+            c.x = (float) (sum[3] / sum[5]);
+            c.y = (float) (sum[4] / sum[5]);
+        }
+    }
+
+    _numberOfLabels = enforceConnectivity(_labels, width, height, std::max(1, (int) (S * S / 4)));
+
+    // mean color of every superpixel
+    std::vector<double> colorSums((size_t) _numberOfLabels * 4, 0.0);
+    for(int y = 0; y < height; y++)
+    {
+        const float* r = &image->plane(0)->p(0, y);
+        const float* g = &image->plane(color ? 1 : 0)->p(0, y);
+        const float* b = &image->plane(color ? 2 : 0)->p(0, y);
+        const int* label = &_labels[(size_t) y * width];
+        for(int x = 0; x < width; x++)
+        {
+            double* sum = &colorSums[(size_t) label[x] * 4];
+            sum[0] += r[x];
+            sum[1] += g[x];
+            sum[2] += b[x];
+            sum[3] += 1.0;
+        }
+    }
+    std::vector<float> means((size_t) _numberOfLabels * 3);
+    for(int k = 0; k < _numberOfLabels; k++)
+        for(int i = 0; i < 3; i++)
+            means[k*3 + i] = (float) (colorSums[k*4 + i] / colorSums[k*4 + 3]);
+
+    // outputs
+    if(!_result || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        delete _meanColor;
+        _result = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+        _meanColor = new IPLImage(IPL_IMAGE_COLOR, width, height);
+    }
+
+    float scale = 1.0f / _numberOfLabels;
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const int* label = &_labels[(size_t) y * width];
+        float* out = &_result->plane(0)->p(0, y);
+        float* r = &_meanColor->plane(0)->p(0, y);
+        float* g = &_meanColor->plane(1)->p(0, y);
+        float* b = &_meanColor->plane(2)->p(0, y);
+        for(int x = 0; x < width; x++)
+        {
+            const float* mean = &means[(size_t) label[x] * 3];
+            out[x] = (label[x] + 1) * scale;
+            r[x] = mean[0];
+            g[x] = mean[1];
+            b[x] = mean[2];
+        }
+    }
+
+    std::stringstream s;
+    s << "Superpixels: " << _numberOfLabels;
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLData* IPLSuperpixels::getResultData(int index)
+{
+    if(index == 0)
+        return _result;
+    return _meanColor;
+}
+
+/*!
+ * \brief IPLSuperpixels::enforceConnectivity relabels the connected components of labels as 0..n-1
+ * Components smaller than minimumSize are merged into the component of an
+ * already visited neighbour. Every pixel is visited once, returns n.
+ */
+int IPLSuperpixels::enforceConnectivity(std::vector<int>& labels, int width, int height, int minimumSize)
+{
+    size_t pixels = (size_t) width * height;
+    std::vector<int> result(pixels, -1);
+    std::vector<int> segment;
+    segment.reserve(pixels);
+
+    int count = 0;
+    int adjacent = 0;
+    for(int y = 0; y < height; y++)
+    {
+        for(int x = 0; x < width; x++)
+        {
+            int start = y*width + x;
+            if(result[start] >= 0)
+                continue;
+
+            // left and upper neighbours are already labelled
+            if(x > 0)
+                adjacent = result[start-1];
+            else if(y > 0)
+                adjacent = result[start-width];
+
+            int label = labels[start];
+            result[start] = count;
+            segment.clear();
+            segment.push_back(start);
+            for(size_t k = 0; k < segment.size(); k++)
+            {
+                int i = segment[k];
+                int px = i % width;
+                int py = i / width;
+                int neighbours[4];
+                int n = 0;
+                if(px > 0)          neighbours[n++] = i - 1;
+                if(px < width-1)    neighbours[n++] = i + 1;
+                if(py > 0)          neighbours[n++] = i - width;
+                if(py < height-1)   neighbours[n++] = i + width;
+                for(int j = 0; j < n; j++)
+                {
+                    int m = neighbours[j];
+                    if(result[m] < 0 && labels[m] == label)
+                    {
+                        result[m] = count;
+                        segment.push_back(m);
+                    }
+                }
+            }
+
+            if((int) segment.size() < minimumSize && count > 0)
+            {
+                for(size_t k = 0; k < segment.size(); k++)
+                    result[segment[k]] = adjacent;
+            }
+            else
+            {
+                count++;
+            }
+        }
+    }
+
+    labels.swap(result);
+    return count;
+}
@@ -29,7 +29,7 @@ void IPLUndistort::init()
     setTitle("Undistort Image");
     setDescription("The function transforms an image to compensate radial and tangential lens distortion.");
     setCategory(IPLProcess::CATEGORY_GEOMETRY);
-    setOpenCVSupport(IPLProcess::OPENCV_ONLY);
+    setOpenCVSupport(IPLProcess::OPENCV_OPTIONAL);
     setKeywords("distortion, undistortion, barrel, lens correction");
 
     // inputs and outputs
@@ -51,7 +51,7 @@ void IPLUndistort::destroy()
     delete _result;
 }
 
-bool IPLUndistort::processInputData(IPLData* data, int, bool)
+bool IPLUndistort::processInputData(IPLData* data, int, bool useOpenCV)
 {
     IPLImage* image = data->toImage();
 	
@@ -67,6 +67,29 @@ bool IPLUndistort::processInputData(IPLData* data, int, bool)
 
     notifyProgressEventHandler(-1);
 
+    if(!useOpenCV)
+    {
+        // the remap table is only rebuilt if the parameters or the size change
+        std::vector<double> key = {k1, k2, k3, p1, p2, c1, (double) image->width(), (double) image->height()};
+        if(!_map.matches(key))
+        {
+            _map.buildUndistort(c1, image->width()*0.5, image->height()*0.5, k1, k2, p1, p2, k3,
+                                image->width(), image->height(),
+                                IPLResampler::INTER_LINEAR, IPLResampler::BORDER_CONSTANT);
+            _map.setKey(key);
+        }
+
+        IPLDataType type = image->type();
+        if(type == IPL_IMAGE_BW)
+            type = IPL_IMAGE_GRAYSCALE;
+
+        delete _result;
+        _result = new IPLImage(type, image->width(), image->height());
+        _map.apply(image, _result);
+
+        return true;
+    }
+
     cv::Mat cameraMatrix = (cv::Mat_<double>(3,3) << c1, 0, image->width()*0.5, 0, c2, image->height()*0.5, 0, 0, 1);
 
 
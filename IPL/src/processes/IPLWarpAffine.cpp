@@ -33,7 +33,7 @@ void IPLWarpAffine::init()
     setTitle("Warp Affine");
     setDescription("Applies an affine transformation to an image.");
     setCategory(IPLProcess::CATEGORY_GEOMETRY);
-    setOpenCVSupport(IPLProcess::OPENCV_ONLY);
+    setOpenCVSupport(IPLProcess::OPENCV_OPTIONAL);
     setKeywords("warp, transformation");
 
     // inputs and outputs
@@ -62,9 +62,13 @@ void IPLWarpAffine::init()
 void IPLWarpAffine::destroy()
 {
     delete _result;
+    delete _inputA;
+    delete _inputB;
+    delete _previewA;
+    delete _previewB;
 }
 
-bool IPLWarpAffine::processInputData(IPLData* data, int imageIndex, bool)
+bool IPLWarpAffine::processInputData(IPLData* data, int imageIndex, bool useOpenCV)
 {
     IPLImage* image = data->toImage();
 
@@ -102,6 +106,47 @@ bool IPLWarpAffine::processInputData(IPLData* data, int imageIndex, bool)
 
     notifyProgressEventHandler(-1);
 
+    if(!useOpenCV)
+    {
+        double matrix[6] = {0};
+        for(int i=0; i < (int) v.size() && i < 6; i++)
+            matrix[i] = v[i];
+
+        IPLPoint pointsA[3] = {pointA0, pointA1, pointA2};
+        IPLPoint pointsB[3] = {pointB0, pointB1, pointB2};
+
+        // only in point mode
+        if(method == 1 && !IPLResampler::affineTransform(pointsB, pointsA, matrix))
+        {
+            addError("The points do not define an affine transformation.");
+            return false;
+        }
+
+        IPLDataType type = _inputB->type();
+        if(type == IPL_IMAGE_BW && interpolation != IPLResampler::INTER_NEAREST)
+            type = IPL_IMAGE_GRAYSCALE;
+
+        delete _result;
+        _result = new IPLImage(type, image->width(), image->height());
+        if(!IPLResampler::warpAffine(_inputB, _result, matrix, interpolation, border))
+        {
+            addError("The transformation matrix is not invertible.");
+            return false;
+        }
+
+        delete _previewA;
+        _previewA = new IPLImage(*_inputA);
+        delete _previewB;
+        _previewB = new IPLImage(*_inputB);
+        for(int i=0; i < 3; i++)
+        {
+            IPLResampler::drawPoint(_previewA, pointsA[i], 1.0f, 0.0f, 0.0f);
+            IPLResampler::drawPoint(_previewB, pointsB[i], 0.0f, 1.0f, 0.0f);
+        }
+
+        return true;
+    }
+
     // convert vector to cv::Mat
     cv::Mat matrix(2, 3, CV_32FC1);
     for(int i=0; i < (int) v.size(); i++)
@@ -33,7 +33,7 @@ void IPLWarpPerspective::init()
     setTitle("Warp Perspective");
     setDescription("Applies a perspective transformation to an image.");
     setCategory(IPLProcess::CATEGORY_GEOMETRY);
-    setOpenCVSupport(IPLProcess::OPENCV_ONLY);
+    setOpenCVSupport(IPLProcess::OPENCV_OPTIONAL);
     setKeywords("warp, transformation");
 
     // inputs and outputs
@@ -64,9 +64,13 @@ void IPLWarpPerspective::init()
 void IPLWarpPerspective::destroy()
 {
     delete _result;
+    delete _inputA;
+    delete _inputB;
+    delete _previewA;
+    delete _previewB;
 }
 
-bool IPLWarpPerspective::processInputData(IPLData* data, int imageIndex, bool)
+bool IPLWarpPerspective::processInputData(IPLData* data, int imageIndex, bool useOpenCV)
 {
     IPLImage* image = data->toImage();
 
@@ -107,6 +111,62 @@ bool IPLWarpPerspective::processInputData(IPLData* data, int imageIndex, bool)
 
     notifyProgressEventHandler(-1);
 
+    if(!useOpenCV)
+    {
+        double matrix[9] = {0};
+        for(int i=0; i < (int) v.size() && i < 9; i++)
+            matrix[i] = v[i];
+
+        IPLPoint pointsA[4] = {pointA0, pointA1, pointA2, pointA3};
+        IPLPoint pointsB[4] = {pointB0, pointB1, pointB2, pointB3};
+
+        // only in point mode
+        if(method == 1 && !IPLResampler::perspectiveTransform(pointsB, pointsA, matrix))
+        {
+            addError("The points do not define a perspective transformation.");
+            return false;
+        }
+
+        IPLDataType type = _inputB->type();
+        if(type == IPL_IMAGE_BW && interpolation != IPLResampler::INTER_NEAREST)
+            type = IPL_IMAGE_GRAYSCALE;
+
+        // the remap table is only rebuilt if the matrix or the sizes change
+        std::vector<double> key(matrix, matrix + 9);
+        key.push_back(_inputB->width());
+        key.push_back(_inputB->height());
+        key.push_back(image->width());
+        key.push_back(image->height());
+        key.push_back(interpolation);
+        key.push_back(border);
+        if(!_map.matches(key))
+        {
+            if(!_map.buildPerspective(matrix, _inputB->width(), _inputB->height(),
+                                      image->width(), image->height(), interpolation, border))
+            {
+                addError("The transformation matrix is not invertible.");
+                return false;
+            }
+            _map.setKey(key);
+        }
+
+        delete _result;
+        _result = new IPLImage(type, image->width(), image->height());
+        _map.apply(_inputB, _result);
+
+        delete _previewA;
+        _previewA = new IPLImage(*_inputA);
+        delete _previewB;
+        _previewB = new IPLImage(*_inputB);
+        for(int i=0; i < 4; i++)
+        {
+            IPLResampler::drawPoint(_previewA, pointsA[i], 1.0f, 0.0f, 0.0f);
+            IPLResampler::drawPoint(_previewB, pointsB[i], 0.0f, 1.0f, 0.0f);
+        }
+
+        return true;
+    }
+
     // convert vector to cv::Mat
     cv::Mat matrix(3, 3, CV_32FC1);
     for(int i=0; i < (int) v.size(); i++)
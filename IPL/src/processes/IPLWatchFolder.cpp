@@ -0,0 +1,154 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLWatchFolder.h"
+
+void IPLWatchFolder::init()
+{
+    // init
+    _result     = NULL;
+    _watcher    = NULL;
+    _folder     = "";
+    _moveFolder = "";
+    _action     = IPLFolderWatcher::ACTION_KEEP;
+    _queueSize  = 8;
+    _fileName   = "";
+    _deliver    = false;
+
+    // basic settings
+    setClassName("IPLWatchFolder");
+    setTitle("Watch Folder");
+    setDescription("Loads every new file which is written to or moved into the folder exactly once, "
+                   "in the order of arrival. Files are loaded in the background, up to <i>Queue Size</i> "
+                   "images are buffered. The folder is watched with inotify (Linux only).");
+    setCategory(IPLProcess::CATEGORY_IO);
+    setKeywords("hot folder, inotify, watch, stream");
+    setIsSource(true);
+    setIsSequence(true);
+
+    // inputs and outputs
+    addOutput("Image", IPL_IMAGE_COLOR);
+
+    // all properties which can later be changed by gui
+    addProcessPropertyString("folder", "Folder", "", _folder, IPL_WIDGET_FOLDER);
+    addProcessPropertyInt("action", "After Loading:Keep|Delete|Move", "", _action, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyString("move_folder", "Move To", "Default: <folder>/processed", _moveFolder, IPL_WIDGET_FOLDER);
+    addProcessPropertyInt("queue_size", "Queue Size", "Decoded images waiting for processing", _queueSize, IPL_WIDGET_SLIDER, 1, 64);
+    addProcessPropertyInt("wait", "Wait (ms)", "Maximum time to wait for a new file per execution", 50, IPL_WIDGET_SLIDER, 1, 1000);
+}
+
+void IPLWatchFolder::destroy()
+{
+    delete _watcher;
+    delete _result;
+}
+
+bool IPLWatchFolder::processInputData(IPLData*, int, bool)
+{
+    // get properties
+    std::string folder      = getProcessPropertyString("folder");
+    std::string moveFolder  = getProcessPropertyString("move_folder");
+    int action              = getProcessPropertyInt("action");
+    int queueSize           = getProcessPropertyInt("queue_size");
+    int wait                = getProcessPropertyInt("wait");
+
+    if(folder.empty())
+    {
+        addError("No folder selected.");
+        return false;
+    }
+
+    // (re)start watching when the settings changed
+    if(!_watcher || !_watcher->isRunning() || folder != _folder || moveFolder != _moveFolder
+            || action != _action || queueSize != _queueSize)
+    {
+        _folder     = folder;
+        _moveFolder = moveFolder;
+        _action     = action;
+        _queueSize  = queueSize;
+
+        // only wait until afterProcessing finds a queued image
+        _deliver    = false;
+
+        if(!_watcher)
+            _watcher = new IPLFolderWatcher;
+
+        std::string error;
+        if(!_watcher->start(_folder, _queueSize, (IPLFolderWatcher::Action) _action, _moveFolder, error))
+        {
+            addError(error);
+            return false;
+        }
+    }
+
+    notifyProgressEventHandler(-1);
+
+    // the following steps only run when afterProcessing announced a new image,
+    // otherwise just wait for the next one without consuming it
+    if(_deliver)
+    {
+        std::string fileName;
+        IPLImage* image = _watcher->takeImage(fileName, wait);
+        if(image)
+        {
+            delete _result;
+            _result = image;
+            _fileName = fileName;
+        }
+    }
+    else
+    {
+        _watcher->waitForImage(wait);
+    }
+
+    std::string error = _watcher->takeError();
+    if(!error.empty())
+        addWarning(error);
+
+    std::stringstream s;
+    if(_result)
+        s << "<b>File: </b>" << _fileName << "\n";
+    else
+        s << "Waiting for files in " << _folder << "\n";
+    s << "<b>Received: </b>" << _watcher->received() << "\n";
+    s << "<b>Queued: </b>" << _watcher->queued() << "\n";
+    s << "<b>Failed: </b>" << _watcher->failed();
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLImage *IPLWatchFolder::getResultData(int)
+{
+    return _result;
+}
+
+void IPLWatchFolder::afterProcessing()
+{
+    if(!_watcher || !_watcher->isRunning())
+        return;
+
+    // a queued image runs the whole chain, otherwise only this process is
+    // executed again to keep waiting
+    _deliver = _watcher->queued() > 0;
+    if(_deliver)
+        notifyPropertyChangedEventHandler();
+    else
+        setUpdateNeeded(true);
+}
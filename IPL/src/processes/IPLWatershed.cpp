@@ -0,0 +1,355 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+#include "IPLWatershed.h"
+#include "IPLDistanceTransform.h"
+
+#include <map>
+#include <algorithm>
+
+namespace
+{
+/*!
+ * \brief The BucketQueue class is a hierarchical queue with one FIFO per level
+ * Pixels pushed below the current level are queued at the current level.
+ */
+class BucketQueue
+{
+public:
+    BucketQueue(int levels) : _buckets(levels), _heads(levels, 0), _current(0), _size(0) {}
+
+    void push(int level, int pixel)
+    {
+        level = std::max(level, _current);
+        _buckets[level].push_back(pixel);
+        _size++;
+    }
+
+    int pop()
+    {
+        while(_heads[_current] == _buckets[_current].size())
+        {
+            _buckets[_current].clear();
+            _heads[_current] = 0;
+            _current++;
+        }
+        _size--;
+        return _buckets[_current][_heads[_current]++];
+    }
+
+    bool empty() { return _size == 0; }
+
+private:
+    std::vector<std::vector<int> >  _buckets;
+    std::vector<size_t>             _heads;
+    int                             _current;
+    size_t                          _size;
+};
+
+//! writes the 4-neighbours of pixel i inside the image to neighbours, returns their number
+inline int neighbours4(int i, int width, int height, int* neighbours)
+{
+    int x = i % width;
+    int y = i / width;
+    int n = 0;
+    if(x > 0)           neighbours[n++] = i - 1;
+    if(x < width-1)     neighbours[n++] = i + 1;
+    if(y > 0)           neighbours[n++] = i - width;
+    if(y < height-1)    neighbours[n++] = i + width;
+    return n;
+}
+}
+
+void IPLWatershed::init()
+{
+    // init
+    _relief         = NULL;
+    _markers        = NULL;
+    _result         = NULL;
+    _lines          = NULL;
+    _numberOfLabels = 0;
+
+    // basic settings
+    setClassName("IPLWatershed");
+    setTitle("Watershed");
+    setCategory(IPLProcess::CATEGORY_OBJECTS);
+    setKeywords("segmentation, markers, basins, flooding, separate objects");
+    setDescription("Marker-controlled watershed segmentation. Floods the relief (e.g. a gradient image or the "
+                   "inverted distance transform) from the markers (e.g. Label Blobs or the Distance Transform "
+                   "seeds) and separates the basins with watershed lines.");
+
+    // inputs and outputs
+    addInput("Relief", IPL_IMAGE_GRAYSCALE);
+    addInput("Markers", IPL_IMAGE_GRAYSCALE);
+    addOutput("Labels", IPL_IMAGE_GRAYSCALE);
+    addOutput("Lines", IPL_IMAGE_BW);
+
+    // properties
+    addProcessPropertyInt("relief", "Relief:Image|Inverted Image", "Use the inverted image for the distance transform",
+                          0, IPL_WIDGET_RADIOBUTTONS);
+    addProcessPropertyInt("levels", "Levels", "Number of quantization levels of the relief", 256, IPL_WIDGET_SLIDER, 16, 4096);
+    addProcessPropertyBool("exclude_maximum", "Exclude Maximum",
+                           "Pixels with the maximum relief are background and not flooded, separated regions are flooded in parallel",
+                           false, IPL_WIDGET_CHECKBOXES);
+}
+
+void IPLWatershed::destroy()
+{
+    delete _result;
+    delete _lines;
+}
+
+bool IPLWatershed::processInputData(IPLData* data, int index, bool)
+{
+    IPLImage* image = data->toImage();
+
+    // only keep a reference, the inputs stay valid during the processing run
+    if(index == 0)
+        _relief = image;
+    if(index == 1)
+        _markers = image;
+
+    // wait for the other input
+    if(!(_relief && _markers))
+        return true;
+
+    if(_relief->width() != _markers->width() || _relief->height() != _markers->height())
+    {
+        addError("Relief and markers must have the same size.");
+        return false;
+    }
+
+    // get properties
+    bool inverted       = getProcessPropertyInt("relief") == 1;
+    int levels          = getProcessPropertyInt("levels");
+    bool excludeMaximum = getProcessPropertyBool("exclude_maximum");
+
+    int width = _relief->width();
+    int height = _relief->height();
+    size_t pixels = (size_t) width * height;
+
+    notifyProgressEventHandler(-1);
+
+    // quantized relief, pixels on the maximum are background if excluded
+    std::vector<unsigned short> level(pixels);
+    _labels.assign(pixels, 0);
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const float* in = &_relief->plane(0)->p(0, y);
+        unsigned short* out = &level[(size_t) y * width];
+        int* label = &_labels[(size_t) y * width];
+        for(int x = 0; x < width; x++)
+        {
+            float v = std::min(1.0f, std::max(0.0f, in[x]));
+            if(inverted)
+                v = 1.0f - v;
+            out[x] = (unsigned short) (v * (levels-1) + 0.5f);
+            if(excludeMaximum && v >= 1.0f)
+                label[x] = BACKGROUND;
+        }
+    }
+
+    // every distinct marker value is one basin
+    std::map<float, int> markerLabels;
+    float lastValue = 0.0f;
+    int lastLabel = 0;
+    for(int y = 0; y < height; y++)
+    {
+        const float* in = &_markers->plane(0)->p(0, y);
+        int* label = &_labels[(size_t) y * width];
+        for(int x = 0; x < width; x++)
+        {
+            if(in[x] <= 0.0f)
+                continue;
+
+            if(in[x] != lastValue)
+            {
+                std::map<float, int>::iterator it = markerLabels.find(in[x]);
+                if(it == markerLabels.end())
+                    it = markerLabels.insert(std::make_pair(in[x], (int) markerLabels.size() + 1)).first;
+                lastValue = it->first;
+                lastLabel = it->second;
+            }
+            label[x] = lastLabel;
+        }
+    }
+    _numberOfLabels = (int) markerLabels.size();
+
+    if(!excludeMaximum)
+    {
+        flood(level, _labels, width, height, levels, NULL, (int) pixels);
+    }
+    else
+    {
+        // background pixels separate independent regions
+        std::vector<unsigned char> mask(pixels);
+        for(size_t i = 0; i < pixels; i++)
+            mask[i] = _labels[i] != BACKGROUND;
+
+        std::vector<int> regions;
+        int regionCount = IPLDistanceTransform::labelComponents(mask, width, height, regions);
+
+        // pixels sorted by region
+        std::vector<int> offsets(regionCount + 2, 0);
+        for(size_t i = 0; i < pixels; i++)
+            offsets[regions[i] + 1]++;
+        for(int r = 0; r <= regionCount; r++)
+            offsets[r + 1] += offsets[r];
+        std::vector<int> sorted(pixels);
+        std::vector<int> position(offsets.begin(), offsets.end() - 1);
+        for(size_t i = 0; i < pixels; i++)
+            sorted[position[regions[i]]++] = (int) i;
+
+        #pragma omp parallel for schedule(dynamic)
+        for(int r = 1; r <= regionCount; r++)
+            flood(level, _labels, width, height, levels, &sorted[offsets[r]], offsets[r+1] - offsets[r]);
+
+        for(size_t i = 0; i < pixels; i++)
+            if(_labels[i] == BACKGROUND)
+                _labels[i] = 0;
+    }
+
+    // outputs
+    if(!_result || _result->width() != width || _result->height() != height)
+    {
+        delete _result;
+        delete _lines;
+        _result = new IPLImage(IPL_IMAGE_GRAYSCALE, width, height);
+        _lines = new IPLImage(IPL_IMAGE_BW, width, height);
+    }
+
+    float scale = _numberOfLabels > 0 ? 1.0f / _numberOfLabels : 0.0f;
+    #pragma omp parallel for
+    for(int y = 0; y < height; y++)
+    {
+        const int* label = &_labels[(size_t) y * width];
+        float* out = &_result->plane(0)->p(0, y);
+        float* line = &_lines->plane(0)->p(0, y);
+        for(int x = 0; x < width; x++)
+        {
+            out[x] = label[x] > 0 ? label[x] * scale : 0.0f;
+            line[x] = label[x] == LINE ? 1.0f : 0.0f;
+        }
+    }
+
+    std::stringstream s;
+    s << "Basins: " << _numberOfLabels;
+    addInformation(s.str());
+
+    return true;
+}
+
+IPLData* IPLWatershed::getResultData(int index)
+{
+    if(index == 0)
+        return _result;
+    return _lines;
+}
+
+/*!
+ * \brief IPLWatershed::beforeProcessing drops the input references of an aborted run
+ */
+void IPLWatershed::beforeProcessing()
+{
+    _relief = NULL;
+    _markers = NULL;
+}
+
+/*!
+ * \brief IPLWatershed::afterProcessing drops the input references, they may change before the next run
+ */
+void IPLWatershed::afterProcessing()
+{
+    _relief = NULL;
+    _markers = NULL;
+}
+
+/*!
+ * \brief IPLWatershed::flood floods one region from its markers
+ * labels holds the marker labels (> 0), 0 for pixels to flood and
+ * BACKGROUND for pixels which are never flooded. pixels lists the pixels
+ * of the region, NULL for the whole image. Regions must be separated by
+ * background pixels so they can be flooded in parallel.
+ */
+void IPLWatershed::flood(const std::vector<unsigned short>& level, std::vector<int>& labels,
+                         int width, int height, int levels, const int* pixels, int count)
+{
+    BucketQueue queue(levels);
+    int* label = &labels[0];
+    int neighbours[4];
+
+    // start with the neighbours of the markers
+    for(int k = 0; k < count; k++)
+    {
+        int i = pixels ? pixels[k] : k;
+        if(label[i] <= 0)
+            continue;
+
+        int n = neighbours4(i, width, height, neighbours);
+        for(int j = 0; j < n; j++)
+        {
+            int m = neighbours[j];
+            if(label[m] == 0)
+            {
+                label[m] = IN_QUEUE;
+                queue.push(level[m], m);
+            }
+        }
+    }
+
+    while(!queue.empty())
+    {
+        int i = queue.pop();
+
+        int n = neighbours4(i, width, height, neighbours);
+
+        // pixels between two basins become lines
+        int basin = 0;
+        bool line = false;
+        for(int j = 0; j < n; j++)
+        {
+            int l = label[neighbours[j]];
+            if(l > 0)
+            {
+                if(basin == 0)
+                    basin = l;
+                else if(basin != l)
+                    line = true;
+            }
+        }
+
+        if(line || basin == 0)
+        {
+            label[i] = LINE;
+            continue;
+        }
+
+        label[i] = basin;
+        for(int j = 0; j < n; j++)
+        {
+            int m = neighbours[j];
+            if(label[m] == 0)
+            {
+                label[m] = IN_QUEUE;
+                queue.push(level[m], m);
+            }
+        }
+    }
+}
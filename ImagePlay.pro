@@ -21,6 +21,10 @@ TEMPLATE = subdirs
 CONFIG += ordered
 
 SUBDIRS = IPL\
-          ImagePlay
+          ImagePlay\
+          ImagePlayServer\
+          ImagePlayBenchmark
 
 ImagePlay.depends = IPL
+ImagePlayServer.depends = IPL
+ImagePlayBenchmark.depends = IPL
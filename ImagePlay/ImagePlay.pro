@@ -161,6 +161,8 @@ macx: {
 }
 
 linux: {
+    # libraries of the static IPL which are not listed here come from its .prl file
+    CONFIG += link_prl
     LIBS += -L../_bin/$$CONFIGURATION/$$PLATFORM/ -lIPL
 
     LIBS += -lfreeimage
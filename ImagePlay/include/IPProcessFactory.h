@@ -41,8 +41,10 @@ public:
                         ~IPProcessFactory           ();
     void                registerProcess             (QString name, IPLProcess* getInstance);
     void                unregisterProcess           (QString name);
+    void                registerBuiltinProcesses    ();
     IPLProcess*         getInstance                 (QString name);
     QStringList         getProcessNamesByCategory   (IPLProcess::IPLProcessCategory category);
+    QStringList         getProcessNames             ()                          { return _map.keys(); }
 
 private:
     QMap<QString, IPLProcess*>   _map;              //!< Contains all currently registered IPLProcesses by name
@@ -27,6 +27,7 @@
 #include <QStatusBar>
 #include <QScrollBar>
 #include <QQueue>
+#include <QSet>
 #include <QElapsedTimer>
 #include <QApplication>
 
@@ -23,6 +23,7 @@
 #include <QThread>
 
 #include "IPL_processes.h"
+#include "IPLOpenCVTuner.h"
 
 #include <QDebug>
 
@@ -36,7 +37,7 @@ class IPProcessThread : public QThread, public IPLProgressEventHandler
 {
     Q_OBJECT
 public:
-                            IPProcessThread         (IPLProcess* process, IPLImage* image = NULL, int inputIndex = 0, bool useOpenCV = false);
+                            IPProcessThread         (IPLProcess* process, IPLImage* image = NULL, int inputIndex = 0, bool useOpenCV = false, IPLOpenCVTuner* tuner = NULL);
                             ~IPProcessThread        ();
     void                    run                     ();
     void                    updateProgress          (int percent);
@@ -52,6 +53,7 @@ private:
     IPLImage*               _image;
     bool                    _success;
     bool                    _useOpenCV;
+    IPLOpenCVTuner*         _tuner;                 //!< selects OpenCV per run if set
 };
 
 
@@ -31,6 +31,7 @@
 #include <QFormLayout>
 #include <QSpinBox>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QMutableListIterator>
 #include <QFileSystemWatcher>
 #include <QDebug>
@@ -39,6 +40,7 @@
 #include "IPProcessFactory.h"
 //#include "IPProcessScript.h"
 #include "IPL_processes.h"
+#include "IPLOpenCVTuner.h"
 #include "ImageViewerWindow.h"
 #include "SettingsWindow.h"
 #include "AboutWindow.h"
@@ -124,6 +126,9 @@ public:
     bool                    logFileEnabled                  ()                              { return _logFileEnabled; }
     void                    setUseOpenCV                    (bool enabled)                  { _useOpenCV = enabled; }
     bool                    useOpenCV                       ()                              { return _useOpenCV; }
+    void                    setAutoOpenCV                   (bool enabled)                  { _autoOpenCV = enabled; }
+    bool                    autoOpenCV                      ()                              { return _autoOpenCV; }
+    IPLOpenCVTuner*         openCVTuner                     ()                              { return &_openCVTuner; }
     IPProcessFactory*       factory                         ()                              { return _factory; }
     ImageViewerWindow*      imageViewer                     ()                              { return _imageViewer; }
     void                    setAllowChangeActiveProcessStep (bool allow)                    { _allowChangeActiveProcessStep = allow; }
@@ -176,6 +181,7 @@ private slots:
     void                    on_btnSequenceBack_clicked      ();
     void                    on_actionHelp_triggered         ();
     void                    on_actionUseOpenCV_toggled      (bool value);
+    void                    on_actionAutoOpenCV_toggled     (bool value);
     void                    on_actionShowLog_triggered      (bool checked);
     void                    on_pushButton_clicked           ();
     void                    on_actionGeneratePlugin_triggered();
@@ -188,6 +194,7 @@ private slots:
 private:
     void                    addRecentProcessFile(const QString&);
     void                    updateRecentProcessesMenu();
+    QString                 openCVTuningFile();
 
     Ui::MainWindow*         ui;
     IPProcessStep*          _activeProcessStep;
@@ -213,6 +220,8 @@ private:
     bool                    _autosaveEnabled;
     bool                    _unsavedChanges;
     bool                    _useOpenCV;
+    bool                    _autoOpenCV;
+    IPLOpenCVTuner          _openCVTuner;
     bool                    _logFileEnabled;
     bool                    _threadRunning;
     QStringList             _recentProcessFiles;
@@ -19,6 +19,8 @@
 
 #include "IPProcessFactory.h"
 
+#include "IPL_processes.h"
+
 IPProcessFactory::IPProcessFactory()
 {
 }
@@ -50,6 +52,125 @@ void IPProcessFactory::unregisterProcess(QString name)
     }
 }
 
+void IPProcessFactory::registerBuiltinProcesses()
+{
+    // register all processes to the factory
+    registerProcess("IPLConvertToGray",       new IPLConvertToGray);
+    registerProcess("IPLConvertToColor",      new IPLConvertToColor);
+    registerProcess("IPLConvertColorSpace",   new IPLConvertColorSpace);
+    registerProcess("IPLBinarize",            new IPLBinarize);
+    registerProcess("IPLLoadImage",           new IPLLoadImage);
+    registerProcess("IPLCamera",              new IPLCamera);
+    //registerProcess("IPLLoadVideo",           new IPLLoadVideo);
+    registerProcess("IPLLoadImageSequence",   new IPLLoadImageSequence);
+    registerProcess("IPLSaveImage",           new IPLSaveImage);
+    registerProcess("IPLSplitPlanes",         new IPLSplitPlanes);
+    registerProcess("IPLMergePlanes",         new IPLMergePlanes);
+    registerProcess("IPLGaussianLowPass",     new IPLGaussianLowPass);
+    registerProcess("IPLGammaCorrection",     new IPLGammaCorrection);
+    registerProcess("IPLConvolutionFilter",   new IPLConvolutionFilter);
+    registerProcess("IPLMorphologyBinary",    new IPLMorphologyBinary);
+    registerProcess("IPLMorphologyGrayscale", new IPLMorphologyGrayscale);
+    registerProcess("IPLMorphologyHitMiss",   new IPLMorphologyHitMiss);
+    registerProcess("IPLBlendImages",         new IPLBlendImages);
+    registerProcess("IPLArithmeticOperations",new IPLArithmeticOperations);
+    registerProcess("IPLArithmeticOperationsConstant", new IPLArithmeticOperationsConstant);
+    registerProcess("IPLSynthesize",          new IPLSynthesize);
+    registerProcess("IPLFlipImage",           new IPLFlipImage);
+    registerProcess("IPLGradientOperator",    new IPLGradientOperator);
+//    TODO: Fix algorithm and add again.
+    registerProcess("IPLRandomPoint",         new IPLRandomPoint);
+    registerProcess("IPLCanvasSize",          new IPLCanvasSize);
+    registerProcess("IPLResize",              new IPLResize);
+    registerProcess("IPLRotate",              new IPLRotate);
+    registerProcess("IPLGaussianPyramid",     new IPLGaussianPyramid);
+    registerProcess("IPLLaplacianPyramid",    new IPLLaplacianPyramid);
+    registerProcess("IPLCollapsePyramid",     new IPLCollapsePyramid);
+
+    registerProcess("IPLEnhanceMode",         new IPLEnhanceMode);
+    registerProcess("IPLFillConcavities",     new IPLFillConcavities);
+    registerProcess("IPLGabor",               new IPLGabor);
+    registerProcess("IPLInverseContrastRatioMapping",new IPLInverseContrastRatioMapping);
+    registerProcess("IPLMax",                 new IPLMax);
+    registerProcess("IPLMaxMinMedian",        new IPLMaxMinMedian);
+    registerProcess("IPLMedian",              new IPLMedian);
+    registerProcess("IPLNonLocalMeans",       new IPLNonLocalMeans);
+    registerProcess("IPLCanny",               new IPLCanny);
+    registerProcess("IPLHoughCircles",        new IPLHoughCircles);
+    registerProcess("IPLHarrisCorner",        new IPLHarrisCorner);
+    registerProcess("IPLExtractLines",        new IPLExtractLines);
+    registerProcess("IPLExtrema",             new IPLExtrema);
+    registerProcess("IPLLaplaceOfGaussian",   new IPLLaplaceOfGaussian);
+    registerProcess("IPLMin",                 new IPLMin);
+    registerProcess("IPLMorphologicalEdge",   new IPLMorphologicalEdge);
+    registerProcess("IPLNormalizeIllumination",new IPLNormalizeIllumination);
+    registerProcess("IPLBinarizeSavola",      new IPLBinarizeSavola);
+    registerProcess("IPLOnePixelEdge",        new IPLOnePixelEdge);
+    registerProcess("IPLRankTransform",       new IPLRankTransform);
+    registerProcess("IPLUnsharpMasking",      new IPLUnsharpMasking);
+    registerProcess("IPLCompassMask",         new IPLCompassMask);
+
+    registerProcess("IPLTriangleSegmentation",new IPLTriangleSegmentation);
+    registerProcess("IPLStretchContrast",     new IPLStretchContrast);
+    registerProcess("IPLNegate",              new IPLNegate);
+    registerProcess("IPLMarkImage",           new IPLMarkImage);
+    registerProcess("IPLLocalThreshold",      new IPLLocalThreshold);
+    registerProcess("IPLHysteresisThreshold", new IPLHysteresisThreshold);
+    registerProcess("IPLFalseColor",          new IPLFalseColor);
+    registerProcess("IPLEqualizeHistogram",   new IPLEqualizeHistogram);
+    registerProcess("IPLBinarizeUnimodal",    new IPLBinarizeUnimodal);
+    registerProcess("IPLBinarizeOtsu",        new IPLBinarizeOtsu);
+    registerProcess("IPLBinarizeKMeans",      new IPLBinarizeKMeans);
+    registerProcess("IPLBinarizeEntropy",     new IPLBinarizeEntropy);
+    registerProcess("IPLAddNoise",            new IPLAddNoise);
+
+    registerProcess("IPLFFT",                 new IPLFFT);
+    registerProcess("IPLIFFT",                new IPLIFFT);
+    registerProcess("IPLFrequencyFilter",     new IPLFrequencyFilter);
+
+    registerProcess("IPLLabelBlobs",          new IPLLabelBlobs);
+
+    registerProcess("IPLAccumulate",          new IPLAccumulate);
+    registerProcess("IPLBackgroundSubtraction", new IPLBackgroundSubtraction);
+    registerProcess("IPLFrameBuffer",         new IPLFrameBuffer);
+    registerProcess("IPLIntegral",            new IPLIntegral);
+    registerProcess("IPLBoxFilter",           new IPLBoxFilter);
+    registerProcess("IPLDistanceTransform",   new IPLDistanceTransform);
+    registerProcess("IPLWatershed",           new IPLWatershed);
+    registerProcess("IPLSuperpixels",         new IPLSuperpixels);
+    registerProcess("IPLMaxTree",             new IPLMaxTree);
+    registerProcess("IPLAttributeFilter",     new IPLAttributeFilter);
+    registerProcess("IPLLocalBinaryPattern",  new IPLLocalBinaryPattern);
+    registerProcess("IPLHOG",                 new IPLHOG);
+    registerProcess("IPLDemosaic",            new IPLDemosaic);
+    registerProcess("IPLWatchFolder",         new IPLWatchFolder);
+    registerProcess("IPLSharedMemoryInput",   new IPLSharedMemoryInput);
+    registerProcess("IPLSharedMemoryOutput",  new IPLSharedMemoryOutput);
+    registerProcess("IPLRawVideoInput",       new IPLRawVideoInput);
+    registerProcess("IPLRawVideoOutput",      new IPLRawVideoOutput);
+    registerProcess("IPLHoughLines",          new IPLHoughLines);
+    registerProcess("IPLHoughLineSegments",   new IPLHoughLineSegments);
+
+    registerProcess("IPLUndistort",           new IPLUndistort);
+    registerProcess("IPLWarpAffine",          new IPLWarpAffine);
+    registerProcess("IPLWarpPerspective",     new IPLWarpPerspective);
+
+    registerProcess("IPLGoodFeaturesToTrack", new IPLGoodFeaturesToTrack);
+
+    // not ready:
+    /*registerProcess("IPLMatchTemplate",       new IPLMatchTemplate);
+    registerProcess("IPLFloodFill",           new IPLFloodFill);
+
+    registerProcess("IPLOpticalFlow",         new IPLOpticalFlow);
+
+    registerProcess("IPProcessScript",        new IPProcessScript);
+
+    registerProcess("IPLFeatureDetection",    new IPLFeatureDetection);
+    registerProcess("IPLFeatureMatcher",      new IPLFeatureMatcher);
+
+    registerProcess("IPLCameraCalibration",   new IPLCameraCalibration);*/
+}
+
 IPLProcess* IPProcessFactory::getInstance(QString name)
 {
     qDebug() << "IPProcessFactory::getInstance: " << name;
@@ -135,7 +135,8 @@ int IPProcessGrid::executeThread(IPLProcess* process, IPLImage *image /*= NULL*/
     timer.start();
 
     // create new thread
-    _thread = new IPProcessThread(process, image, inputIndex, useOpenCV);
+    IPLOpenCVTuner* tuner = _mainWindow->autoOpenCV() ? _mainWindow->openCVTuner() : NULL;
+    _thread = new IPProcessThread(process, image, inputIndex, useOpenCV, tuner);
 
     connect(_thread, &IPProcessThread::progressUpdated, this, &IPProcessGrid::updateProgress);
 
@@ -283,6 +284,9 @@ void IPProcessGrid::execute(bool forcedUpdate /* = false*/)
 
     QList<IPProcessStep*> afterProcessingList;
 
+    // steps which wait for the first frame of a sequence source like Watch Folder
+    QSet<IPProcessStep*> waitingSteps;
+
     QListIterator<IPProcessStep *> it(_processList);
     while (it.hasNext() && counter < limit)
     {
@@ -320,6 +324,9 @@ void IPProcessGrid::execute(bool forcedUpdate /* = false*/)
         {
             if(step->process()->updateNeeded() || forcedUpdate)
             {
+                // once per run, processes with several inputs keep them until all have arrived
+                step->process()->beforeProcessing();
+
                 // execute process once for every input
                 for(int i=0; i < step->edgesIn()->size(); i++)
                 {
@@ -330,6 +337,13 @@ void IPProcessGrid::execute(bool forcedUpdate /* = false*/)
 
                     IPLImage* result = static_cast<IPLImage*>(stepFrom->process()->getResultData(indexFrom));
 
+                    // no frame yet, wait quietly
+                    if(!result && (stepFrom->process()->isSequence() || waitingSteps.contains(stepFrom)))
+                    {
+                        waitingSteps.insert(step);
+                        break;
+                    }
+
                     // invalid result, stopp the execution
                     if(!result)
                     {
@@ -341,7 +355,6 @@ void IPProcessGrid::execute(bool forcedUpdate /* = false*/)
 
                     // execute thread
                     step->process()->resetMessages();
-                    step->process()->beforeProcessing();
                     int durationMs = executeThread(step->process(), result, indexTo, mainWindow()->useOpenCV());
                     if ( !_lastProcessSuccess ) blockFailLoop = true;
 
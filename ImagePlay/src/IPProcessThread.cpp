@@ -19,13 +19,14 @@
 
 #include "IPProcessThread.h"
 
-IPProcessThread::IPProcessThread(IPLProcess *process, IPLImage *image, int inputIndex, bool useOpenCV)
+IPProcessThread::IPProcessThread(IPLProcess *process, IPLImage *image, int inputIndex, bool useOpenCV, IPLOpenCVTuner* tuner)
 {
     _process    = process;
     _image      = image;
     _inputIndex = inputIndex;
     _success    = false;
     _useOpenCV  = useOpenCV;
+    _tuner      = tuner;
 
     // allow immediate termination
     QThread::setTerminationEnabled(true);
@@ -41,7 +42,10 @@ void IPProcessThread::run()
 
     try
     {
-        _success = _process->processInputData(_image, _inputIndex, _useOpenCV);
+        if(_tuner)
+            _success = _tuner->process(_process, _image, _inputIndex);
+        else
+            _success = _process->processInputData(_image, _inputIndex, _useOpenCV);
     }
     catch(std::exception &e)
     {
@@ -37,6 +37,7 @@ MainWindow::MainWindow(QWidget *parent) :
     _autosaveInterval = 10; // 10 seconds
     _unsavedChanges = false;
     _useOpenCV = true;
+    _autoOpenCV = false;
     _threadRunning = false;
 
     _imageViewer = new ImageViewerWindow(this);
@@ -200,6 +201,7 @@ void MainWindow::readSettings()
     // properties
     _settings = new QSettings("BFH", "ImagePlay");
     _useOpenCV          = _settings->value("OpenCV", true).toBool();
+    _autoOpenCV         = _settings->value("OpenCVAuto", false).toBool();
     _autosaveEnabled    = _settings->value("AutoSave", true).toBool();
     _defaultImagePath   = _settings->value("DefaultImagePath", "").toString();
     _logFileEnabled     = _settings->value("LogFile", false).toBool();
@@ -249,6 +251,11 @@ void MainWindow::readSettings()
     _settings->endGroup();
 
     ui->actionUseOpenCV->setChecked(_useOpenCV);
+    ui->actionAutoOpenCV->setChecked(_autoOpenCV);
+
+    // measurements of previous sessions
+    _openCVTuner.setDefaultUseOpenCV(_useOpenCV);
+    _openCVTuner.load(openCVTuningFile().toStdString());
 
     // tutorial
     if(!_settings->value("IgnoreTutorial", 0).toInt())
@@ -279,6 +286,7 @@ void MainWindow::readSettings()
 void MainWindow::writeSettings()
 {
     _settings->setValue("OpenCV",           _useOpenCV);
+    _settings->setValue("OpenCVAuto",       _autoOpenCV);
     _settings->setValue("AutoSave",         _autosaveEnabled);
     _settings->setValue("DefaultImagePath", _defaultImagePath);
     _settings->setValue("PluginDevPath",    _pluginDevPath);
@@ -317,6 +325,8 @@ void MainWindow::writeSettings()
     {
         _settings->setValue("recentProjects", QVariant::fromValue<QStringList>(_recentProcessFiles));
     }
+
+    _openCVTuner.save(openCVTuningFile().toStdString());
 }
 
 void MainWindow::showProcessSettings(IPProcessStep* processStep)
@@ -447,100 +457,7 @@ void MainWindow::loadProcesses()
 {
     // we need a process factory to instanciate at runtime from string
     _factory = new IPProcessFactory;
-
-    // register all processes to the factory
-    _factory->registerProcess("IPLConvertToGray",       new IPLConvertToGray);
-    _factory->registerProcess("IPLConvertToColor",      new IPLConvertToColor);
-    _factory->registerProcess("IPLBinarize",            new IPLBinarize);
-    _factory->registerProcess("IPLLoadImage",           new IPLLoadImage);
-    _factory->registerProcess("IPLCamera",              new IPLCamera);
-    //_factory->registerProcess("IPLLoadVideo",           new IPLLoadVideo);
-    _factory->registerProcess("IPLLoadImageSequence",   new IPLLoadImageSequence);
-    _factory->registerProcess("IPLSaveImage",           new IPLSaveImage);
-    _factory->registerProcess("IPLSplitPlanes",         new IPLSplitPlanes);
-    _factory->registerProcess("IPLMergePlanes",         new IPLMergePlanes);
-    _factory->registerProcess("IPLGaussianLowPass",     new IPLGaussianLowPass);
-    _factory->registerProcess("IPLGammaCorrection",     new IPLGammaCorrection);
-    _factory->registerProcess("IPLConvolutionFilter",   new IPLConvolutionFilter);
-    _factory->registerProcess("IPLMorphologyBinary",    new IPLMorphologyBinary);
-    _factory->registerProcess("IPLMorphologyGrayscale", new IPLMorphologyGrayscale);
-    _factory->registerProcess("IPLMorphologyHitMiss",   new IPLMorphologyHitMiss);
-    _factory->registerProcess("IPLBlendImages",         new IPLBlendImages);
-    _factory->registerProcess("IPLArithmeticOperations",new IPLArithmeticOperations);
-    _factory->registerProcess("IPLArithmeticOperationsConstant", new IPLArithmeticOperationsConstant);
-    _factory->registerProcess("IPLSynthesize",          new IPLSynthesize);
-    _factory->registerProcess("IPLFlipImage",           new IPLFlipImage);
-    _factory->registerProcess("IPLGradientOperator",    new IPLGradientOperator);
-//    TODO: Fix algorithm and add again.
-    _factory->registerProcess("IPLRandomPoint",         new IPLRandomPoint);
-    _factory->registerProcess("IPLCanvasSize",          new IPLCanvasSize);
-    _factory->registerProcess("IPLResize",              new IPLResize);
-    _factory->registerProcess("IPLRotate",              new IPLRotate);
-
-    _factory->registerProcess("IPLEnhanceMode",         new IPLEnhanceMode);
-    _factory->registerProcess("IPLFillConcavities",     new IPLFillConcavities);
-    _factory->registerProcess("IPLGabor",               new IPLGabor);
-    _factory->registerProcess("IPLInverseContrastRatioMapping",new IPLInverseContrastRatioMapping);
-    _factory->registerProcess("IPLMax",                 new IPLMax);
-    _factory->registerProcess("IPLMaxMinMedian",        new IPLMaxMinMedian);
-    _factory->registerProcess("IPLMedian",              new IPLMedian);
-    _factory->registerProcess("IPLCanny",               new IPLCanny);
-    _factory->registerProcess("IPLHoughCircles",        new IPLHoughCircles);
-    _factory->registerProcess("IPLHarrisCorner",        new IPLHarrisCorner);
-    _factory->registerProcess("IPLExtractLines",        new IPLExtractLines);
-    _factory->registerProcess("IPLExtrema",             new IPLExtrema);
-    _factory->registerProcess("IPLLaplaceOfGaussian",   new IPLLaplaceOfGaussian);
-    _factory->registerProcess("IPLMin",                 new IPLMin);
-    _factory->registerProcess("IPLMorphologicalEdge",   new IPLMorphologicalEdge);
-    _factory->registerProcess("IPLNormalizeIllumination",new IPLNormalizeIllumination);
-    _factory->registerProcess("IPLBinarizeSavola",      new IPLBinarizeSavola);
-    _factory->registerProcess("IPLOnePixelEdge",        new IPLOnePixelEdge);
-    _factory->registerProcess("IPLRankTransform",       new IPLRankTransform);
-    _factory->registerProcess("IPLUnsharpMasking",      new IPLUnsharpMasking);
-    _factory->registerProcess("IPLCompassMask",         new IPLCompassMask);
-
-    _factory->registerProcess("IPLTriangleSegmentation",new IPLTriangleSegmentation);
-    _factory->registerProcess("IPLStretchContrast",     new IPLStretchContrast);
-    _factory->registerProcess("IPLNegate",              new IPLNegate);
-    _factory->registerProcess("IPLMarkImage",           new IPLMarkImage);
-    _factory->registerProcess("IPLLocalThreshold",      new IPLLocalThreshold);
-    _factory->registerProcess("IPLHysteresisThreshold", new IPLHysteresisThreshold);
-    _factory->registerProcess("IPLFalseColor",          new IPLFalseColor);
-    _factory->registerProcess("IPLEqualizeHistogram",   new IPLEqualizeHistogram);
-    _factory->registerProcess("IPLBinarizeUnimodal",    new IPLBinarizeUnimodal);
-    _factory->registerProcess("IPLBinarizeOtsu",        new IPLBinarizeOtsu);
-    _factory->registerProcess("IPLBinarizeKMeans",      new IPLBinarizeKMeans);
-    _factory->registerProcess("IPLBinarizeEntropy",     new IPLBinarizeEntropy);
-    _factory->registerProcess("IPLAddNoise",            new IPLAddNoise);
-
-    _factory->registerProcess("IPLFFT",                 new IPLFFT);
-    _factory->registerProcess("IPLIFFT",                new IPLIFFT);
-    _factory->registerProcess("IPLFrequencyFilter",     new IPLFrequencyFilter);
-
-    _factory->registerProcess("IPLLabelBlobs",          new IPLLabelBlobs);
-
-    _factory->registerProcess("IPLAccumulate",          new IPLAccumulate);
-    _factory->registerProcess("IPLHoughLines",          new IPLHoughLines);
-    _factory->registerProcess("IPLHoughLineSegments",   new IPLHoughLineSegments);
-
-    _factory->registerProcess("IPLUndistort",           new IPLUndistort);
-    _factory->registerProcess("IPLWarpAffine",          new IPLWarpAffine);
-    _factory->registerProcess("IPLWarpPerspective",     new IPLWarpPerspective);
-
-    _factory->registerProcess("IPLGoodFeaturesToTrack", new IPLGoodFeaturesToTrack);
-
-    // not ready:
-    /*_factory->registerProcess("IPLMatchTemplate",       new IPLMatchTemplate);
-    _factory->registerProcess("IPLFloodFill",           new IPLFloodFill);
-
-    _factory->registerProcess("IPLOpticalFlow",         new IPLOpticalFlow);
-
-    _factory->registerProcess("IPProcessScript",        new IPProcessScript);
-
-    _factory->registerProcess("IPLFeatureDetection",    new IPLFeatureDetection);
-    _factory->registerProcess("IPLFeatureMatcher",      new IPLFeatureMatcher);
-
-    _factory->registerProcess("IPLCameraCalibration",   new IPLCameraCalibration);*/
+    _factory->registerBuiltinProcesses();
 }
 
 void MainWindow::reloadPlugins()
@@ -1372,12 +1289,29 @@ void MainWindow::on_actionHelp_triggered()
 void MainWindow::on_actionUseOpenCV_toggled(bool value)
 {
     _useOpenCV = value;
+    _openCVTuner.setDefaultUseOpenCV(value);
     ui->graphicsView->scene()->update();
 
     // force one execution
     execute(true);
 }
 
+void MainWindow::on_actionAutoOpenCV_toggled(bool value)
+{
+    _autoOpenCV = value;
+    ui->graphicsView->scene()->update();
+
+    // force one execution
+    execute(true);
+}
+
+QString MainWindow::openCVTuningFile()
+{
+    QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(path);
+    return path + "/opencv_tuning.tsv";
+}
+
 void MainWindow::on_actionShowLog_triggered(bool checked)
 {
     ui->dockLog->setVisible(checked);
@@ -0,0 +1,96 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#ifndef IPBENCHMARK_H
+#define IPBENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QTextStream>
+
+#include "IPL_processes.h"
+#include "IPLOpenCVTuner.h"
+#include "IPProcessFactory.h"
+
+//-----------------------------------------------------------------------------
+//!IPBenchmark compares the native and the OpenCV implementation of processes
+/*!
+ * Every OPENCV_OPTIONAL process is executed with both implementations on a
+ * corpus of synthetic images (and optionally real images from a folder).
+ * Besides the default properties, every numeric slider property is tested
+ * at its minimum and maximum. For each run the mean and max absolute error
+ * between the two outputs and the speed ratio native/OpenCV are reported,
+ * runs above the tolerances are flagged as divergent. Runs where one of the
+ * implementations fails are reported as failed and count as divergent.
+ */
+class IPBenchmark
+{
+public:
+    struct Result
+    {
+        QString             process;
+        QString             variant;                //!< property values which differ from the defaults
+        QString             image;
+        int                 width;
+        int                 height;
+        int                 planes;
+        double              nativeMs;
+        double              opencvMs;
+        double              meanError;
+        double              maxError;
+        bool                compared;               //!< false if the outputs differ in size or planes
+        bool                failed;                 //!< one of the implementations failed
+        bool                diverges;
+    };
+
+                            IPBenchmark             (IPProcessFactory* factory);
+                            ~IPBenchmark            ();
+    void                    addSyntheticImages      (const QList<int>& sizes);
+    int                     addImages               (const QString& folder);
+    void                    run                     (const QStringList& processes);
+    void                    printReport             (QTextStream& out);
+    bool                    writeCsv                (const QString& fileName);
+    int                     divergences             ();
+    IPLOpenCVTuner*         tuner                   ()                          { return &_tuner; }
+
+    void                    setRepetitions          (int repetitions)           { _repetitions = repetitions; }
+    void                    setMeanTolerance        (double tolerance)          { _meanTolerance = tolerance; }
+    void                    setMaxTolerance         (double tolerance)          { _maxTolerance = tolerance; }
+
+private:
+    typedef QPair<QString, IPLImage*> CorpusImage;
+    typedef QList<QPair<QString, QString> > Variant;
+
+    QList<Variant>          variants                (IPLProcess* process);
+    bool                    applyVariant            (IPLProcess* process, const Variant& variant);
+    void                    measure                 (IPLProcess* process, const QString& variantName, const CorpusImage& image);
+
+    IPProcessFactory*       _factory;
+    IPLOpenCVTuner          _tuner;                 //!< collects the measurements, can be saved for the GUI
+    QList<CorpusImage>      _corpus;
+    QList<Result>           _results;
+    int                     _repetitions;
+    double                  _meanTolerance;
+    double                  _maxTolerance;
+};
+
+#endif // IPBENCHMARK_H
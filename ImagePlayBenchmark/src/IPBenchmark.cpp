@@ -0,0 +1,366 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include "IPBenchmark.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QDebug>
+
+#include <random>
+#include <cmath>
+
+IPBenchmark::IPBenchmark(IPProcessFactory* factory)
+{
+    _factory        = factory;
+    _repetitions    = 3;
+    _meanTolerance  = 0.02;
+    _maxTolerance   = 0.25;
+}
+
+IPBenchmark::~IPBenchmark()
+{
+    for(CorpusImage& image : _corpus)
+        delete image.second;
+}
+
+/*!
+ * \brief IPBenchmark::addSyntheticImages creates the synthetic test images
+ * Ramps, noise, a checkerboard, a disc and a constant image for every size,
+ * the noise is seeded so runs can be compared.
+ */
+void IPBenchmark::addSyntheticImages(const QList<int>& sizes)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+    for(int size : sizes)
+    {
+        QString suffix = QString("%1x%1").arg(size);
+
+        IPLImage* ramp = new IPLImage(IPL_IMAGE_GRAYSCALE, size, size);
+        IPLImage* noise = new IPLImage(IPL_IMAGE_COLOR, size, size);
+        IPLImage* checker = new IPLImage(IPL_IMAGE_GRAYSCALE, size, size);
+        IPLImage* disc = new IPLImage(IPL_IMAGE_COLOR, size, size);
+        IPLImage* constant = new IPLImage(IPL_IMAGE_GRAYSCALE, size, size);
+
+        float radius2 = (size/3.0f) * (size/3.0f);
+        for(int y = 0; y < size; y++)
+        {
+            for(int x = 0; x < size; x++)
+            {
+                ramp->plane(0)->p(x, y)     = (float) x / size;
+                checker->plane(0)->p(x, y)  = ((x/8 + y/8) % 2) ? 1.0f : 0.0f;
+                constant->plane(0)->p(x, y) = 0.5f;
+
+                float dx = x - size/2.0f;
+                float dy = y - size/2.0f;
+                bool inside = (dx*dx + dy*dy) < radius2;
+
+                for(int planeNr = 0; planeNr < 3; planeNr++)
+                {
+                    noise->plane(planeNr)->p(x, y) = distribution(generator);
+                    disc->plane(planeNr)->p(x, y)  = inside ? 0.2f + 0.3f*planeNr : (float) y / size;
+                }
+            }
+        }
+
+        _corpus.append(CorpusImage("ramp " + suffix, ramp));
+        _corpus.append(CorpusImage("noise " + suffix, noise));
+        _corpus.append(CorpusImage("checker " + suffix, checker));
+        _corpus.append(CorpusImage("disc " + suffix, disc));
+        _corpus.append(CorpusImage("constant " + suffix, constant));
+    }
+}
+
+/*!
+ * \brief IPBenchmark::addImages adds all readable images of a folder
+ * \return number of images added
+ */
+int IPBenchmark::addImages(const QString& folder)
+{
+    int count = 0;
+    QDir dir(folder);
+    QFileInfoList files = dir.entryInfoList(QDir::Files, QDir::Name);
+    for(QFileInfo& file : files)
+    {
+        IPLImage* image = NULL;
+        std::string information;
+        if(!IPLFileIO::loadFile(file.absoluteFilePath().toStdString(), image, information) || !image)
+        {
+            qWarning() << "Skipping" << file.fileName();
+            continue;
+        }
+
+        _corpus.append(CorpusImage(file.fileName(), image));
+        count++;
+    }
+    return count;
+}
+
+/*!
+ * \brief IPBenchmark::run measures all processes on all corpus images
+ * \param processes class names, all OPENCV_OPTIONAL processes if empty
+ */
+void IPBenchmark::run(const QStringList& processes)
+{
+    QStringList names = processes.isEmpty() ? _factory->getProcessNames() : processes;
+
+    for(QString name : names)
+    {
+        IPLProcess* process = _factory->getInstance(name);
+        if(!process)
+        {
+            qWarning() << "Unknown process" << name;
+            continue;
+        }
+
+        if(process->openCVSupport() != IPLProcess::OPENCV_OPTIONAL || process->isSource() || process->isSequence())
+        {
+            if(processes.contains(name))
+                qWarning() << name << "has no optional OpenCV implementation";
+            delete process;
+            continue;
+        }
+
+        QList<Variant> processVariants = variants(process);
+        for(const Variant& variant : processVariants)
+        {
+            // start from the defaults for every variant
+            delete process;
+            process = _factory->getInstance(name);
+
+            if(!applyVariant(process, variant))
+                continue;
+
+            QStringList variantName;
+            for(const QPair<QString, QString>& value : variant)
+                variantName.append(value.first + "=" + value.second);
+
+            for(const CorpusImage& image : _corpus)
+                measure(process, variantName.isEmpty() ? "default" : variantName.join(" "), image);
+        }
+
+        delete process;
+    }
+}
+
+QList<IPBenchmark::Variant> IPBenchmark::variants(IPLProcess* process)
+{
+    QList<Variant> result;
+    result.append(Variant());
+
+    IPLProcessPropertyMap* properties = process->properties();
+    for(auto it = properties->begin(); it != properties->end(); ++it)
+    {
+        IPLProcessProperty* property = it->second.get();
+        IPLProcessWidgetType widget = property->widget();
+        if(widget != IPL_WIDGET_SLIDER && widget != IPL_WIDGET_SLIDER_ODD
+                && widget != IPL_WIDGET_SLIDER_EVEN && widget != IPL_WIDGET_SPINNER)
+            continue;
+
+        QString key = QString::fromStdString(it->first);
+        QStringList values;
+
+        if(IPLProcessPropertyInt* p = dynamic_cast<IPLProcessPropertyInt*>(property))
+        {
+            if(p->min() < p->max())
+                values << QString::number(p->min()) << QString::number(p->max());
+        }
+        else if(IPLProcessPropertyDouble* p = dynamic_cast<IPLProcessPropertyDouble*>(property))
+        {
+            if(p->min() < p->max())
+                values << QString::number(p->min()) << QString::number(p->max());
+        }
+
+        for(QString value : values)
+        {
+            Variant variant;
+            variant.append(QPair<QString, QString>(key, value));
+            result.append(variant);
+        }
+    }
+    return result;
+}
+
+bool IPBenchmark::applyVariant(IPLProcess* process, const Variant& variant)
+{
+    for(const QPair<QString, QString>& value : variant)
+    {
+        IPLProcessProperty* property = process->property(value.first.toStdString());
+        if(!property)
+            return false;
+
+        IPLProcessProperty::SerializedData data = property->serialize();
+        data.value = value.second.toStdString();
+
+        try
+        {
+            property->deserialize(data);
+        }
+        catch(IPLProcessProperty::DeserialationFailed)
+        {
+            qWarning() << "Invalid value" << value.second << "for" << value.first;
+            return false;
+        }
+    }
+    return true;
+}
+
+void IPBenchmark::measure(IPLProcess* process, const QString& variantName, const CorpusImage& image)
+{
+    Result result;
+    result.process      = QString::fromStdString(process->className());
+    result.variant      = variantName;
+    result.image        = image.first;
+    result.width        = image.second->width();
+    result.height       = image.second->height();
+    result.planes       = image.second->getNumberOfPlanes();
+    result.nativeMs     = 0;
+    result.opencvMs     = 0;
+    result.meanError    = 0;
+    result.maxError     = 0;
+    result.compared     = true;
+    result.failed       = false;
+
+    std::string key = IPLOpenCVTuner::key(process, image.second);
+
+    for(int i = 0; i < _repetitions; i++)
+    {
+        IPLOpenCVTuner::Measurement measurement;
+        if(!_tuner.measure(process, image.second, 0, measurement))
+        {
+            qWarning() << result.process << "failed on" << result.image;
+            _tuner.recordFailure(key);
+            result.failed = true;
+            result.compared = false;
+            break;
+        }
+        _tuner.record(key, measurement);
+
+        // fastest run, largest error
+        double nativeMs = measurement.nativeUs / 1000.0;
+        double opencvMs = measurement.opencvUs / 1000.0;
+        result.nativeMs     = (i == 0) ? nativeMs : std::min(result.nativeMs, nativeMs);
+        result.opencvMs     = (i == 0) ? opencvMs : std::min(result.opencvMs, opencvMs);
+        result.meanError    = std::max(result.meanError, measurement.meanError);
+        result.maxError     = std::max(result.maxError, measurement.maxError);
+        result.compared     = result.compared && measurement.compared;
+    }
+
+    result.diverges = result.failed
+                   || !result.compared
+                   || result.meanError > _meanTolerance
+                   || result.maxError > _maxTolerance;
+
+    _results.append(result);
+}
+
+int IPBenchmark::divergences()
+{
+    int count = 0;
+    for(const Result& result : _results)
+    {
+        if(result.diverges)
+            count++;
+    }
+    return count;
+}
+
+void IPBenchmark::printReport(QTextStream& out)
+{
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+           .arg("Process", -24).arg("Variant", -18).arg("Image", -22)
+           .arg("Native ms", 10).arg("OpenCV ms", 10).arg("Ratio", 7)
+           .arg("Mean err", 9).arg("Max err", 8);
+
+    for(const Result& r : _results)
+    {
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8%9\n")
+               .arg(r.process, -24).arg(r.variant, -18).arg(r.image, -22)
+               .arg(r.nativeMs, 10, 'f', 2).arg(r.opencvMs, 10, 'f', 2)
+               .arg(r.opencvMs > 0 ? r.nativeMs / r.opencvMs : 0.0, 7, 'f', 2)
+               .arg(r.meanError, 9, 'f', 4).arg(r.maxError, 8, 'f', 4)
+               .arg(r.failed ? "  FAILED" : !r.compared ? "  DIVERGES (size)" : r.diverges ? "  DIVERGES" : "");
+    }
+
+    // summary per process
+    QMap<QString, QList<Result> > byProcess;
+    for(const Result& r : _results)
+        byProcess[r.process].append(r);
+
+    out << "\n";
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+           .arg("Process", -24).arg("Runs", 5).arg("Mean err", 9).arg("Max err", 8)
+           .arg("Ratio (geo. mean)", 18).arg("Divergent", 10);
+
+    for(auto it = byProcess.begin(); it != byProcess.end(); ++it)
+    {
+        double meanError = 0;
+        double maxError = 0;
+        double logRatio = 0;
+        int ratios = 0;
+        int divergent = 0;
+        for(const Result& r : it.value())
+        {
+            meanError += r.meanError;
+            maxError = std::max(maxError, r.maxError);
+            if(r.nativeMs > 0 && r.opencvMs > 0)
+            {
+                logRatio += std::log(r.nativeMs / r.opencvMs);
+                ratios++;
+            }
+            if(r.diverges)
+                divergent++;
+        }
+
+        int runs = it.value().size();
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg(it.key(), -24).arg(runs, 5)
+               .arg(meanError / runs, 9, 'f', 4).arg(maxError, 8, 'f', 4)
+               .arg(ratios > 0 ? std::exp(logRatio / ratios) : 0.0, 18, 'f', 2)
+               .arg(divergent, 10);
+    }
+
+    out << "\nRatio > 1: OpenCV is faster. Tolerances: mean " << _meanTolerance
+        << ", max " << _maxTolerance << "\n";
+}
+
+bool IPBenchmark::writeCsv(const QString& fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    out << "process,variant,image,width,height,planes,native_ms,opencv_ms,ratio,mean_error,max_error,failed,diverges\n";
+    for(const Result& r : _results)
+    {
+        out << r.process << "," << r.variant << "," << r.image << ","
+            << r.width << "," << r.height << "," << r.planes << ","
+            << r.nativeMs << "," << r.opencvMs << ","
+            << (r.opencvMs > 0 ? r.nativeMs / r.opencvMs : 0.0) << ","
+            << r.meanError << "," << r.maxError << ","
+            << (r.failed ? 1 : 0) << "," << (r.diverges ? 1 : 0) << "\n";
+    }
+    return true;
+}
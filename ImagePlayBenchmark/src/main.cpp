@@ -0,0 +1,96 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QDebug>
+
+#include "IPBenchmark.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setApplicationName("ImagePlayBenchmark");
+    QCoreApplication::setApplicationVersion(APP_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compares the native and OpenCV implementations of all processes with optional OpenCV support.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption processOption("process", "Process class name, may be repeated (default: all).", "name");
+    QCommandLineOption sizesOption("sizes", "Sizes of the synthetic images.", "list", "64,256,1024");
+    QCommandLineOption imagesOption("images", "Folder with additional test images.", "path");
+    QCommandLineOption repetitionsOption("repetitions", "Runs per image, the fastest run is reported.", "n", "3");
+    QCommandLineOption meanToleranceOption("mean-tolerance", "Allowed mean absolute error (0.0-1.0).", "value", "0.02");
+    QCommandLineOption maxToleranceOption("max-tolerance", "Allowed max absolute error (0.0-1.0).", "value", "0.25");
+    QCommandLineOption csvOption("csv", "Write all results to a CSV file.", "file");
+    QCommandLineOption tuningOption("tuning", "Write the measurements for the Auto OpenCV mode.", "file");
+    QCommandLineOption strictOption("strict", "Exit with code 2 if any divergence was found.");
+
+    parser.addOption(processOption);
+    parser.addOption(sizesOption);
+    parser.addOption(imagesOption);
+    parser.addOption(repetitionsOption);
+    parser.addOption(meanToleranceOption);
+    parser.addOption(maxToleranceOption);
+    parser.addOption(csvOption);
+    parser.addOption(tuningOption);
+    parser.addOption(strictOption);
+    parser.process(a);
+
+    IPProcessFactory factory;
+    factory.registerBuiltinProcesses();
+
+    IPBenchmark benchmark(&factory);
+    benchmark.setRepetitions(qMax(1, parser.value(repetitionsOption).toInt()));
+    benchmark.setMeanTolerance(parser.value(meanToleranceOption).toDouble());
+    benchmark.setMaxTolerance(parser.value(maxToleranceOption).toDouble());
+
+    QList<int> sizes;
+    foreach (QString size, parser.value(sizesOption).split(',', QString::SkipEmptyParts))
+    {
+        if(size.toInt() > 0)
+            sizes.append(size.toInt());
+    }
+    benchmark.addSyntheticImages(sizes);
+
+    if(parser.isSet(imagesOption))
+        benchmark.addImages(parser.value(imagesOption));
+
+    benchmark.run(parser.values(processOption));
+
+    QTextStream out(stdout);
+    benchmark.printReport(out);
+    out.flush();
+
+    if(parser.isSet(csvOption) && !benchmark.writeCsv(parser.value(csvOption)))
+        qCritical() << "Could not write" << parser.value(csvOption);
+
+    if(parser.isSet(tuningOption) && !benchmark.tuner()->save(parser.value(tuningOption).toStdString()))
+        qCritical() << "Could not write" << parser.value(tuningOption);
+
+    if(parser.isSet(strictOption) && benchmark.divergences() > 0)
+        return 2;
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#############################################################################
+#
+#  This file is part of ImagePlay.
+#
+#  ImagePlay is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ImagePlay is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+#
+##############################################################################
+
+
+QT       += core network
+QT       -= gui
+
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TARGET = ImagePlayServer
+TEMPLATE = app
+
+VERSION = "6.1.0"
+DEFINES += APP_VERSION=\\\"$$VERSION\\\"
+
+win32 {contains(QMAKE_TARGET.arch, x86_64) {PLATFORM = x64} else {PLATFORM = Win32}}
+macx {PLATFORM = macx}
+unix:!macx:!android {PLATFORM = linux}
+
+CONFIG(debug, debug|release) {CONFIGURATION = Debug} else {CONFIGURATION = Release}
+
+DESTDIR = ../_bin/$$CONFIGURATION/$$PLATFORM
+OBJECTS_DIR = ../intermediate/$$TARGET/$$CONFIGURATION/$$PLATFORM
+MOC_DIR = ../intermediate/$$TARGET/$$CONFIGURATION/$$PLATFORM
+RCC_DIR = ../intermediate/$$TARGET/$$CONFIGURATION/$$PLATFORM
+UI_DIR = ../intermediate/$$TARGET/$$CONFIGURATION/$$PLATFORM
+
+HEADERS     += $$files(include/*.h,true)
+SOURCES     += $$files(src/*.cpp,true)
+OTHER_FILES += $$files(*.md,true)
+
+# the process factory is shared with the GUI
+HEADERS     += ../ImagePlay/include/IPProcessFactory.h
+SOURCES     += ../ImagePlay/src/IPProcessFactory.cpp
+
+win32: {
+    LIBS += -L$$PWD/../_bin/$$CONFIGURATION/$$PLATFORM -lIPL
+}
+
+macx: {
+    QMAKE_MAC_SDK = macosx10.12
+    LIBS += -L$$PWD/../_lib/ -lIPL
+    LIBS += -L$$PWD/../_lib/freeimage/ -lfreeimage-3.16.0
+}
+
+linux: {
+    # libraries of the static IPL which are not listed here come from its .prl file
+    CONFIG += link_prl
+    LIBS += -L../_bin/$$CONFIGURATION/$$PLATFORM/ -lIPL
+
+    LIBS += -lfreeimage
+    LIBS += -lopencv_core
+    LIBS += -lopencv_imgproc
+    LIBS += -lopencv_highgui
+    LIBS += -lopencv_videoio
+    LIBS += -lopencv_calib3d
+    LIBS += -lopencv_optflow
+    LIBS += -lopencv_features2d
+    LIBS += -lopencv_xfeatures2d
+    LIBS += -lopencv_photo
+    LIBS += -lopencv_xphoto
+    LIBS += -ldl
+}
+
+unix : !macx : !isEqual(QMAKE_WIN32,1){
+        isEmpty(PREFIX): PREFIX = /usr
+        TARGET = imageplay-server
+        target.path = $${PREFIX}/bin
+        INSTALLS += target
+}
+
+clang {
+    CONFIG +=c++11
+    QMAKE_CXXFLAGS += -openmp
+    QMAKE_LFLAGS   += -openmp
+}
+
+gcc:!clang {
+    CONFIG +=c++11
+    QMAKE_CXXFLAGS += -fopenmp
+    QMAKE_LFLAGS   += -fopenmp
+    LIBS += -lgomp
+}
+
+msvc {
+    QMAKE_CXXFLAGS += -openmp
+}
+
+INCLUDEPATH += $$PWD/include/
+INCLUDEPATH += $$PWD/../ImagePlay/include/
+INCLUDEPATH += $$PWD/../IPL/include/
+INCLUDEPATH += $$PWD/../IPL/include/processes/
+INCLUDEPATH += $$PWD/../IPL/include/opencv/
+DEPENDPATH += $$PWD/../IPL/include/
@@ -0,0 +1,126 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#ifndef IPSERVER_H
+#define IPSERVER_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QThreadPool>
+#include <QMap>
+#include <QList>
+#include <QByteArray>
+#include <QDebug>
+
+#include "IPProcessFactory.h"
+#include "IPServerGraphPool.h"
+
+#include <pugg/Kernel.h>
+
+//-----------------------------------------------------------------------------
+//!IPServer is the long-running local processing service
+/*!
+ * Listens on a local socket (Unix domain socket on Linux/macOS, named pipe
+ * on Windows). Every message in both directions is framed as:
+ *
+ *   uint32 little-endian header length | JSON header | payload
+ *
+ * The payload size is given by "payloadSize" in the header. Headers above
+ * 1 MiB, payloads above 1 GiB and invalid headers are answered with an error
+ * and the connection is closed. A request header looks like:
+ *
+ *   {
+ *     "id": 1,                            // echoed in the response
+ *     "project": "denoise",               // registered with --project
+ *     "format": "rgb24", "width": 640, "height": 480, "channels": 3,
+ *     "payloadSize": 921600,              // or "shm": {"name","offset","size"}
+ *     "frames": 1,                        // optional, consecutive frames in the payload
+ *     "input": 2,                         // optional, source step to replace
+ *     "output": {"step": 5, "index": 0},  // optional, default: last step
+ *     "outputFormat": "gray8",            // optional, default: "format"
+ *     "outputShm": {"name","offset","size"}, // optional, write result there
+ *     "properties": [{"step": 3, "key": "sigma", "value": "4.0"}],
+ *     "opencv": false                     // optional
+ *   }
+ *
+ * The response header contains "status" ("ok" or "error"), "error", the image
+ * description of the payload and "timing" with the queue, processing and
+ * per step durations. Requests with several "frames" are answered with the
+ * same number of consecutive output frames; if the steps from "input" to
+ * "output" form a simple chain, all frames run through each step at once
+ * ("batch": true), otherwise the graph is executed once per frame.
+ * Requests are processed concurrently, responses may therefore arrive out
+ * of order, use "id" to match them.
+ *
+ * With --run, a single process file is executed once per frame instead,
+ * until its source ends, e.g. for ffmpeg pipelines with Raw Video Input
+ * and Output on stdin and stdout.
+ */
+class IPServer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit                IPServer                (QObject* parent = 0);
+                            ~IPServer               ();
+    void                    loadPlugins             (QString pluginPath);
+    bool                    registerProject         (QString name, QString fileName, int instances, QString& error);
+    bool                    listen                  (QString socketName, int concurrency);
+    bool                    runProject              (QString fileName, QString& error);
+    IPServerGraphPool*      project                 (QString name)          { return _projects.value(name, NULL); }
+    QThreadPool*            threadPool              ()                      { return &_threadPool; }
+    void                    setUseOpenCV            (bool enabled)          { _useOpenCV = enabled; }
+    bool                    useOpenCV               ()                      { return _useOpenCV; }
+
+private slots:
+    void                    on_newConnection        ();
+
+private:
+    QLocalServer*                       _server;
+    QThreadPool                         _threadPool;
+    IPProcessFactory*                   _factory;
+    QMap<QString, IPServerGraphPool*>   _projects;
+    QList<pugg::Kernel*>                _kernels;
+    bool                                _useOpenCV;
+};
+
+//-----------------------------------------------------------------------------
+//!IPServerConnection reads framed requests from one client
+class IPServerConnection : public QObject
+{
+    Q_OBJECT
+public:
+                            IPServerConnection      (QLocalSocket* socket, IPServer* server);
+
+public slots:
+    void                    sendResponse            (QByteArray header, QByteArray payload);
+
+private slots:
+    void                    on_readyRead            ();
+
+private:
+    void                    reject                  (QString error);
+
+    QLocalSocket*           _socket;
+    IPServer*               _server;
+    QByteArray              _buffer;
+};
+
+#endif // IPSERVER_H
@@ -0,0 +1,117 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#ifndef IPSERVERGRAPH_H
+#define IPSERVERGRAPH_H
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include <vector>
+
+#include "IPL_processes.h"
+#include "IPLFileIO.h"
+#include "IPProcessFactory.h"
+
+//-----------------------------------------------------------------------------
+//!IPServerGraph is a headless instance of a process graph (.ipj)
+/*!
+ * Mirrors what IPProcessGrid does for the GUI, but without any Qt widgets:
+ * the processes are created once and kept alive between requests, only the
+ * steps which are affected by a new input image or a property override are
+ * executed again.
+ */
+class IPServerGraph
+{
+public:
+    struct Edge
+    {
+        long                from;
+        long                to;
+        int                 indexFrom;
+        int                 indexTo;
+    };
+
+    struct Step
+    {
+        long                id;
+        IPLProcess*         process;
+        QList<Edge>         edgesIn;
+        QList<long>         stepsOut;
+        bool                needsUpdate;
+    };
+
+    struct PropertyOverride
+    {
+        long                stepID;
+        QString             key;
+        QString             value;
+    };
+
+    struct StepTiming
+    {
+        long                stepID;
+        QString             className;
+        qint64              durationUs;
+    };
+
+                            IPServerGraph           ();
+                            ~IPServerGraph          ();
+    bool                    load                    (const QJsonObject& root, const QString& baseDir, IPProcessFactory* factory, QString& error);
+    bool                    execute                 (IPLImage* input, long inputStep, const QList<PropertyOverride>& overrides,
+                                                     bool useOpenCV, QList<StepTiming>& timings, QString& error);
+    bool                    batchPath               (long inputStep, long outputStep, QList<Step*>& path);
+    bool                    executeBatch            (const std::vector<IPLData*>& inputs, long inputStep, long outputStep, int outputIndex,
+                                                     const QList<PropertyOverride>& overrides, bool useOpenCV,
+                                                     std::vector<IPLData*>& results, QList<StepTiming>& timings, QString& error);
+    IPLData*                result                  (long stepID, int index);
+    bool                    hasStep                 (long stepID)               { return _steps.contains(stepID); }
+    long                    defaultInputStep        ()                          { return _defaultInputStep; }
+    long                    defaultOutputStep       ()                          { return _defaultOutputStep; }
+
+private:
+    struct PropertyBackup
+    {
+        Step*                               step;
+        IPLProcessProperty*                 property;
+        IPLProcessProperty::SerializedData  data;
+    };
+
+    bool                    sortSteps               (QString& error);
+    bool                    applyOverrides          (const QList<PropertyOverride>& overrides, QList<PropertyBackup>& backups, QString& error);
+    void                    restoreOverrides        (QList<PropertyBackup>& backups);
+    void                    markNeedsUpdate         (Step* step);
+    bool                    runProcess              (IPLProcess* process, IPLData* data, int inputIndex, bool useOpenCV);
+    QString                 collectErrors           (IPLProcess* process);
+
+    QMap<long, Step*>       _steps;                 //!< All steps by their file ID
+    QList<Step*>            _order;                 //!< Topological execution order
+    long                    _defaultInputStep;      //!< First source step, receives the request image
+    long                    _defaultOutputStep;     //!< Last step in execution order
+    IPLImage*               _input;                 //!< Image injected for the current request
+    long                    _inputStep;             //!< Step which is replaced by _input
+    bool                    _inputInjected;         //!< Last request replaced _inputStep
+};
+
+#endif // IPSERVERGRAPH_H
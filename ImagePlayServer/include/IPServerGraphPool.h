@@ -0,0 +1,59 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#ifndef IPSERVERGRAPHPOOL_H
+#define IPSERVERGRAPHPOOL_H
+
+#include <QString>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "IPServerGraph.h"
+
+//-----------------------------------------------------------------------------
+//!IPServerGraphPool keeps warm instances of one registered process file
+/*!
+ * Every instance owns its own copy of all processes, so requests for the
+ * same project can run concurrently. acquire() blocks until an instance is
+ * free.
+ */
+class IPServerGraphPool
+{
+public:
+                            IPServerGraphPool       (QString name, QString fileName);
+                            ~IPServerGraphPool      ();
+    bool                    load                    (int instances, IPProcessFactory* factory, QString& error);
+    IPServerGraph*          acquire                 ();
+    void                    release                 (IPServerGraph* graph);
+    QString                 name                    ()                              { return _name; }
+    QString                 fileName                ()                              { return _fileName; }
+    int                     instanceCount           ()                              { return _instances.size(); }
+
+private:
+    QString                 _name;
+    QString                 _fileName;
+    QList<IPServerGraph*>   _instances;             //!< All instances, owned by the pool
+    QList<IPServerGraph*>   _available;             //!< Currently unused instances
+    QMutex                  _mutex;
+    QWaitCondition          _instanceReleased;
+};
+
+#endif // IPSERVERGRAPHPOOL_H
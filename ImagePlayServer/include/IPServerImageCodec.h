@@ -0,0 +1,68 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#ifndef IPSERVERIMAGECODEC_H
+#define IPSERVERIMAGECODEC_H
+
+#include <QString>
+#include <QByteArray>
+#include <QJsonObject>
+
+#include "IPLImage.h"
+
+//-----------------------------------------------------------------------------
+//!IPServerImageCodec converts between raw request buffers and IPLImage
+/*!
+ * Supported formats:
+ * - gray8:   1 byte per pixel
+ * - gray16:  2 bytes per pixel, native byte order
+ * - rgb24:   3 bytes per pixel, interleaved RGB
+ * - float32: planar 32 bit float, "channels" planes, values 0.0-1.0
+ */
+class IPServerImageCodec
+{
+public:
+    static qint64           bufferSize              (const QString& format, int width, int height, int channels);
+    static IPLImage*        decode                  (const QString& format, int width, int height, int channels,
+                                                     const uchar* data, qint64 size, QString& error);
+    static int              channels                (const QString& format, IPLImage* image);
+    static bool             encode                  (IPLImage* image, const QString& format, uchar* data, qint64 size, QString& error);
+};
+
+//-----------------------------------------------------------------------------
+//!IPServerSharedMemory maps a POSIX shared memory region for one request
+class IPServerSharedMemory
+{
+public:
+                            IPServerSharedMemory    ();
+                            ~IPServerSharedMemory   ();
+    bool                    map                     (const QJsonObject& handle, bool writable, QString& error);
+    void                    unmap                   ();
+    uchar*                  data                    ()                              { return _data; }
+    qint64                  size                    ()                              { return _size; }
+
+private:
+    void*                   _mapping;
+    size_t                  _mappingSize;
+    uchar*                  _data;
+    qint64                  _size;
+};
+
+#endif // IPSERVERIMAGECODEC_H
@@ -0,0 +1,66 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#ifndef IPSERVERJOB_H
+#define IPSERVERJOB_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+#include <vector>
+
+#include "IPServer.h"
+#include "IPServerImageCodec.h"
+
+//-----------------------------------------------------------------------------
+//!IPServerJob processes a single request on the server thread pool
+/*!
+ * The response is delivered with the finished signal, which is connected
+ * to the IPServerConnection living in the main thread.
+ */
+class IPServerJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+                            IPServerJob             (IPServer* server, QJsonObject request, QByteArray payload);
+    void                    run                     ();
+
+signals:
+    void                    finished                (QByteArray header, QByteArray payload);
+
+private:
+    bool                    process                 (QJsonObject& response, QByteArray& responsePayload, QString& error);
+    bool                    decodeFrames            (const QString& format, int width, int height, int channels, int frames,
+                                                     const uchar* data, qint64 size, std::vector<IPLData*>& inputs, QString& error);
+    bool                    encodeFrames            (const std::vector<IPLData*>& results, long outputStep, int outputIndex, const QString& format,
+                                                     QJsonObject& response, QByteArray& responsePayload, QString& error);
+    void                    respond                 (QJsonObject response, const QByteArray& payload);
+
+    IPServer*               _server;
+    QJsonObject             _request;
+    QByteArray              _payload;
+    QElapsedTimer           _queueTimer;            //!< Started when the request was received
+};
+
+#endif // IPSERVERJOB_H
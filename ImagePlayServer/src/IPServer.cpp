@@ -0,0 +1,271 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include "IPServer.h"
+#include "IPServerJob.h"
+#include "IPLRawVideoIO.h"
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QtEndian>
+
+#include <cmath>
+
+//! largest accepted request header, larger ones are rejected
+static const quint32 MAX_HEADER_SIZE = 1024 * 1024;
+
+//! largest accepted request payload, larger ones are rejected
+static const qint64 MAX_PAYLOAD_SIZE = 1024 * 1024 * 1024;
+
+IPServer::IPServer(QObject* parent) : QObject(parent)
+{
+    _server     = new QLocalServer(this);
+    _useOpenCV  = false;
+
+    _factory = new IPProcessFactory;
+    _factory->registerBuiltinProcesses();
+
+    connect(_server, &QLocalServer::newConnection, this, &IPServer::on_newConnection);
+}
+
+IPServer::~IPServer()
+{
+    _threadPool.waitForDone();
+
+    qDeleteAll(_projects);
+    delete _factory;
+
+    for(pugg::Kernel* kernel : _kernels)
+    {
+        kernel->clear();
+        delete kernel;
+    }
+}
+
+/*!
+ * \brief IPServer::loadPlugins loads all plugins once at startup
+ * Unlike IPPluginManager, the libraries are loaded in place: the server
+ * does not reload plugins, so there is no need for the temporary copies.
+ */
+void IPServer::loadPlugins(QString pluginPath)
+{
+#if defined(_WIN32)
+    static const auto pluginFilter = QStringList() << "*.dll";
+#else
+    static const auto pluginFilter = QStringList() << "*.so";
+#endif
+
+    QDir pluginsDir(pluginPath);
+    pluginsDir.setNameFilters(pluginFilter);
+
+    foreach (QString fileName, pluginsDir.entryList(QDir::Files))
+    {
+        pugg::Kernel* kernel = new pugg::Kernel;
+        kernel->add_server(IPLProcess::server_name(), IPLProcess::version);
+        if(!kernel->load_plugin(pluginsDir.filePath(fileName).toStdString()))
+        {
+            qWarning() << "Could not load plugin: " << fileName;
+            delete kernel;
+            continue;
+        }
+        _kernels.push_back(kernel);
+
+        std::vector<IPLProcessDriver*> drivers = kernel->get_all_drivers<IPLProcessDriver>(IPLProcess::server_name());
+        if(drivers.size() == 0)
+        {
+            qWarning() << "Plugin IPL version does not match IPL API version" << IPL_VERSION << ": " << fileName;
+            continue;
+        }
+
+        for(IPLProcessDriver* driver : drivers)
+            _factory->registerProcess(QString::fromStdString(driver->className()), driver->create());
+    }
+}
+
+bool IPServer::registerProject(QString name, QString fileName, int instances, QString& error)
+{
+    if(_projects.contains(name))
+    {
+        error = QString("Project already registered: %1").arg(name);
+        return false;
+    }
+
+    IPServerGraphPool* pool = new IPServerGraphPool(name, fileName);
+    if(!pool->load(instances, _factory, error))
+    {
+        delete pool;
+        return false;
+    }
+
+    _projects.insert(name, pool);
+    return true;
+}
+
+bool IPServer::listen(QString socketName, int concurrency)
+{
+    _threadPool.setMaxThreadCount(concurrency);
+
+    // remove a stale socket of a previous instance
+    QLocalServer::removeServer(socketName);
+
+    return _server->listen(socketName);
+}
+
+/*!
+ * \brief IPServer::runProject executes a process file again and again until a step fails
+ * Sequence sources like Raw Video Input deliver a new frame every time, the
+ * end of the raw video input is the regular end of the run.
+ * \param fileName
+ * \param error
+ * \return true if the run ended with the input stream
+ */
+bool IPServer::runProject(QString fileName, QString& error)
+{
+    IPServerGraphPool pool("run", fileName);
+    if(!pool.load(1, _factory, error))
+        return false;
+
+    IPServerGraph* graph = pool.acquire();
+    QList<IPServerGraph::PropertyOverride> overrides;
+    QList<IPServerGraph::StepTiming> timings;
+    qint64 frames = 0;
+    bool success = true;
+
+    for(;;)
+    {
+        timings.clear();
+        if(!graph->execute(NULL, -1, overrides, _useOpenCV, timings, error))
+        {
+            success = IPLRawVideoIO::endOfInput();
+            if(success)
+                error.clear();
+            break;
+        }
+
+        // without a sequence source, nothing runs after the first execution
+        if(timings.isEmpty())
+            break;
+
+        frames++;
+    }
+
+    pool.release(graph);
+
+    // the reader thread must not wait on the queue while the application exits
+    IPLRawVideoIO::shutdown();
+
+    // stdout may carry the frames, so all messages go to stderr
+    qInfo() << "Processed" << frames << "frames," << IPLRawVideoIO::framesWritten() << "written.";
+    return success;
+}
+
+void IPServer::on_newConnection()
+{
+    while(_server->hasPendingConnections())
+    {
+        QLocalSocket* socket = _server->nextPendingConnection();
+        new IPServerConnection(socket, this);
+    }
+}
+
+IPServerConnection::IPServerConnection(QLocalSocket* socket, IPServer* server) : QObject(socket)
+{
+    _socket = socket;
+    _server = server;
+
+    connect(_socket, &QLocalSocket::readyRead, this, &IPServerConnection::on_readyRead);
+    connect(_socket, &QLocalSocket::disconnected, _socket, &QObject::deleteLater);
+}
+
+void IPServerConnection::on_readyRead()
+{
+    _buffer.append(_socket->readAll());
+
+    // there may be more than one request in the buffer
+    while(_buffer.size() >= 4)
+    {
+        quint32 headerSize = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(_buffer.constData()));
+        if(headerSize > MAX_HEADER_SIZE)
+        {
+            reject(QString("Request header too large: %1 bytes").arg(headerSize));
+            return;
+        }
+        if(_buffer.size() < 4 + (qint64) headerSize)
+            return;
+
+        QJsonParseError parseError;
+        QJsonDocument document = QJsonDocument::fromJson(_buffer.mid(4, headerSize), &parseError);
+        if(!document.isObject())
+        {
+            reject(QString("Invalid request header: %1").arg(parseError.errorString()));
+            return;
+        }
+
+        QJsonObject request = document.object();
+        QJsonValue payloadValue = request.value("payloadSize");
+        double payloadDouble = payloadValue.toDouble(0);
+        if(!(payloadValue.isUndefined() || payloadValue.isDouble())
+                || payloadDouble < 0 || payloadDouble > MAX_PAYLOAD_SIZE
+                || payloadDouble != std::floor(payloadDouble))
+        {
+            reject(QString("Invalid payloadSize"));
+            return;
+        }
+
+        qint64 payloadSize = (qint64) payloadDouble;
+        if(_buffer.size() < 4 + (qint64) headerSize + payloadSize)
+            return;
+
+        QByteArray payload = _buffer.mid(4 + headerSize, payloadSize);
+        _buffer.remove(0, 4 + headerSize + payloadSize);
+
+        IPServerJob* job = new IPServerJob(_server, request, payload);
+        connect(job, &IPServerJob::finished, this, &IPServerConnection::sendResponse, Qt::QueuedConnection);
+        connect(job, &IPServerJob::finished, job, &QObject::deleteLater, Qt::QueuedConnection);
+        _server->threadPool()->start(job);
+    }
+}
+
+/*!
+ * \brief IPServerConnection::reject answers a request which can not be framed and closes the connection
+ * The end of the request is unknown, so the following requests can't be found anymore.
+ * \param error
+ */
+void IPServerConnection::reject(QString error)
+{
+    QJsonObject response;
+    response.insert("status", "error");
+    response.insert("error", error);
+    response.insert("payloadSize", 0);
+    sendResponse(QJsonDocument(response).toJson(QJsonDocument::Compact), QByteArray());
+
+    _socket->disconnectFromServer();
+    _buffer.clear();
+}
+
+void IPServerConnection::sendResponse(QByteArray header, QByteArray payload)
+{
+    uchar size[4];
+    qToLittleEndian<quint32>(header.size(), size);
+
+    _socket->write(reinterpret_cast<const char*>(size), 4);
+    _socket->write(header);
+    _socket->write(payload);
+}
@@ -0,0 +1,584 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include "IPServerGraph.h"
+
+#include <QJsonArray>
+#include <QDir>
+#include <QQueue>
+#include <QSet>
+
+IPServerGraph::IPServerGraph()
+{
+    _defaultInputStep   = -1;
+    _defaultOutputStep  = -1;
+    _input              = NULL;
+    _inputStep          = -1;
+    _inputInjected      = false;
+}
+
+IPServerGraph::~IPServerGraph()
+{
+    for(auto it = _steps.begin(); it != _steps.end(); ++it)
+    {
+        delete it.value()->process;
+        delete it.value();
+    }
+}
+
+/*!
+ * \brief IPServerGraph::load creates all processes of a .ipj document
+ * \param root parsed process file
+ * \param baseDir directory of the process file, used for relative paths
+ * \param factory process factory including plugins
+ * \param error
+ * \return true on success
+ */
+bool IPServerGraph::load(const QJsonObject& root, const QString& baseDir, IPProcessFactory* factory, QString& error)
+{
+    QDir dir(baseDir);
+
+    QJsonArray steps = root.value("steps").toArray();
+    for(auto it = steps.begin(); it != steps.end(); ++it)
+    {
+        QJsonObject stepObject = (*it).toObject();
+
+        long ID = stepObject.value("ID").toDouble();
+        QString type = stepObject.value("type").toString();
+
+        IPLProcess* process = factory->getInstance(type);
+        if(!process)
+        {
+            error = QString("Invalid Process Type: %1").arg(type);
+            return false;
+        }
+
+        // set the properties
+        QJsonArray properties = stepObject.value("properties").toArray();
+        for(auto it2 = properties.begin(); it2 != properties.end(); ++it2)
+        {
+            QJsonObject propertyObject = (*it2).toObject();
+            QString key     = propertyObject.value("key").toString();
+
+            IPLProcessProperty* processProperty = process->property(key.toStdString());
+            if(!processProperty)
+            {
+                qWarning() << "Invalid process property: " << key;
+                continue;
+            }
+
+            IPLProcessProperty::SerializedData data;
+            data.type   = propertyObject.value("type").toString().toStdString();
+            data.widget = propertyObject.value("widget").toString().toStdString();
+            data.value  = propertyObject.value("value").toVariant().toString().toStdString();
+
+            // IPLFileIO::setBasedir is global, several projects may be
+            // loaded at the same time, so we make the paths absolute here
+            IPLProcessWidgetType widget = processProperty->widget();
+            if((widget == IPL_WIDGET_FILE_OPEN || widget == IPL_WIDGET_FILE_SAVE || widget == IPL_WIDGET_FOLDER)
+                    && data.value.length() > 0
+                    && !IPLFileIO::isAbsolutePath(data.value))
+            {
+                data.value = dir.absoluteFilePath(QString::fromStdString(data.value)).toStdString();
+            }
+
+            try
+            {
+                processProperty->deserialize(data);
+            }
+            catch(IPLProcessProperty::DeserialationFailed)
+            {
+                qWarning() << "Deserialation failed: " << key;
+                continue;
+            }
+        }
+
+        Step* step          = new Step;
+        step->id            = ID;
+        step->process       = process;
+        step->needsUpdate   = true;
+        _steps.insert(ID, step);
+    }
+
+    QJsonArray edges = root.value("edges").toArray();
+    for(auto it = edges.begin(); it != edges.end(); ++it)
+    {
+        QJsonObject edgeObject = (*it).toObject();
+
+        Edge edge;
+        edge.from       = edgeObject.value("from").toDouble();
+        edge.to         = edgeObject.value("to").toDouble();
+        edge.indexFrom  = edgeObject.value("indexFrom").toDouble();
+        edge.indexTo    = edgeObject.value("indexTo").toDouble();
+
+        if(!_steps.contains(edge.from) || !_steps.contains(edge.to))
+        {
+            error = QString("Invalid edge: %1 -> %2").arg(edge.from).arg(edge.to);
+            return false;
+        }
+
+        std::vector<IPLProcessIO>* inputs = _steps[edge.to]->process->inputs();
+        if(edge.indexTo < 0 || edge.indexTo >= (int) inputs->size())
+        {
+            error = QString("Invalid edge input: %1 -> %2").arg(edge.from).arg(edge.to);
+            return false;
+        }
+
+        // processes with optional inputs wait for the connected ones, like in the editor
+        inputs->at(edge.indexTo).occupied = true;
+
+        _steps[edge.to]->edgesIn.append(edge);
+        _steps[edge.from]->stepsOut.append(edge.to);
+    }
+
+    if(!sortSteps(error))
+        return false;
+
+    for(Step* step : _order)
+    {
+        if(step->process->isSource())
+        {
+            _defaultInputStep = step->id;
+            break;
+        }
+    }
+
+    if(_order.size() > 0)
+        _defaultOutputStep = _order.last()->id;
+
+    return true;
+}
+
+/*!
+ * \brief IPServerGraph::sortSteps builds the execution order (Kahn's algorithm)
+ */
+bool IPServerGraph::sortSteps(QString& error)
+{
+    QMap<long, int> inDegree;
+    QQueue<Step*> queue;
+
+    for(auto it = _steps.begin(); it != _steps.end(); ++it)
+    {
+        inDegree.insert(it.key(), it.value()->edgesIn.size());
+        if(it.value()->edgesIn.size() == 0)
+            queue.enqueue(it.value());
+    }
+
+    _order.clear();
+    while(!queue.isEmpty())
+    {
+        Step* step = queue.dequeue();
+        _order.append(step);
+
+        for(long next : step->stepsOut)
+        {
+            if(--inDegree[next] == 0)
+                queue.enqueue(_steps[next]);
+        }
+    }
+
+    if(_order.size() != _steps.size())
+    {
+        error = "The process graph contains a cycle.";
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief IPServerGraph::execute runs all steps which need an update
+ * \param input request image, replaces the result of inputStep, may be NULL
+ * \param inputStep ID of the source step which is replaced
+ * \param overrides property values which are only valid for this request
+ * \param useOpenCV
+ * \param timings duration of every executed step
+ * \param error
+ * \return true on success
+ */
+bool IPServerGraph::execute(IPLImage* input, long inputStep, const QList<PropertyOverride>& overrides,
+                            bool useOpenCV, QList<StepTiming>& timings, QString& error)
+{
+    // the source step has never run on its own if the last request replaced it
+    if(_inputInjected && (!input || inputStep != _inputStep) && _steps.contains(_inputStep))
+        markNeedsUpdate(_steps[_inputStep]);
+
+    _input          = input;
+    _inputStep      = input ? inputStep : -1;
+    _inputInjected  = (input != NULL);
+
+    if(input)
+    {
+        if(!_steps.contains(inputStep))
+        {
+            error = QString("Invalid input step: %1").arg(inputStep);
+            return false;
+        }
+        markNeedsUpdate(_steps[inputStep]);
+    }
+
+    // sequences like the camera need to run every time
+    for(Step* step : _order)
+    {
+        if(step->process->isSequence())
+            markNeedsUpdate(step);
+    }
+
+    QList<PropertyBackup> backups;
+    if(!applyOverrides(overrides, backups, error))
+    {
+        restoreOverrides(backups);
+        return false;
+    }
+
+    // steps which wait for the first frame of a sequence source like Watch Folder
+    QSet<long> waitingSteps;
+
+    bool success = true;
+    for(Step* step : _order)
+    {
+        if(!step->needsUpdate)
+            continue;
+
+        // the request image takes the place of the source
+        if(step->id == _inputStep)
+        {
+            step->needsUpdate = false;
+            continue;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        IPLProcess* process = step->process;
+        process->resetMessages();
+        process->beforeProcessing();
+
+        bool stepSuccess = true;
+        bool stepWaiting = false;
+        if(process->isSource())
+        {
+            stepSuccess = runProcess(process, NULL, 0, useOpenCV);
+        }
+        else
+        {
+            // execute process once for every input
+            for(const Edge& edge : step->edgesIn)
+            {
+                IPLData* data = result(edge.from, edge.indexFrom);
+
+                // no frame yet, wait without failing
+                if(!data && (_steps[edge.from]->process->isSequence() || waitingSteps.contains(edge.from)))
+                {
+                    waitingSteps.insert(step->id);
+                    stepWaiting = true;
+                    break;
+                }
+
+                // invalid result, stop the execution
+                if(!data)
+                {
+                    process->addError("Invalid input from step " + std::to_string(edge.from));
+                    stepSuccess = false;
+                    break;
+                }
+
+                stepSuccess = runProcess(process, data, edge.indexTo, useOpenCV);
+                if(!stepSuccess)
+                    break;
+            }
+        }
+
+        process->afterProcessing();
+
+        StepTiming timing;
+        timing.stepID       = step->id;
+        timing.className    = QString::fromStdString(process->className());
+        timing.durationUs   = timer.nsecsElapsed() / 1000;
+        timings.append(timing);
+
+        // failed and waiting steps are retried with the next request
+        step->needsUpdate = !stepSuccess || stepWaiting;
+
+        if(!stepSuccess)
+        {
+            error = QString("Step %1 (%2) failed: %3").arg(step->id).arg(timing.className).arg(collectErrors(process));
+            success = false;
+            break;
+        }
+    }
+
+    restoreOverrides(backups);
+
+    return success;
+}
+
+/*!
+ * \brief IPServerGraph::batchPath finds the chain of steps between inputStep and outputStep
+ * A graph can only be executed as batch if every step on the way has exactly
+ * one input and is neither a source nor a sequence.
+ * \param path steps after inputStep up to and including outputStep
+ * \return true if the chain can be executed with executeBatch
+ */
+bool IPServerGraph::batchPath(long inputStep, long outputStep, QList<Step*>& path)
+{
+    path.clear();
+    if(!_steps.contains(inputStep) || !_steps.contains(outputStep))
+        return false;
+
+    long current = outputStep;
+    while(current != inputStep)
+    {
+        Step* step = _steps[current];
+        if(step->edgesIn.size() != 1 || step->process->isSource() || step->process->isSequence())
+            return false;
+
+        path.prepend(step);
+        current = step->edgesIn.first().from;
+    }
+    return true;
+}
+
+/*!
+ * \brief IPServerGraph::executeBatch runs several frames through the steps between inputStep and outputStep
+ * Every step processes all frames at once with IPLProcess::processInputDataBatch,
+ * so kernels and lookup tables are only built once per batch.
+ * \param inputs request frames, replace the result of inputStep
+ * \param results one result per frame of outputStep, owned by the caller
+ * \return true on success
+ */
+bool IPServerGraph::executeBatch(const std::vector<IPLData*>& inputs, long inputStep, long outputStep, int outputIndex,
+                                 const QList<PropertyOverride>& overrides, bool useOpenCV,
+                                 std::vector<IPLData*>& results, QList<StepTiming>& timings, QString& error)
+{
+    results.clear();
+
+    QList<Step*> path;
+    if(!batchPath(inputStep, outputStep, path))
+    {
+        error = QString("Steps %1 to %2 can not be executed as batch").arg(inputStep).arg(outputStep);
+        return false;
+    }
+
+    QList<PropertyBackup> backups;
+    if(!applyOverrides(overrides, backups, error))
+    {
+        restoreOverrides(backups);
+        return false;
+    }
+
+    bool success = true;
+    std::vector<IPLData*> current(inputs.begin(), inputs.end());
+    bool ownsCurrent = false;
+
+    for(int i = 0; i < path.size(); i++)
+    {
+        Step* step = path[i];
+        const Edge& edge = step->edgesIn.first();
+        int stepOutput = (i == path.size()-1) ? outputIndex : path[i+1]->edgesIn.first().indexFrom;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        IPLProcess* process = step->process;
+        process->resetMessages();
+        process->beforeProcessing();
+
+        std::vector<IPLData*> next;
+        bool stepSuccess = false;
+        try
+        {
+            stepSuccess = process->processInputDataBatch(current, edge.indexTo, useOpenCV, next, stepOutput);
+        }
+        catch(std::exception &e)
+        {
+            process->addError(e.what());
+        }
+        catch(...)
+        {
+            process->addError("UNKNOWN ERROR IN PROCESS");
+        }
+
+        process->afterProcessing();
+
+        StepTiming timing;
+        timing.stepID       = step->id;
+        timing.className    = QString::fromStdString(process->className());
+        timing.durationUs   = timer.nsecsElapsed() / 1000;
+        timings.append(timing);
+
+        // the intermediate frames are not needed anymore
+        if(ownsCurrent)
+        {
+            for(IPLData* data : current)
+                delete data;
+        }
+        current = next;
+        ownsCurrent = true;
+
+        if(!stepSuccess)
+        {
+            error = QString("Step %1 (%2) failed: %3").arg(step->id).arg(timing.className).arg(collectErrors(process));
+            success = false;
+            break;
+        }
+    }
+
+    if(success)
+    {
+        if(ownsCurrent)
+        {
+            results = current;
+        }
+        else
+        {
+            // input and output step are the same
+            for(IPLData* data : current)
+                results.push_back(new IPLImage(*data->toImage()));
+        }
+    }
+    else if(ownsCurrent)
+    {
+        for(IPLData* data : current)
+            delete data;
+    }
+
+    restoreOverrides(backups);
+
+    // the processes only hold the last frame, the next single request has to
+    // start from the source again
+    markNeedsUpdate(_steps[inputStep]);
+    _input          = NULL;
+    _inputStep      = -1;
+    _inputInjected  = false;
+
+    return success;
+}
+
+IPLData* IPServerGraph::result(long stepID, int index)
+{
+    if(_input && stepID == _inputStep)
+        return _input;
+
+    if(!_steps.contains(stepID))
+        return NULL;
+
+    return _steps[stepID]->process->getResultData(index);
+}
+
+bool IPServerGraph::applyOverrides(const QList<PropertyOverride>& overrides, QList<PropertyBackup>& backups, QString& error)
+{
+    for(const PropertyOverride& o : overrides)
+    {
+        if(!_steps.contains(o.stepID))
+        {
+            error = QString("Invalid step for property override: %1").arg(o.stepID);
+            return false;
+        }
+
+        Step* step = _steps[o.stepID];
+        IPLProcessProperty* property = step->process->property(o.key.toStdString());
+        if(!property)
+        {
+            error = QString("Invalid process property: %1").arg(o.key);
+            return false;
+        }
+
+        PropertyBackup backup;
+        backup.step     = step;
+        backup.property = property;
+        backup.data     = property->serialize();
+
+        IPLProcessProperty::SerializedData data = backup.data;
+        data.value = o.value.toStdString();
+
+        try
+        {
+            property->deserialize(data);
+        }
+        catch(IPLProcessProperty::DeserialationFailed)
+        {
+            error = QString("Invalid value for property %1: %2").arg(o.key).arg(o.value);
+            return false;
+        }
+
+        backups.append(backup);
+        markNeedsUpdate(step);
+    }
+    return true;
+}
+
+void IPServerGraph::restoreOverrides(QList<PropertyBackup>& backups)
+{
+    // restore in reverse order in case a property was overridden twice
+    for(int i = backups.size()-1; i >= 0; i--)
+    {
+        PropertyBackup& backup = backups[i];
+        backup.property->deserialize(backup.data);
+
+        // the next request needs the original values again
+        markNeedsUpdate(backup.step);
+    }
+    backups.clear();
+}
+
+void IPServerGraph::markNeedsUpdate(Step* step)
+{
+    QQueue<Step*> queue;
+    queue.enqueue(step);
+
+    while(!queue.isEmpty())
+    {
+        Step* current = queue.dequeue();
+        if(current->needsUpdate && current != step)
+            continue;
+
+        current->needsUpdate = true;
+        for(long next : current->stepsOut)
+            queue.enqueue(_steps[next]);
+    }
+}
+
+bool IPServerGraph::runProcess(IPLProcess* process, IPLData* data, int inputIndex, bool useOpenCV)
+{
+    try
+    {
+        return process->processInputData(data, inputIndex, useOpenCV);
+    }
+    catch(std::exception &e)
+    {
+        process->addError(e.what());
+    }
+    catch(...)
+    {
+        process->addError("UNKNOWN ERROR IN PROCESS");
+    }
+    return false;
+}
+
+QString IPServerGraph::collectErrors(IPLProcess* process)
+{
+    QStringList errors;
+    for(IPLProcessMessage& msg : *process->messages())
+    {
+        if(msg.type == IPLProcessMessage::ERR)
+            errors.append(QString::fromStdString(msg.msg));
+    }
+    return errors.join("; ");
+}
@@ -0,0 +1,92 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include "IPServerGraphPool.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+IPServerGraphPool::IPServerGraphPool(QString name, QString fileName)
+{
+    _name       = name;
+    _fileName   = fileName;
+}
+
+IPServerGraphPool::~IPServerGraphPool()
+{
+    qDeleteAll(_instances);
+}
+
+/*!
+ * \brief IPServerGraphPool::load parses the process file once and creates the instances
+ */
+bool IPServerGraphPool::load(int instances, IPProcessFactory* factory, QString& error)
+{
+    QFile file(_fileName);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        error = QString("Could not open process file: %1").arg(_fileName);
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+
+    if(!document.isObject())
+    {
+        error = QString("Invalid process file %1: %2").arg(_fileName).arg(parseError.errorString());
+        return false;
+    }
+
+    QString baseDir = QFileInfo(_fileName).absolutePath();
+
+    for(int i=0; i < instances; i++)
+    {
+        IPServerGraph* graph = new IPServerGraph;
+        if(!graph->load(document.object(), baseDir, factory, error))
+        {
+            delete graph;
+            return false;
+        }
+        _instances.append(graph);
+        _available.append(graph);
+    }
+
+    return true;
+}
+
+IPServerGraph* IPServerGraphPool::acquire()
+{
+    QMutexLocker locker(&_mutex);
+    while(_available.isEmpty())
+        _instanceReleased.wait(&_mutex);
+
+    return _available.takeLast();
+}
+
+void IPServerGraphPool::release(IPServerGraph* graph)
+{
+    QMutexLocker locker(&_mutex);
+    _available.append(graph);
+    _instanceReleased.wakeOne();
+}
@@ -0,0 +1,299 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include "IPServerImageCodec.h"
+
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+static inline uchar toUchar(ipl_basetype value)
+{
+    int v = (int)(value * FACTOR_TO_UCHAR + 0.5f);
+    return (uchar) (v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static inline quint16 toUshort(ipl_basetype value)
+{
+    int v = (int)(value * 65535.0f + 0.5f);
+    return (quint16) (v < 0 ? 0 : (v > 65535 ? 65535 : v));
+}
+
+qint64 IPServerImageCodec::bufferSize(const QString& format, int width, int height, int channels)
+{
+    qint64 pixels = (qint64) width * height;
+
+    if(format == "gray8")   return pixels;
+    if(format == "gray16")  return pixels * 2;
+    if(format == "rgb24")   return pixels * 3;
+    if(format == "float32") return pixels * channels * (qint64) sizeof(float);
+    return -1;
+}
+
+IPLImage* IPServerImageCodec::decode(const QString& format, int width, int height, int channels,
+                                     const uchar* data, qint64 size, QString& error)
+{
+    if(width < 1 || height < 1)
+    {
+        error = "Invalid image dimensions.";
+        return NULL;
+    }
+
+    if(format == "float32" && channels != 1 && channels != 3)
+    {
+        error = "float32 images need 1 or 3 channels.";
+        return NULL;
+    }
+
+    qint64 expected = bufferSize(format, width, height, channels);
+    if(expected < 0)
+    {
+        error = QString("Unknown image format: %1").arg(format);
+        return NULL;
+    }
+    if(size < expected)
+    {
+        error = QString("Image buffer too small: %1 < %2 bytes").arg(size).arg(expected);
+        return NULL;
+    }
+
+    bool color = (format == "rgb24") || (format == "float32" && channels == 3);
+    IPLImage* image = new IPLImage(color ? IPL_IMAGE_COLOR : IPL_IMAGE_GRAYSCALE, width, height);
+
+    if(format == "gray8")
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            const uchar* src = data + (qint64) y * width;
+            ipl_basetype* dst = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = src[x] * FACTOR_TO_FLOAT;
+        }
+    }
+    else if(format == "gray16")
+    {
+        const quint16* src16 = reinterpret_cast<const quint16*>(data);
+
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            const quint16* src = src16 + (qint64) y * width;
+            ipl_basetype* dst = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = src[x] * (1.0f / 65535.0f);
+        }
+    }
+    else if(format == "rgb24")
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            const uchar* src = data + (qint64) y * width * 3;
+            ipl_basetype* r = &image->plane(0)->p(0, y);
+            ipl_basetype* g = &image->plane(1)->p(0, y);
+            ipl_basetype* b = &image->plane(2)->p(0, y);
+            for(int x=0; x < width; x++)
+            {
+                r[x] = src[3*x+0] * FACTOR_TO_FLOAT;
+                g[x] = src[3*x+1] * FACTOR_TO_FLOAT;
+                b[x] = src[3*x+2] * FACTOR_TO_FLOAT;
+            }
+        }
+    }
+    else if(format == "float32")
+    {
+        qint64 planeSize = (qint64) width * height;
+        for(int planeNr=0; planeNr < channels; planeNr++)
+            memcpy(&image->plane(planeNr)->p(0, 0), data + planeNr * planeSize * sizeof(float), planeSize * sizeof(float));
+    }
+
+    return image;
+}
+
+int IPServerImageCodec::channels(const QString& format, IPLImage* image)
+{
+    if(format == "rgb24")
+        return 3;
+    if(format == "float32")
+        return image->getNumberOfPlanes();
+    return 1;
+}
+
+bool IPServerImageCodec::encode(IPLImage* image, const QString& format, uchar* data, qint64 size, QString& error)
+{
+    int width   = image->width();
+    int height  = image->height();
+    int nrOfPlanes = image->getNumberOfPlanes();
+
+    qint64 expected = bufferSize(format, width, height, channels(format, image));
+    if(expected < 0)
+    {
+        error = QString("Unknown image format: %1").arg(format);
+        return false;
+    }
+    if(size < expected)
+    {
+        error = QString("Output buffer too small: %1 < %2 bytes").arg(size).arg(expected);
+        return false;
+    }
+
+    if(format == "gray8")
+    {
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            uchar* dst = data + (qint64) y * width;
+            ipl_basetype* src = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = toUchar(src[x]);
+        }
+    }
+    else if(format == "gray16")
+    {
+        quint16* dst16 = reinterpret_cast<quint16*>(data);
+
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            quint16* dst = dst16 + (qint64) y * width;
+            ipl_basetype* src = &image->plane(0)->p(0, y);
+            for(int x=0; x < width; x++)
+                dst[x] = toUshort(src[x]);
+        }
+    }
+    else if(format == "rgb24")
+    {
+        // grayscale results are replicated to all channels
+        int g = nrOfPlanes >= 3 ? 1 : 0;
+        int b = nrOfPlanes >= 3 ? 2 : 0;
+
+        #pragma omp parallel for
+        for(int y=0; y < height; y++)
+        {
+            uchar* dst = data + (qint64) y * width * 3;
+            ipl_basetype* srcR = &image->plane(0)->p(0, y);
+            ipl_basetype* srcG = &image->plane(g)->p(0, y);
+            ipl_basetype* srcB = &image->plane(b)->p(0, y);
+            for(int x=0; x < width; x++)
+            {
+                dst[3*x+0] = toUchar(srcR[x]);
+                dst[3*x+1] = toUchar(srcG[x]);
+                dst[3*x+2] = toUchar(srcB[x]);
+            }
+        }
+    }
+    else if(format == "float32")
+    {
+        qint64 planeSize = (qint64) width * height;
+        for(int planeNr=0; planeNr < nrOfPlanes; planeNr++)
+            memcpy(data + planeNr * planeSize * sizeof(float), &image->plane(planeNr)->p(0, 0), planeSize * sizeof(float));
+    }
+
+    return true;
+}
+
+IPServerSharedMemory::IPServerSharedMemory()
+{
+    _mapping        = NULL;
+    _mappingSize    = 0;
+    _data           = NULL;
+    _size           = 0;
+}
+
+IPServerSharedMemory::~IPServerSharedMemory()
+{
+    unmap();
+}
+
+/*!
+ * \brief IPServerSharedMemory::map
+ * \param handle {"name": "/frame", "offset": 0, "size": 1234}
+ * \param writable
+ * \param error
+ * \return true on success
+ */
+bool IPServerSharedMemory::map(const QJsonObject& handle, bool writable, QString& error)
+{
+#ifdef Q_OS_UNIX
+    QString name    = handle.value("name").toString();
+    qint64 offset   = (qint64) handle.value("offset").toDouble(0);
+    qint64 size     = (qint64) handle.value("size").toDouble(0);
+
+    if(name.isEmpty() || offset < 0 || size <= 0)
+    {
+        error = "Invalid shared memory handle.";
+        return false;
+    }
+
+    int fd = shm_open(name.toLocal8Bit().constData(), writable ? O_RDWR : O_RDONLY, 0);
+    if(fd < 0)
+    {
+        error = QString("Could not open shared memory: %1").arg(name);
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size < offset + size)
+    {
+        ::close(fd);
+        error = QString("Shared memory %1 is smaller than offset + size.").arg(name);
+        return false;
+    }
+
+    // mmap needs a page aligned offset, we simply map from the start
+    _mappingSize = (size_t) (offset + size);
+    _mapping = mmap(NULL, _mappingSize, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(_mapping == MAP_FAILED)
+    {
+        _mapping = NULL;
+        error = QString("Could not map shared memory: %1").arg(name);
+        return false;
+    }
+
+    _data = static_cast<uchar*>(_mapping) + offset;
+    _size = size;
+    return true;
+#else
+    Q_UNUSED(handle);
+    Q_UNUSED(writable);
+    error = "Shared memory handles are only supported on Unix.";
+    return false;
+#endif
+}
+
+void IPServerSharedMemory::unmap()
+{
+#ifdef Q_OS_UNIX
+    if(_mapping)
+        munmap(_mapping, _mappingSize);
+#endif
+    _mapping        = NULL;
+    _mappingSize    = 0;
+    _data           = NULL;
+    _size           = 0;
+}
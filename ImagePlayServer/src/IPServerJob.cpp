@@ -0,0 +1,320 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include "IPServerJob.h"
+
+#include <QJsonDocument>
+
+IPServerJob::IPServerJob(IPServer* server, QJsonObject request, QByteArray payload)
+{
+    _server     = server;
+    _request    = request;
+    _payload    = payload;
+
+    // the job is deleted with deleteLater in the main thread
+    setAutoDelete(false);
+
+    _queueTimer.start();
+}
+
+void IPServerJob::run()
+{
+    qint64 queueUs = _queueTimer.nsecsElapsed() / 1000;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QJsonObject response;
+    QByteArray responsePayload;
+    QString error;
+
+    bool success = process(response, responsePayload, error);
+
+    response.insert("id", _request.value("id"));
+    response.insert("status", success ? "ok" : "error");
+    if(!success)
+    {
+        response.insert("error", error);
+        responsePayload.clear();
+    }
+
+    QJsonObject timing = response.value("timing").toObject();
+    timing.insert("queueMs", queueUs / 1000.0);
+    timing.insert("totalMs", timer.nsecsElapsed() / 1000000.0);
+    response.insert("timing", timing);
+
+    respond(response, responsePayload);
+}
+
+bool IPServerJob::process(QJsonObject& response, QByteArray& responsePayload, QString& error)
+{
+    QString projectName = _request.value("project").toString();
+    IPServerGraphPool* pool = _server->project(projectName);
+    if(!pool)
+    {
+        error = QString("Unknown project: %1").arg(projectName);
+        return false;
+    }
+
+    // decode the input frames, either inline or from shared memory
+    std::vector<IPLData*> inputs;
+    QString format  = _request.value("format").toString();
+    int width       = _request.value("width").toInt();
+    int height      = _request.value("height").toInt();
+    int channels    = _request.value("channels").toInt(1);
+    int frames      = _request.value("frames").toInt(1);
+
+    if(frames < 1)
+    {
+        error = QString("Invalid number of frames: %1").arg(frames);
+        return false;
+    }
+
+    if(_request.contains("shm"))
+    {
+        IPServerSharedMemory memory;
+        if(!memory.map(_request.value("shm").toObject(), false, error))
+            return false;
+
+        if(!decodeFrames(format, width, height, channels, frames, memory.data(), memory.size(), inputs, error))
+            return false;
+    }
+    else if(_payload.size() > 0)
+    {
+        if(!decodeFrames(format, width, height, channels, frames,
+                         reinterpret_cast<const uchar*>(_payload.constData()), _payload.size(), inputs, error))
+            return false;
+    }
+
+    // per request property overrides
+    QList<IPServerGraph::PropertyOverride> overrides;
+    QJsonArray properties = _request.value("properties").toArray();
+    for(auto it = properties.begin(); it != properties.end(); ++it)
+    {
+        QJsonObject propertyObject = (*it).toObject();
+
+        IPServerGraph::PropertyOverride o;
+        o.stepID    = (long) propertyObject.value("step").toDouble(-1);
+        o.key       = propertyObject.value("key").toString();
+        o.value     = propertyObject.value("value").toVariant().toString();
+        overrides.append(o);
+    }
+
+    bool useOpenCV = _request.value("opencv").toBool(_server->useOpenCV());
+
+    IPServerGraph* graph = pool->acquire();
+
+    long inputStep  = (long) _request.value("input").toDouble(graph->defaultInputStep());
+    QJsonObject outputObject = _request.value("output").toObject();
+    long outputStep = (long) outputObject.value("step").toDouble(graph->defaultOutputStep());
+    int outputIndex = outputObject.value("index").toInt(0);
+
+    QList<IPServerGraph::StepTiming> timings;
+    std::vector<IPLData*> results;
+    bool ownsResults = false;
+    bool success = true;
+
+    QList<IPServerGraph::Step*> path;
+    if(inputs.size() > 1 && graph->batchPath(inputStep, outputStep, path))
+    {
+        // all frames in one pass through the chain
+        success = graph->executeBatch(inputs, inputStep, outputStep, outputIndex, overrides, useOpenCV, results, timings, error);
+        ownsResults = true;
+        response.insert("batch", true);
+    }
+    else if(inputs.size() > 1)
+    {
+        // branched graphs fall back to one execution per frame
+        for(IPLData* input : inputs)
+        {
+            success = graph->execute(input->toImage(), inputStep, overrides, useOpenCV, timings, error);
+            if(!success)
+                break;
+
+            IPLData* data = graph->result(outputStep, outputIndex);
+            IPLImage* result = data ? data->toImage() : NULL;
+            results.push_back(result ? new IPLImage(*result) : NULL);
+        }
+        ownsResults = true;
+        response.insert("batch", false);
+    }
+    else
+    {
+        IPLImage* input = inputs.size() > 0 ? inputs.front()->toImage() : NULL;
+        success = graph->execute(input, inputStep, overrides, useOpenCV, timings, error);
+        if(success)
+            results.push_back(graph->result(outputStep, outputIndex));
+    }
+
+    QJsonArray stepTimings;
+    double processingMs = 0;
+    for(const IPServerGraph::StepTiming& t : timings)
+    {
+        QJsonObject stepTiming;
+        stepTiming.insert("step", (double) t.stepID);
+        stepTiming.insert("process", t.className);
+        stepTiming.insert("ms", t.durationUs / 1000.0);
+        stepTimings.append(stepTiming);
+        processingMs += t.durationUs / 1000.0;
+    }
+
+    QJsonObject timing;
+    timing.insert("processingMs", processingMs);
+    timing.insert("steps", stepTimings);
+    response.insert("timing", timing);
+
+    // encode the results while the instance is still ours
+    if(success)
+        success = encodeFrames(results, outputStep, outputIndex, format, response, responsePayload, error);
+
+    pool->release(graph);
+
+    if(ownsResults)
+    {
+        for(IPLData* data : results)
+            delete data;
+    }
+    for(IPLData* data : inputs)
+        delete data;
+
+    return success;
+}
+
+bool IPServerJob::decodeFrames(const QString& format, int width, int height, int channels, int frames,
+                               const uchar* data, qint64 size, std::vector<IPLData*>& inputs, QString& error)
+{
+    if(width < 1 || height < 1)
+    {
+        error = QString("Invalid input dimensions: %1x%2").arg(width).arg(height);
+        return false;
+    }
+
+    if(format == "float32" && channels != 1 && channels != 3)
+    {
+        error = QString("Invalid number of channels for float32 input: %1").arg(channels);
+        return false;
+    }
+
+    qint64 frameSize = IPServerImageCodec::bufferSize(format, width, height, channels);
+    if(frameSize <= 0)
+    {
+        error = QString("Unknown input format: %1").arg(format);
+        return false;
+    }
+
+    if(size < frameSize * frames)
+    {
+        error = QString("Input buffer too small for %1 frames: %2 < %3").arg(frames).arg(size).arg(frameSize * frames);
+        return false;
+    }
+
+    for(int i = 0; i < frames; i++)
+    {
+        IPLImage* input = IPServerImageCodec::decode(format, width, height, channels, data + i * frameSize, frameSize, error);
+        if(!input)
+        {
+            for(IPLData* frame : inputs)
+                delete frame;
+            inputs.clear();
+            return false;
+        }
+        inputs.push_back(input);
+    }
+    return true;
+}
+
+bool IPServerJob::encodeFrames(const std::vector<IPLData*>& results, long outputStep, int outputIndex, const QString& format,
+                               QJsonObject& response, QByteArray& responsePayload, QString& error)
+{
+    for(IPLData* data : results)
+    {
+        if(!data || !data->toImage())
+        {
+            error = QString("No image result at step %1, output %2").arg(outputStep).arg(outputIndex);
+            return false;
+        }
+    }
+
+    if(results.empty())
+    {
+        error = QString("No image result at step %1, output %2").arg(outputStep).arg(outputIndex);
+        return false;
+    }
+
+    // all frames share the size of the first one
+    IPLImage* first = results.front()->toImage();
+    QString outputFormat = _request.value("outputFormat").toString(format.isEmpty() ? "rgb24" : format);
+    int outputChannels = IPServerImageCodec::channels(outputFormat, first);
+    qint64 size = IPServerImageCodec::bufferSize(outputFormat, first->width(), first->height(), outputChannels);
+
+    response.insert("format", outputFormat);
+    response.insert("width", first->width());
+    response.insert("height", first->height());
+    response.insert("channels", outputChannels);
+    response.insert("frames", (int) results.size());
+
+    if(size < 0)
+    {
+        error = QString("Unknown output format: %1").arg(outputFormat);
+        return false;
+    }
+
+    uchar* buffer = NULL;
+    qint64 bufferSize = size * results.size();
+
+    IPServerSharedMemory memory;
+    if(_request.contains("outputShm"))
+    {
+        if(!memory.map(_request.value("outputShm").toObject(), true, error))
+            return false;
+
+        if(memory.size() < bufferSize)
+        {
+            error = QString("Output buffer too small: %1 < %2").arg(memory.size()).arg(bufferSize);
+            return false;
+        }
+        buffer = memory.data();
+    }
+    else
+    {
+        responsePayload.resize(bufferSize);
+        buffer = reinterpret_cast<uchar*>(responsePayload.data());
+    }
+
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        IPLImage* result = results[i]->toImage();
+        if(result->width() != first->width() || result->height() != first->height())
+        {
+            error = "All frames of a batch need the same output size";
+            return false;
+        }
+
+        if(!IPServerImageCodec::encode(result, outputFormat, buffer + i * size, size, error))
+            return false;
+    }
+    return true;
+}
+
+void IPServerJob::respond(QJsonObject response, const QByteArray& payload)
+{
+    response.insert("payloadSize", payload.size());
+    emit finished(QJsonDocument(response).toJson(QJsonDocument::Compact), payload);
+}
@@ -0,0 +1,113 @@
+//#############################################################################
+//
+//  This file is part of ImagePlay.
+//
+//  ImagePlay is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  ImagePlay is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with ImagePlay.  If not, see <http://www.gnu.org/licenses/>.
+//
+//#############################################################################
+
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QThread>
+#include <QDebug>
+
+#include "IPServer.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setApplicationName("ImagePlayServer");
+    QCoreApplication::setApplicationVersion(APP_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Processes images with ImagePlay process files (.ipj) over a local socket.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption socketOption("socket", "Local socket name or path.", "name", "/tmp/imageplay.sock");
+    QCommandLineOption projectOption("project", "Register a process file, may be repeated.", "name=file.ipj");
+    QCommandLineOption concurrencyOption("concurrency", "Maximum number of requests processed at the same time.", "n",
+                                         QString::number(QThread::idealThreadCount()));
+    QCommandLineOption instancesOption("instances", "Warm instances per project (default: concurrency).", "n");
+    QCommandLineOption pluginsOption("plugins", "Plugin directory.", "path");
+    QCommandLineOption openCVOption("opencv", "Use the OpenCV implementations by default.");
+    QCommandLineOption runOption("run", "Execute a process file once per input frame until the input ends, "
+                                        "e.g. with Raw Video Input/Output on stdin/stdout.", "file.ipj");
+
+    parser.addOption(socketOption);
+    parser.addOption(projectOption);
+    parser.addOption(concurrencyOption);
+    parser.addOption(instancesOption);
+    parser.addOption(pluginsOption);
+    parser.addOption(openCVOption);
+    parser.addOption(runOption);
+    parser.process(a);
+
+    int concurrency = qMax(1, parser.value(concurrencyOption).toInt());
+    int instances   = parser.isSet(instancesOption) ? qMax(1, parser.value(instancesOption).toInt()) : concurrency;
+
+    IPServer server;
+    server.setUseOpenCV(parser.isSet(openCVOption));
+
+    if(parser.isSet(pluginsOption))
+        server.loadPlugins(parser.value(pluginsOption));
+
+    if(parser.isSet(runOption))
+    {
+        QString error;
+        if(!server.runProject(parser.value(runOption), error))
+        {
+            qCritical() << error;
+            return 1;
+        }
+        return 0;
+    }
+
+    QStringList projects = parser.values(projectOption);
+    if(projects.isEmpty())
+    {
+        qCritical() << "No process file registered, use --project name=file.ipj";
+        return 1;
+    }
+
+    foreach (QString project, projects)
+    {
+        int separator = project.indexOf('=');
+        if(separator < 1)
+        {
+            qCritical() << "Invalid project, expected name=file.ipj: " << project;
+            return 1;
+        }
+
+        QString error;
+        if(!server.registerProject(project.left(separator), project.mid(separator+1), instances, error))
+        {
+            qCritical() << error;
+            return 1;
+        }
+    }
+
+    if(!server.listen(parser.value(socketOption), concurrency))
+    {
+        qCritical() << "Could not listen on " << parser.value(socketOption);
+        return 1;
+    }
+
+    qInfo() << "ImagePlayServer listening on" << parser.value(socketOption)
+            << "with" << projects.size() << "projects," << concurrency << "concurrent requests.";
+
+    return a.exec();
+}